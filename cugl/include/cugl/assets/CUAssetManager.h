@@ -91,6 +91,8 @@ protected:
     std::unordered_map<size_t,std::shared_ptr<BaseLoader>> _handlers;
     /** The central thread for managing all of the loaders */
     std::shared_ptr<ThreadPool> _workers;
+    /** Additional JSON directory categories, mapped to their asset type */
+    std::unordered_map<std::string,size_t> _categories;
 
     /** State variable to manage reading JSON directories */
     bool _preload;
@@ -361,6 +363,25 @@ public:
         return true;
     }
     
+    /**
+     * Adds a JSON directory category for the given asset Type
+     *
+     * The type of the asset is specified by the template parameter T.  By
+     * default, JSON directories only recognize the built-in categories
+     * "textures", "sounds", "fonts", "jsons", "widgets", and "scene2s".
+     * This method lets a directory load assets for any other attached
+     * loader (such as a {@link GenericLoader}).  Each entry of the category
+     * is passed to the loader as is, so its format is up to the loader.
+     *
+     * The category must be added before the directory is loaded.
+     *
+     * @param name  The category name in the JSON directory
+     */
+    template<typename T>
+    void addCategory(const std::string& name) {
+        _categories[name] = typeid(T).hash_code();
+    }
+    
     /**
      * Detaches all loaders from this asset manager
      *
@@ -80,6 +80,8 @@ protected:
     int _fontsize;
     /** The default atlas character set ("" for ASCII) */
     std::string _charset;
+    /** The default distance field spread (0 for a bitmap atlas) */
+    Uint32 _spread;
     
 #pragma mark Asset Loading
     /**
@@ -93,10 +95,12 @@ protected:
      * @param source    The pathname to the asset
      * @param charset   The atlas character set
      * @param size      The font size
+     * @param spread    The distance field spread of the atlas (0 for a bitmap)
      *
      * @return the font asset with no generated atlas
      */
-    std::shared_ptr<Font> preload(const std::string& source, const std::string& charset, int size);
+    std::shared_ptr<Font> preload(const std::string& source, const std::string& charset,
+                                  int size, Uint32 spread);
     
     /**
      * Creates an atlas for the font asset, and assigns it the given key.
@@ -179,6 +183,7 @@ protected:
      *      "file":         The path to the asset
      *      "size":         This font size (int)
      *      "charset":      The set of characters for the font atlas (string)
+     *      "spread":       The distance field spread of the atlas (int, 0 for a bitmap)
      *
      * @param json      The directory entry for the asset
      * @param callback  An optional callback for asynchronous loading
@@ -487,6 +492,30 @@ public:
      * @param charset   The default atlas character set
      */
     void setCharacterSet(const std::string& charset) { _charset = charset; }
+
+    /**
+     * Returns the default distance field spread of a font atlas
+     *
+     * If this value is positive, any font processed by this loader will have
+     * a distance field atlas with this spread in pixels. Such a font stays
+     * crisp at any scale. See {@link Font#setDistanceSpread} for details.
+     * The default is 0, which is a bitmap atlas.
+     *
+     * @return the default distance field spread of a font atlas
+     */
+    Uint32 getDistanceSpread() const { return _spread; }
+
+    /**
+     * Sets the default distance field spread of a font atlas
+     *
+     * If this value is positive, any font processed by this loader will have
+     * a distance field atlas with this spread in pixels. Such a font stays
+     * crisp at any scale. See {@link Font#setDistanceSpread} for details.
+     * The default is 0, which is a bitmap atlas.
+     *
+     * @param spread    The default distance field spread of a font atlas
+     */
+    void setDistanceSpread(Uint32 spread) { _spread = spread; }
 };
 
 }
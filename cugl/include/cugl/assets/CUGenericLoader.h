@@ -146,7 +146,7 @@ protected:
                     this->materialize(key,asset,callback);
                     return false;
                 });
-            });
+            }, ThreadPool::Priority::LOADING);
         }
 
         return success;
@@ -164,9 +164,9 @@ protected:
      * loading is safe.
      *
      * This version of read provides support for JSON directories. The exact
-     * format of the directory entry is up to you. However, the directory
-     * entry must be loaded manually, as {@link AssetManager} does not yet 
-     * support generic JSON directory entries.
+     * format of the directory entry is up to you. To load these entries from
+     * a JSON directory, register the category name with
+     * {@link AssetManager#addCategory}.
      *
      * @param json      The directory entry for the asset
      * @param callback  An optional callback for asynchronous loading
@@ -198,7 +198,7 @@ protected:
                     this->materialize(key,asset,callback);
                     return false;
                 });
-            });
+            }, ThreadPool::Priority::LOADING);
         }
         
         return success;
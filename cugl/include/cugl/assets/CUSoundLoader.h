@@ -47,8 +47,13 @@
 #define __CU_SOUND_LOADER_H__
 #include <cugl/assets/CULoader.h>
 #include <cugl/audio/CUSound.h>
+#include <unordered_map>
+#include <mutex>
 
 namespace cugl {
+
+/** Forward reference to a sound bank */
+class SoundBank;
     
 /**
  * This class is a implementation of Loader<Sound>
@@ -75,8 +80,25 @@ private:
 protected:
     /** The default volume for all music assets */
     float _volume;
+    /** The sound banks shared by banked sound assets, keyed by path */
+    std::unordered_map<std::string, std::shared_ptr<SoundBank>> _banks;
+    /** Mutex protecting the bank table (banks may load in the worker) */
+    std::mutex _bankMutex;
     
 #pragma mark Asset Loading
+    /**
+     * Returns a sound for a clip in a sound bank.
+     *
+     * The bank is opened the first time any of its clips is loaded, and is
+     * shared by every later clip from the same file.  This method is safe
+     * to call from the loader thread.
+     *
+     * @param json      The directory entry for the asset
+     *
+     * @return a sound for a clip in a sound bank.
+     */
+    std::shared_ptr<Sound> allocBanked(const std::shared_ptr<JsonValue>& json);
+    
     /**
      * Finishes loading the sound file, setting its default volume.
      *
@@ -130,7 +152,9 @@ protected:
      * This version of read provides support for JSON directories. A soundfx
      * directory entry has the following values
      *
-     *      "file":         The path to the asset
+     *      "type":         One of "sample", "waveform", or "bank"
+     *      "file":         The path to the asset (or sound bank)
+     *      "clip":         The clip name in the bank (defaults to the key)
      *      "volume":       This default sound volume (float)
      *
      * @param json      The directory entry for the asset
@@ -168,6 +192,8 @@ public:
     void dispose() override {
         _assets.clear();
         _loader = nullptr;
+        std::lock_guard<std::mutex> lock(_bankMutex);
+        _banks.clear();
     }
     
     /**
@@ -125,6 +125,34 @@ public:
         PAUSED
     };
 
+    /**
+     * This struct is a snapshot of the audio thread performance counters.
+     *
+     * All times are measured in microseconds.  The percentiles are
+     * approximate, as they are computed from a histogram in the output
+     * device.  The counters accumulate until {@link resetStatistics()}.
+     */
+    struct Statistics {
+        /** The time available to render a single audio buffer */
+        Uint64 deadline;
+        /** The time needed to render the last audio buffer */
+        Uint64 last;
+        /** The worst time needed to render an audio buffer */
+        Uint64 worst;
+        /** The median time needed to render an audio buffer */
+        Uint64 median;
+        /** The 95th percentile time needed to render an audio buffer */
+        Uint64 p95;
+        /** The 99th percentile time needed to render an audio buffer */
+        Uint64 p99;
+        /** The number of audio buffers rendered */
+        Uint64 callbacks;
+        /** The number of audio buffers that missed their deadline */
+        Uint64 underruns;
+        /** The number of slots (including music) currently playing */
+        Uint32 voices;
+    };
+
 private:
     /** Reference to the audio engine singleton */
     static AudioEngine* _gEngine;
@@ -146,6 +174,8 @@ private:
 
     /** Active music queues */
     std::vector<std::shared_ptr<AudioQueue>> _queues;
+    /** The channel wrappers of the music queues (in the same order) */
+    std::vector<std::shared_ptr<audio::AudioFader>> _queueCovers;
     
     /** Map keys to identifiers */
     std::unordered_map<std::string,std::shared_ptr<audio::AudioFader>> _actives;
@@ -876,6 +906,50 @@ public:
      * from the background.
      */
     void resume();
+
+#pragma mark -
+#pragma mark Performance Statistics
+    /**
+     * Returns a snapshot of the audio thread performance counters.
+     *
+     * The counters are accumulated lock-free in the audio thread, so this
+     * method never blocks playback.  It is intended for debugging overlays
+     * and for tuning the buffer size of the output device.
+     *
+     * @return a snapshot of the audio thread performance counters.
+     */
+    Statistics getStatistics() const;
+
+    /**
+     * Resets the audio thread performance counters.
+     *
+     * This resets the output device as well as the timing of every slot.
+     */
+    void resetStatistics();
+
+    /**
+     * Returns the average time in microseconds to read the given sound effect.
+     *
+     * This is the time for the entire audio subtree of the slot playing
+     * the sound, including any fader or panner wrappers.  The average is
+     * measured since the sound started playing.  If the key does not
+     * correspond to an active sound effect, this method returns 0.
+     *
+     * @param  key  the reference key for the sound effect
+     *
+     * @return the average time in microseconds to read the given sound effect.
+     */
+    Uint64 getReadTime(const std::string key) const;
+
+    /**
+     * Returns the average time in microseconds to read the music queues.
+     *
+     * This is the combined average over all of the music slots since the
+     * statistics were last reset.
+     *
+     * @return the average time in microseconds to read the music queues.
+     */
+    Uint64 getMusicReadTime() const;
 };
 
 }
@@ -0,0 +1,428 @@
+//
+//  CUSoundBank.h
+//  Cornell University Game Library (CUGL)
+//
+//  This module provides a packed bank of short sound effects.  Traditional
+//  audio samples are fully decoded to float PCM when they are loaded.  That
+//  is four times the size of 16-bit PCM and far larger than the compressed
+//  source file.  It also means all of the decoding happens at startup.
+//
+//  A sound bank is a single file with a small index followed by 16-bit PCM
+//  clips.  The file is memory mapped (where the platform allows it), so the
+//  clips cost no decoding at load time.  A clip is only converted to float
+//  the first time that it is played, and the converted buffers are kept in
+//  a bounded LRU cache.
+//
+//  The bank format is little-endian and laid out as follows:
+//
+//      "CUSB"              4 byte magic number
+//      version             Uint16 (currently 1)
+//      count               Uint16 number of clips
+//      entries             count records of SOUNDBANK_ENTRY_SIZE bytes
+//      data                clip data, each aligned to 4 bytes
+//
+//  Each entry is a null-padded name of SOUNDBANK_NAME_SIZE bytes, followed
+//  by the channels (Uint8), the encoding (Uint8), two reserved bytes, the
+//  sample rate (Uint32), the number of frames (Uint32) and the byte offset
+//  of the clip data (Uint32).  Use {@link SoundBank#compile} to produce a
+//  bank from existing sound files.
+//
+//  This class uses our standard shared-pointer architecture.
+//
+//  1. The constructor does not perform any initialization; it just sets all
+//     attributes to their defaults.
+//
+//  2. All initialization takes place via init methods, which can fail if an
+//     object is initialized more than once.
+//
+//  3. All allocation takes place via static constructors which return a shared
+//     pointer.
+//
+//
+//  CUGL MIT License:
+//      This software is provided 'as-is', without any express or implied
+//      warranty.  In no event will the authors be held liable for any damages
+//      arising from the use of this software.
+//
+//      Permission is granted to anyone to use this software for any purpose,
+//      including commercial applications, and to alter it and redistribute it
+//      freely, subject to the following restrictions:
+//
+//      1. The origin of this software must not be misrepresented; you must not
+//      claim that you wrote the original software. If you use this software
+//      in a product, an acknowledgment in the product documentation would be
+//      appreciated but is not required.
+//
+//      2. Altered source versions must be plainly marked as such, and must not
+//      be misrepresented as being the original software.
+//
+//      3. This notice may not be removed or altered from any source distribution.
+//
+//  Author: Dragonglass Studios
+//  Version: 10/18/26
+//
+#ifndef __CU_SOUND_BANK_H__
+#define __CU_SOUND_BANK_H__
+#include <SDL/SDL.h>
+#include "CUSound.h"
+#include "CUAudioSample.h"
+#include <cugl/io/CUMappedFile.h>
+#include <unordered_map>
+#include <vector>
+#include <string>
+#include <list>
+#include <mutex>
+
+/** The number of bytes reserved for a clip name in a bank entry */
+#define SOUNDBANK_NAME_SIZE     32
+/** The number of bytes in a single bank entry */
+#define SOUNDBANK_ENTRY_SIZE    48
+/** The default size (in bytes) of the decoded clip cache */
+#define SOUNDBANK_CACHE_SIZE    (4*1024*1024)
+
+namespace  cugl {
+
+/**
+ * This class is a packed, memory-mapped bank of short sound effects.
+ *
+ * The bank stores its clips as 16-bit PCM.  Clips are decoded to float PCM
+ * on demand by {@link acquire} and kept in a least-recently-used cache.  The
+ * cache is bounded by {@link getCapacity} bytes of decoded data.  A clip that
+ * is evicted while still playing is safe, as the player holds a reference to
+ * the decoded sample until it is done.
+ *
+ * Individual clips are exposed to the rest of the audio system as
+ * {@link BankedSound} assets.  Those are created by {@link SoundLoader} for
+ * any sound entry with type "bank".
+ *
+ * The cache is protected by a mutex, so clips may be acquired from any thread.
+ * However, as with all sounds, playback should only be started in the main
+ * thread.
+ */
+class SoundBank : public std::enable_shared_from_this<SoundBank> {
+public:
+    /**
+     * The encoding of a clip in the bank.
+     */
+    enum class Encoding : Uint8 {
+        /** Signed, little-endian 16-bit PCM */
+        PCM16 = 0
+    };
+
+    /**
+     * The index record for a single clip.
+     */
+    struct Entry {
+        /** The clip name (unique within the bank) */
+        std::string name;
+        /** The number of channels */
+        Uint8 channels;
+        /** The clip encoding */
+        Encoding encoding;
+        /** The sample rate in Hz */
+        Uint32 rate;
+        /** The number of frames */
+        Uint32 frames;
+        /** The byte offset of the clip data from the start of the bank */
+        Uint32 offset;
+    };
+
+private:
+    /** This macro disables the copy constructor (not allowed on assets) */
+    CU_DISALLOW_COPY_AND_ASSIGN(SoundBank);
+
+    /** The file backing this bank */
+    std::string _file;
+    /** The file holding the bank contents (mapped or read into memory) */
+    std::shared_ptr<MappedFile> _contents;
+    /** The bank contents, as held by _contents */
+    const Uint8* _data;
+    /** The size of the bank contents in bytes */
+    size_t _size;
+
+    /** The clip index */
+    std::vector<Entry> _entries;
+    /** The position of each clip in the index, by name */
+    std::unordered_map<std::string,size_t> _lookup;
+
+    /** The maximum number of bytes of decoded data to cache */
+    size_t _capacity;
+    /** The number of bytes of decoded data currently cached */
+    size_t _resident;
+    /** The cache recency order; the front is the most recently used */
+    std::list<size_t> _recent;
+    /** The decoded clips, with their position in the recency order */
+    std::unordered_map<size_t,std::pair<std::shared_ptr<AudioSample>,std::list<size_t>::iterator>> _cache;
+    /** Mutex protecting the cache */
+    mutable std::mutex _mutex;
+
+    /**
+     * Parses the clip index from the bank contents.
+     *
+     * @return true if the index is valid
+     */
+    bool parseIndex();
+
+    /**
+     * Evicts least recently used clips until the cache fits in its capacity.
+     *
+     * This method assumes the cache mutex is held.
+     */
+    void trim();
+
+public:
+#pragma mark Constructors
+    /**
+     * Creates a degenerate sound bank with no clips.
+     *
+     * NEVER USE A CONSTRUCTOR WITH NEW. If you want to allocate an asset on
+     * the heap, use one of the static constructors instead.
+     */
+    SoundBank();
+
+    /**
+     * Deletes this sound bank, releasing the mapped file.
+     */
+    ~SoundBank() { dispose(); }
+
+    /**
+     * Initializes this sound bank from the given file.
+     *
+     * The file is memory mapped where the platform allows it.  On platforms
+     * where the assets are not ordinary files (such as Android), it is read
+     * into a single 16-bit buffer instead.  Either way, no clip is decoded
+     * until it is first acquired.
+     *
+     * @param file      The bank file
+     * @param capacity  The maximum number of bytes of decoded clips to cache
+     *
+     * @return true if the bank was initialized successfully
+     */
+    bool init(const std::string& file, size_t capacity=SOUNDBANK_CACHE_SIZE);
+
+    /**
+     * Releases the bank contents and clears the cache.
+     *
+     * Clips that are still playing are unaffected, as they own their
+     * decoded buffers.
+     */
+    void dispose();
+
+    /**
+     * Returns a newly allocated sound bank for the given file.
+     *
+     * @param file      The bank file
+     * @param capacity  The maximum number of bytes of decoded clips to cache
+     *
+     * @return a newly allocated sound bank for the given file.
+     */
+    static std::shared_ptr<SoundBank> alloc(const std::string& file,
+                                            size_t capacity=SOUNDBANK_CACHE_SIZE) {
+        std::shared_ptr<SoundBank> result = std::make_shared<SoundBank>();
+        return (result->init(file,capacity) ? result : nullptr);
+    }
+
+#pragma mark Attributes
+    /**
+     * Returns the file backing this bank.
+     *
+     * @return the file backing this bank.
+     */
+    const std::string& getFile() const { return _file; }
+
+    /**
+     * Returns the number of clips in this bank.
+     *
+     * @return the number of clips in this bank.
+     */
+    size_t size() const { return _entries.size(); }
+
+    /**
+     * Returns true if this bank has a clip with the given name.
+     *
+     * @param name  The clip name
+     *
+     * @return true if this bank has a clip with the given name.
+     */
+    bool contains(const std::string& name) const {
+        return _lookup.find(name) != _lookup.end();
+    }
+
+    /**
+     * Returns the index entry for the given clip, or nullptr if missing.
+     *
+     * @param name  The clip name
+     *
+     * @return the index entry for the given clip, or nullptr if missing.
+     */
+    const Entry* getEntry(const std::string& name) const;
+
+    /**
+     * Returns the maximum number of bytes of decoded clips to cache.
+     *
+     * @return the maximum number of bytes of decoded clips to cache.
+     */
+    size_t getCapacity() const { return _capacity; }
+
+    /**
+     * Sets the maximum number of bytes of decoded clips to cache.
+     *
+     * If the cache is currently larger than this, the least recently used
+     * clips are evicted immediately.
+     *
+     * @param capacity  The maximum number of bytes of decoded clips to cache
+     */
+    void setCapacity(size_t capacity);
+
+    /**
+     * Returns the number of bytes of decoded clips currently cached.
+     *
+     * This does not include the (mapped) 16-bit clip data.
+     *
+     * @return the number of bytes of decoded clips currently cached.
+     */
+    size_t getResidentSize() const;
+
+#pragma mark Decoding
+    /**
+     * Returns the decoded clip with the given name.
+     *
+     * If the clip is cached, this marks it as most recently used.  Otherwise
+     * it is converted to float PCM and added to the cache, evicting older
+     * clips as necessary.  This method returns nullptr if there is no clip
+     * with that name.
+     *
+     * @param name  The clip name
+     *
+     * @return the decoded clip with the given name.
+     */
+    std::shared_ptr<AudioSample> acquire(const std::string& name);
+
+    /**
+     * Removes all decoded clips from the cache.
+     */
+    void purge();
+
+    /**
+     * Writes a sound bank containing the given sound files.
+     *
+     * This is the offline compiler for the bank format.  Each source is
+     * decoded with the standard {@link AudioSample} decoders and stored as
+     * 16-bit PCM under the matching name.  The sources and destination are
+     * ordinary paths (not relative to the asset directory), so this should
+     * be run from a desktop build.
+     *
+     * @param dest      The path of the bank to write
+     * @param names     The clip names
+     * @param sources   The sound files, one for each name
+     *
+     * @return true if the bank was written successfully
+     */
+    static bool compile(const std::string& dest,
+                        const std::vector<std::string>& names,
+                        const std::vector<std::string>& sources);
+};
+
+/**
+ * This class is a single clip in a {@link SoundBank}.
+ *
+ * It is a lightweight handle: it holds no audio data of its own.  The clip
+ * is only decoded when {@link createNode} is called, at which point the bank
+ * decodes it (or reuses a cached copy).
+ */
+class BankedSound : public Sound {
+protected:
+    /** The bank holding this clip */
+    std::shared_ptr<SoundBank> _bank;
+    /** The clip name in the bank */
+    std::string _name;
+    /** The number of frames in this clip */
+    Uint64 _frames;
+
+public:
+    /**
+     * Creates a degenerate banked sound.
+     *
+     * NEVER USE A CONSTRUCTOR WITH NEW. If you want to allocate an asset on
+     * the heap, use one of the static constructors instead.
+     */
+    BankedSound() : Sound(), _frames(0) {}
+
+    /**
+     * Deletes this banked sound, releasing its bank reference.
+     */
+    ~BankedSound() { dispose(); }
+
+    /**
+     * Initializes this sound as the named clip of the given bank.
+     *
+     * @param bank  The sound bank
+     * @param name  The clip name
+     *
+     * @return true if the sound was initialized successfully
+     */
+    bool init(const std::shared_ptr<SoundBank>& bank, const std::string& name);
+
+    /**
+     * Releases the bank reference and resets all attributes.
+     */
+    virtual void dispose() override;
+
+    /**
+     * Returns a newly allocated sound for the named clip of the given bank.
+     *
+     * @param bank  The sound bank
+     * @param name  The clip name
+     *
+     * @return a newly allocated sound for the named clip of the given bank.
+     */
+    static std::shared_ptr<BankedSound> alloc(const std::shared_ptr<SoundBank>& bank,
+                                              const std::string& name) {
+        std::shared_ptr<BankedSound> result = std::make_shared<BankedSound>();
+        return (result->init(bank,name) ? result : nullptr);
+    }
+
+    /**
+     * Returns the bank holding this clip.
+     *
+     * @return the bank holding this clip.
+     */
+    const std::shared_ptr<SoundBank>& getBank() const { return _bank; }
+
+    /**
+     * Returns the clip name in the bank.
+     *
+     * @return the clip name in the bank.
+     */
+    const std::string& getName() const { return _name; }
+
+    /**
+     * Returns the frame length of this sound.
+     *
+     * @return the frame length of this sound.
+     */
+    virtual Sint64 getLength() const override { return _frames; }
+
+    /**
+     * Returns the length of this sound in seconds.
+     *
+     * @return the length of this sound in seconds.
+     */
+    virtual double getDuration() const override {
+        return _rate ? (double)_frames/(double)_rate : -1;
+    }
+
+    /**
+     * Returns a playable audio node for this clip.
+     *
+     * This decodes the clip through the bank cache if necessary.  Nodes are
+     * distinct.  Each call to this method allocates a new audio node.
+     *
+     * @return a playable audio node for this clip.
+     */
+    virtual std::shared_ptr<audio::AudioNode> createNode() override;
+};
+
+}
+
+#endif /* __CU_SOUND_BANK_H__ */
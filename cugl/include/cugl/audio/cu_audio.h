@@ -36,6 +36,7 @@
 #include "CUAudioSample.h"
 #include "CUAudioWaveform.h"
 #include "CUSound.h"
+#include "CUSoundBank.h"
 
 // And sublibraries
 #include "codecs/cu_codecs.h"
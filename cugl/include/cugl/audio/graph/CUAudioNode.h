@@ -166,6 +166,11 @@ protected:
 
     /** An identifying integer */
     Sint32 _tag;
+
+    /** The accumulated time (in microseconds) spent reading this subtree */
+    std::atomic<Uint64> _readtime;
+    /** The number of timed reads of this subtree */
+    std::atomic<Uint64> _readcount;
     
     /**
      * A descriptive, identifying tag.
@@ -374,6 +379,54 @@ public:
     /** Cast from a Node to a string. */
     operator std::string() const { return toString(); }
     
+#pragma mark -
+#pragma mark Performance Statistics
+    /**
+     * Returns the accumulated time spent reading this node and its inputs.
+     *
+     * The time is measured in microseconds.  It is only recorded when the
+     * node is read by a parent that times its inputs, such as {@link AudioMixer}
+     * or {@link AudioOutput}.  Hence it measures the whole subtree rooted at
+     * this node.  This method is primarily for debugging.
+     *
+     * @return the accumulated time spent reading this node and its inputs.
+     */
+    Uint64 getReadTime() const { return _readtime.load(std::memory_order_relaxed); }
+
+    /**
+     * Returns the number of timed reads of this node.
+     *
+     * Dividing {@link getReadTime()} by this value gives the average cost
+     * of a single read of this subtree.
+     *
+     * @return the number of timed reads of this node.
+     */
+    Uint64 getReadCount() const { return _readcount.load(std::memory_order_relaxed); }
+
+    /**
+     * Records the time needed for a single read of this node.
+     *
+     * AUDIO THREAD ONLY: Users should never access this method directly.
+     * The only exception is when the user needs to create a custom subclass
+     * of this AudioNode that times its inputs.
+     *
+     * This method is lock-free and never allocates.
+     *
+     * @param micros    The number of microseconds spent in the read
+     */
+    void recordRead(Uint64 micros) {
+        _readtime.fetch_add(micros,std::memory_order_relaxed);
+        _readcount.fetch_add(1,std::memory_order_relaxed);
+    }
+
+    /**
+     * Resets the accumulated read statistics of this node.
+     */
+    void resetReadTime() {
+        _readtime.store(0,std::memory_order_relaxed);
+        _readcount.store(0,std::memory_order_relaxed);
+    }
+
 #pragma mark -
 #pragma mark Playback Controls
     /**
@@ -54,6 +54,11 @@
 #include <memory>
 #include <vector>
 
+/** The number of buckets in the callback timing histogram */
+#define AUDIO_HISTOGRAM_SIZE    64
+/** The width (in microseconds) of a single callback histogram bucket */
+#define AUDIO_HISTOGRAM_WIDTH   250
+
 namespace cugl {
     
     /** Forward reference to the audio manager */
@@ -119,6 +124,14 @@ private:
     
     /** The processing time required for this device */
     std::atomic<Uint64> _overhd;
+    /** The worst processing time since the statistics were reset */
+    std::atomic<Uint64> _worst;
+    /** The number of read callbacks since the statistics were reset */
+    std::atomic<Uint64> _callbacks;
+    /** The number of read callbacks that missed the buffer deadline */
+    std::atomic<Uint64> _underruns;
+    /** A histogram of processing times, used to compute percentiles */
+    std::atomic<Uint32> _histogram[AUDIO_HISTOGRAM_SIZE];
 
     /** The audio device in use */
     SDL_AudioDeviceID _device;
@@ -483,6 +496,69 @@ public:
      * @return the number of microseconds needed to render the last audio frame.
      */
     Uint64 getOverhead() const;
+
+#pragma mark -
+#pragma mark Performance Statistics
+    /**
+     * Returns the number of microseconds available to render one audio frame.
+     *
+     * This is the deadline for a single call to {@link read()}.  It is the
+     * duration of the device buffer, so 512 frames at 48000 Hz has a deadline
+     * of 10666 microseconds.  A read that takes longer than this will cause
+     * an audible glitch.
+     *
+     * @return the number of microseconds available to render one audio frame.
+     */
+    Uint64 getDeadline() const;
+
+    /**
+     * Returns the largest number of microseconds needed to render an audio frame.
+     *
+     * This is the worst case since the last call to {@link resetStatistics()}.
+     *
+     * @return the largest number of microseconds needed to render an audio frame.
+     */
+    Uint64 getWorstOverhead() const;
+
+    /**
+     * Returns the approximate render time at the given percentile.
+     *
+     * The value is computed from a histogram of buckets that are each
+     * {@link AUDIO_HISTOGRAM_WIDTH} microseconds wide.  Hence the result is
+     * the upper bound of the bucket containing the percentile.  Times beyond
+     * the last bucket are clamped to it.
+     *
+     * This method should only be called in the main thread.
+     *
+     * @param percent   The percentile in the range [0,1]
+     *
+     * @return the approximate render time at the given percentile.
+     */
+    Uint64 getPercentileOverhead(float percent) const;
+
+    /**
+     * Returns the number of audio frames rendered since the last reset.
+     *
+     * @return the number of audio frames rendered since the last reset.
+     */
+    Uint64 getCallbacks() const;
+
+    /**
+     * Returns the number of audio frames that missed their deadline.
+     *
+     * An underrun is any call to {@link read()} that took longer than the
+     * duration of the buffer it filled.
+     *
+     * @return the number of audio frames that missed their deadline.
+     */
+    Uint64 getUnderruns() const;
+
+    /**
+     * Resets all of the performance statistics for this device.
+     *
+     * This does not reset the statistics of the nodes in the audio graph.
+     */
+    void resetStatistics();
     
 #pragma mark -
 #pragma mark Optional Methods
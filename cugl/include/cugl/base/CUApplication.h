@@ -33,38 +33,19 @@
 //
 #ifndef __CU_APPLICATION_H__
 #define __CU_APPLICATION_H__
+#include <SDL/SDL.h>
 #include <cugl/util/CUTimestamp.h>
 #include <cugl/math/CUColor4.h>
 #include <cugl/math/CURect.h>
 #include <unordered_map>
 #include <functional>
 #include <deque>
-#include <mutex>
+#include <atomic>
 
 namespace cugl {
 
-/**
- * The storage type for all user-defined callbacks.
- *
- * The application API provides a way for the user to attach one-time or 
- * reoccuring callback functions.  This to allow the user to schedule 
- * activity in a future animation frame without having to create a separate
- * thread.  This is particularly important for functionality that accesses
- * the OpenGL context (or any of the low-level SDL subsystems), as that must 
- * be done in the main thread.
- *
- * To keep things simple, callbacks should never require arguments or
- * return a value.  If you wish to keep state, it should be done through
- * the appropriate closure.
- */
-typedef struct {
-    /** The callback function */
-    std::function<bool()> callback;
-    /** The reoccurrence period (0 if called every frame) */
-    Uint32 period;
-    /** The countdown until the next reoccurrence */
-    Uint32 timer;
-} scheduable;
+/** The number of slots in the timer wheel of scheduled callbacks, one per millisecond */
+#define CU_CALLBACK_WHEEL   256
     
 /**
  * This class represents a basic CUGL application
@@ -158,6 +139,8 @@ protected:
     
     /** The target FPS of this application */
     float _fps;
+    /** The FPS of this application while it has nothing new to draw */
+    float _idleFPS;
     /** The default background color of this application */
     Color4f _clearColor;
     
@@ -168,6 +151,12 @@ protected:
 private:
     /** The millisecond equivalent of the FPS; used to delay the core loop */
     unsigned int _delay;
+    /** The millisecond equivalent of the idle FPS */
+    unsigned int _idleDelay;
+    /** The number of animation frames in a row with nothing new to draw */
+    unsigned int _idleFrames;
+    /** Whether the next animation frame must be drawn, as there was input */
+    bool _redraw;
     
     /** A window of moving averages to track the FPS */
     std::deque<float> _fpswindow;
@@ -177,13 +166,99 @@ private:
     /** The timestamp for the end of an animation frame */
     Timestamp _finish;
     
+    /**
+     * The storage type for all user-defined callbacks.
+     *
+     * The application API provides a way for the user to attach one-time or
+     * reoccuring callback functions.  This to allow the user to schedule
+     * activity in a future animation frame without having to create a separate
+     * thread.  This is particularly important for functionality that accesses
+     * the OpenGL context (or any of the low-level SDL subsystems), as that must
+     * be done in the main thread.
+     *
+     * Callbacks are scheduled from any thread by pushing them on a lock-free
+     * queue, which the main thread drains into a timer wheel. Requests to
+     * unschedule a callback take the same queue, as a callback without a
+     * function, so that they are applied in order. Only the main thread
+     * touches the wheel, so it needs no lock at all.
+     */
+    class Callback {
+    public:
+        /** The callback function (empty for a request to unschedule) */
+        std::function<bool()> callback;
+        /** The unique key of the callback */
+        Uint32 id;
+        /** The reoccurrence period (0 if called every frame) */
+        Uint32 period;
+        /** The first millisecond of the callback clock to execute this (the delay while queued) */
+        Uint64 due;
+        /** The next callback in the queue, or in the list of ready callbacks */
+        Callback* link;
+        /** The previous callback in the same slot of the timer wheel */
+        Callback* prev;
+        /** The next callback in the same slot of the timer wheel */
+        Callback* next;
+        /** Whether this callback is about to be executed, and so out of the wheel */
+        bool ready;
+        /** Whether this callback was unscheduled while it was ready */
+        bool cancelled;
+    };
+    
     /** Counter to assign unique keys to callbacks */
-    Uint32 _funcid;
+    std::atomic<Uint32> _funcid;
+    /** The callbacks scheduled since the main thread last looked (newest first) */
+    std::atomic<Callback*> _incoming;
+    /** The timer wheel, with the callbacks due at each millisecond modulo its size */
+    Callback* _wheel[CU_CALLBACK_WHEEL];
+    /** The scheduled callbacks by key, so they can be unscheduled */
+    std::unordered_map<Uint32, Callback*> _callbacks;
+    /** The milliseconds processed by the callbacks so far */
+    Uint64 _clock;
     
-    /** Callback functions (processed at the start of every loop) */
-    std::unordered_map<Uint32, scheduable> _callbacks;
-	/** A mutex lock for the schedule queue */
-	std::mutex _queueMutex;
+    /**
+     * Pushes a callback on the queue of scheduled callbacks.
+     *
+     * This method is lock-free, and may be called from any thread.
+     *
+     * @param item  The callback to push
+     */
+    void pushCallback(Callback* item);
+
+    /**
+     * Moves everything from the queue of scheduled callbacks to the wheel.
+     *
+     * This method is only called on the main thread.
+     */
+    void drainCallbacks();
+
+    /**
+     * Adds a callback to the slot of the timer wheel for its due time.
+     *
+     * @param item  The callback to add
+     */
+    void insertCallback(Callback* item);
+
+    /**
+     * Removes a callback from the slot of the timer wheel it is in.
+     *
+     * @param item  The callback to remove
+     */
+    void removeCallback(Callback* item);
+
+    /**
+     * Returns true if a callback in the timer wheel is due within the time.
+     *
+     * @param millis    The number of milliseconds from now
+     *
+     * @return true if a callback in the timer wheel is due within the time.
+     */
+    bool hasCallbackDue(Uint32 millis) const;
+
+    /**
+     * Deletes all of the scheduled callbacks, including any still queued.
+     */
+    void clearCallbacks();
+
     /**
      * Processes all of the scheduled callback functions.
      *
@@ -191,10 +266,57 @@ private:
      * If they are a one time callback, they are deleted.  If they are
      * a reoccuring callback, the timer is reset.
      *
+     * Only the slots of the timer wheel for the milliseconds that passed
+     * are visited, so the cost depends on the callbacks that are ready,
+     * and not on how many are scheduled.
+     *
      * @param millis    The number of milliseconds since last called
      */
     void processCallbacks(Uint32 millis);
     
+    /** Whether draw() runs on its own thread while the last frame is submitted */
+    bool _pipelined;
+    /** The thread calling draw() in pipelined mode */
+    SDL_Thread* _drawThread;
+    /** Signals the draw thread to draw a frame */
+    SDL_sem* _drawStart;
+    /** Signals that the draw thread has finished its frame */
+    SDL_sem* _drawDone;
+    /** Whether the draw thread should exit instead of drawing */
+    bool _drawStop;
+    /** Whether the draw thread drew a frame that is not submitted yet */
+    bool _drawPending;
+    
+    /**
+     * The body function of the draw thread.
+     *
+     * @param ptr   The application
+     */
+    static int drawThreadFunc(void* ptr);
+    
+    /**
+     * Sleeps until there is an event to process or the timeout passes.
+     *
+     * SDL_WaitEventTimeout checks for events every millisecond, which keeps
+     * the CPU from ever sleeping. This method only checks every slice of
+     * the given length instead. A callback scheduled by another thread
+     * also ends the sleep, so that it is not held up while idle.
+     *
+     * @param timeout   The maximum time to sleep in milliseconds
+     * @param slice     The time between checks for events in milliseconds
+     */
+    void waitForEvent(Uint32 timeout, Uint32 slice);
+    
+    /**
+     * Starts the draw thread, if it is not running.
+     */
+    void startDrawThread();
+    
+    /**
+     * Stops the draw thread, waiting for it to exit.
+     */
+    void stopDrawThread();
+    
 #pragma mark -
 #pragma mark Constructors
 public:
@@ -330,11 +452,49 @@ public:
      * This is your core loop and should be replaced with your custom implementation.
      * This method should OpenGL and related drawing calls.
      *
+     * In pipelined mode, this method is called on a thread of its own, which
+     * has no OpenGL context. It should record its drawing with a deferred
+     * {@link SpriteBatch} instead, which {@link submit} then sends to OpenGL.
+     *
      * When overriding this method, you do not need to call the parent method
      * at all. The default implmentation does nothing.
      */
     virtual void draw() { }
 
+    /**
+     * The method called to submit the last frame drawn in pipelined mode.
+     *
+     * This method is only called in pipelined mode, on the main thread. It
+     * should submit the frames recorded by the previous call to draw(), as
+     * the next call to draw() runs at the same time. It is called even if
+     * there is no such frame yet, as is the case for the very first frame.
+     *
+     * When overriding this method, you do not need to call the parent method
+     * at all. The default implmentation does nothing.
+     */
+    virtual void submit() { }
+
+    /**
+     * Returns true if the next animation frame has anything new to draw.
+     *
+     * This method is called every animation frame, after update(). If it
+     * returns false, the application skips draw() and leaves the last frame
+     * on the screen, which saves the cost of drawing and swapping buffers.
+     * Any input forces the next frame to be drawn, whatever this method
+     * returns. An application that goes several frames in a row without
+     * drawing anything runs at {@link getIdleFPS()} until there is either
+     * input or something to draw, so that static screens use little power.
+     *
+     * A typical implementation asks whether any of the scenes it renders
+     * are {@link Scene2#isDirty()}.
+     *
+     * When overriding this method, you do not need to call the parent method
+     * at all. The default implmentation always returns true.
+     *
+     * @return true if the next animation frame has anything new to draw.
+     */
+    virtual bool needsRedraw() { return true; }
+
     
 #pragma mark -
 #pragma mark Application Loop
@@ -392,6 +552,9 @@ public:
      * It will be executed after the input has been processed, but before
      * the main {@link update} thread.
      *
+     * This method may be called from any thread. It never blocks, as the
+     * callback is handed to the main thread with a lock-free queue.
+     *
      * @param callback  The callback function
      * @param time      The number of milliseconds to delay the callback.
      *
@@ -420,6 +583,9 @@ public:
      * It will be executed after the input has been processed, but before
      * the main {@link update} thread.
      *
+     * This method may be called from any thread. It never blocks, as the
+     * callback is handed to the main thread with a lock-free queue.
+     *
      * @param callback  The callback function
      * @param time      The number of milliseconds to delay the callback.
      * @param period	The delay until the callback is executed again.
@@ -436,6 +602,9 @@ public:
      * be executed.  Once unscheduled, a callback must be re-scheduled in
      * order to be activated again.
      *
+     * This method may be called from any thread. The callback is removed
+     * before the main thread next processes callbacks, even if it is due.
+     *
      * The callback is identified by the unique identifier returned by the
      * appropriate schedule function.  Hence this value should be saved if
      * you ever wish to unschedule a callback.
@@ -745,6 +914,35 @@ public:
      */
     float getAverageFPS() const;
     
+    /**
+     * Sets the frames per second of this application while it is idle.
+     *
+     * An application is idle when {@link needsRedraw()} has returned false
+     * for a number of frames in a row, and no callback is due before the
+     * next idle frame. It then calls update() at this rate, and sleeps in
+     * between. Input still wakes the application up right
+     * away, as it checks for events at the target FPS while it sleeps. The
+     * application returns to the target FPS as soon as it has something
+     * to draw.
+     *
+     * This method may be safely changed at any time while the application
+     * is running.
+     *
+     * By default, this value is 10.
+     *
+     * @param fps   The frames per second while idle
+     */
+    void setIdleFPS(float fps);
+    
+    /**
+     * Returns the frames per second of this application while it is idle.
+     *
+     * By default, this value is 10.
+     *
+     * @return the frames per second of this application while it is idle.
+     */
+    float getIdleFPS() const { return _idleFPS; }
+    
     /**
      * Sets the clear color of this application
      *
@@ -768,6 +966,36 @@ public:
      */
     Color4 getClearColor() const { return (Color4)_clearColor; }
 
+    /**
+     * Sets whether this application draws on a thread of its own.
+     *
+     * In pipelined mode, each animation frame calls update() on the main
+     * thread as usual. Then draw() records the next frame on another thread,
+     * while the main thread submits the last frame and swaps the display
+     * buffers. This takes scene traversal and vertex generation off the
+     * main thread, at the cost of one frame of latency.
+     *
+     * The draw thread only runs while the main thread is submitting, so
+     * draw() may read anything that update() wrote. But it must not change
+     * anything that the main thread uses to submit, and it must not make
+     * OpenGL calls. The display orientation listener may be called while
+     * draw() is running.
+     *
+     * This method may be safely changed at any time while the application
+     * is running. It takes effect at the next animation frame. By default,
+     * this value is false.
+     *
+     * @param value Whether this application draws on a thread of its own
+     */
+    void setPipelined(bool value) { _pipelined = value; }
+
+    /**
+     * Returns true if this application draws on a thread of its own.
+     *
+     * @return true if this application draws on a thread of its own
+     */
+    bool isPipelined() const { return _pipelined; }
+
     /**
      * Returns the current state of this application.
      *
@@ -37,6 +37,7 @@
 #include <cugl/input/CUInput.h>
 #include <cugl/math/CURect.h>
 #include <cugl/math/CUVec2.h>
+#include <vector>
 
 /** This represents the extent of all buttons */
 #define SDL_BUTTON_ALLMASK ((1 << 6) - 1)
@@ -351,6 +352,45 @@ public:
     }
 };
 
+/**
+ * This simple class is an entry in the mouse event history.
+ *
+ * The mouse records every button and motion event that it receives in an
+ * animation frame, in the order that it received them.  Polling only shows
+ * the last position of the mouse, but the history preserves the exact
+ * timestamps and the complete path of a drag within the frame.
+ */
+class MouseRecord {
+public:
+    /** The type of mouse event */
+    enum class Type : int {
+        /** One or more buttons were pressed */
+        PRESS,
+        /** One or more buttons were released */
+        RELEASE,
+        /** The mouse pointer was moved */
+        MOTION
+    };
+    
+    /** The type of this mouse event */
+    Type type;
+    /**
+     * The mouse event information
+     *
+     * For presses and releases, the buttons are the ones that changed.  For
+     * motion, they are the buttons held down during the motion.
+     */
+    MouseEvent event;
+    
+    /**
+     * Constructs a new history entry with the given values
+     *
+     * @param kind      The type of mouse event
+     * @param data      The mouse event information
+     */
+    MouseRecord(Type kind, const MouseEvent& data) : type(kind), event(data) {}
+};
+
 #pragma mark -
 
 /**
@@ -555,6 +595,9 @@ protected:
     std::unordered_map<Uint32, MotionListener> _dragListeners;
     /** The set of listeners called whenever a mouse wheel is moved */
     std::unordered_map<Uint32, WheelListener> _wheelListeners;
+    
+    /** The button and motion events received this animation frame, in order */
+    std::vector<MouseRecord> _history;
 
 #pragma mark Constructor
     /**
@@ -670,6 +713,20 @@ public:
      * @return the amount the mouse wheel moved this animation frame.
      */
     Vec2 wheelDirection() const { return _wheelOffset; }
+
+    /**
+     * Returns the button and motion events received this animation frame.
+     *
+     * Polling methods only report the state of the mouse at the start of
+     * the frame.  This history has an entry for every press, release, and
+     * motion event in the frame, in order and each with its own timestamp.
+     * Motion is only recorded if allowed by the current pointer awareness.
+     *
+     * The history is cleared at the start of each animation frame.
+     *
+     * @return the button and motion events received this animation frame.
+     */
+    const std::vector<MouseRecord>& eventHistory() const { return _history; }
     
 #pragma mark Listeners
     /**
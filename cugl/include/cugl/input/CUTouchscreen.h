@@ -79,6 +79,40 @@ public:
     }
 };
 
+/**
+ * This simple class is an entry in the touch event history.
+ *
+ * The touch screen records every touch event that it receives in an
+ * animation frame, in the order that it received them.  Polling only shows
+ * the last position of each touch, but the history preserves the exact
+ * timestamps and the complete path of every touch in the frame.
+ */
+class TouchRecord {
+public:
+    /** The type of touch event */
+    enum class Type : int {
+        /** A finger was placed on the screen */
+        BEGIN,
+        /** A finger was moved across the screen */
+        MOTION,
+        /** A finger was removed from the screen */
+        END
+    };
+    
+    /** The type of this touch event */
+    Type type;
+    /** The touch event information */
+    TouchEvent event;
+    
+    /**
+     * Constructs a new history entry with the given values
+     *
+     * @param kind      The type of touch event
+     * @param data      The touch event information
+     */
+    TouchRecord(Type kind, const TouchEvent& data) : type(kind), event(data) {}
+};
+
 
 
 #pragma mark -
@@ -194,6 +228,9 @@ protected:
     std::unordered_map<Uint32, ContactListener> _finishListeners;
     /** The set of listeners called whenever a touch is moved */
     std::unordered_map<Uint32, MotionListener> _moveListeners;
+    
+    /** The touch events received this animation frame, in order */
+    std::vector<TouchRecord> _history;
 
 #pragma mark Constructors
     /**
@@ -305,6 +342,21 @@ public:
      * @return the set of identifiers for the fingers currently held down.
      */
     const std::vector<TouchID> touchSet() const;
+
+    /**
+     * Returns the touch events received this animation frame, in order.
+     *
+     * Polling methods only report the state of the touch screen at the
+     * start of the frame.  This history has an entry for every begin,
+     * motion, and end event in the frame, each with its own timestamp.
+     * Use this for gestures that need exact timing or a complete path,
+     * such as double taps at a low frame rate.
+     *
+     * The history is cleared at the start of each animation frame.
+     *
+     * @return the touch events received this animation frame, in order.
+     */
+    const std::vector<TouchRecord>& eventHistory() const { return _history; }
     
 #pragma mark Listeners
     /**
@@ -0,0 +1,363 @@
+//
+//  CUJsonParser.h
+//  Cornell University Game Library (CUGL)
+//
+//  This module provides a streaming (pull) parser for JSON text.  Unlike
+//  JsonReader, it does not build a tree of JsonValue objects.  Instead, the
+//  caller pulls one event at a time (begin object, key, number, and so on)
+//  and builds whatever compact structure it needs directly.  This avoids the
+//  intermediate DOM, which is significant for files like levels that are
+//  mostly large arrays of integers.
+//
+//  The parser is strict JSON.  It does not support comments or trailing
+//  commas, and it expects the text to hold a single JSON value.
+//
+//  This class uses our standard shared-pointer architecture.
+//
+//  1. The constructor does not perform any initialization; it just sets all
+//     attributes to their defaults.
+//
+//  2. All initialization takes place via init methods, which can fail if an
+//     object is initialized more than once.
+//
+//  3. All allocation takes place via static constructors which return a shared
+//     pointer.
+//
+//  CUGL MIT License:
+//      This software is provided 'as-is', without any express or implied
+//      warranty.  In no event will the authors be held liable for any damages
+//      arising from the use of this software.
+//
+//      Permission is granted to anyone to use this software for any purpose,
+//      including commercial applications, and to alter it and redistribute it
+//      freely, subject to the following restrictions:
+//
+//      1. The origin of this software must not be misrepresented; you must not
+//      claim that you wrote the original software. If you use this software
+//      in a product, an acknowledgment in the product documentation would be
+//      appreciated but is not required.
+//
+//      2. Altered source versions must be plainly marked as such, and must not
+//      be misrepresented as being the original software.
+//
+//      3. This notice may not be removed or altered from any source distribution.
+//
+//  Author: Dragonglass Studios
+//  Version: 10/18/26
+//
+#ifndef __CU_JSON_PARSER_H__
+#define __CU_JSON_PARSER_H__
+#include <cugl/base/CUBase.h>
+#include <string>
+#include <vector>
+#include <memory>
+
+namespace  cugl {
+
+/**
+ * A streaming (pull) parser for JSON text.
+ *
+ * Each call to {@link next()} advances the parser by one event and returns
+ * it.  Keys and string values are available from {@link getString()}, and
+ * numbers from {@link getNumber()} (or its typed variants).  The parser
+ * never allocates per value; the only storage is the text itself, the
+ * current string, and a stack of open containers.
+ *
+ * A typical consumer looks like this:
+ *
+ *      parser->next();                     // BEGIN_OBJECT
+ *      while (parser->next() == JsonParser::Event::KEY) {
+ *          if (parser->getString() == "size") {
+ *              parser->next();
+ *              size = parser->getInt();
+ *          } else {
+ *              parser->skip();
+ *          }
+ *      }
+ *
+ * Once the parser encounters an error, every later call to {@link next()}
+ * returns {@link Event#ERROR}, and {@link getError()} describes the problem.
+ *
+ * By default, {@link initWithAsset} reads from the asset directory, just
+ * like {@link JsonReader#allocWithAsset}.
+ */
+class JsonParser {
+public:
+    /**
+     * The events reported by the parser.
+     */
+    enum class Event : int {
+        /** The start of a JSON object */
+        BEGIN_OBJECT,
+        /** The end of a JSON object */
+        END_OBJECT,
+        /** The start of a JSON array */
+        BEGIN_ARRAY,
+        /** The end of a JSON array */
+        END_ARRAY,
+        /** An object key; the value follows as the next event */
+        KEY,
+        /** A string value */
+        STRING,
+        /** A number value */
+        NUMBER,
+        /** A boolean value */
+        BOOLEAN,
+        /** A null value */
+        NIL,
+        /** The end of the text */
+        END,
+        /** The text is not valid JSON */
+        ERROR
+    };
+
+private:
+    /** This macro disables the copy constructor (not allowed on parsers) */
+    CU_DISALLOW_COPY_AND_ASSIGN(JsonParser);
+
+protected:
+    /** The JSON text */
+    std::string _text;
+    /** The current read position in the text */
+    size_t _pos;
+    /** The open containers; '{' for objects and '[' for arrays */
+    std::vector<char> _stack;
+    /** Whether the innermost container has not read any values yet */
+    bool _first;
+    /** Whether we have read a key and are waiting on its value */
+    bool _keyed;
+    /** Whether we have read the top-level value */
+    bool _started;
+
+    /** The most recent event */
+    Event _event;
+    /** The current key or string value */
+    std::string _string;
+    /** The current number value */
+    double _number;
+    /** The current boolean value */
+    bool _boolean;
+    /** The error message, if parsing failed */
+    std::string _error;
+
+#pragma mark Internal Helpers
+    /**
+     * Skips any whitespace at the current position.
+     */
+    void skipSpace();
+
+    /**
+     * Returns the event for the value at the current position.
+     *
+     * @return the event for the value at the current position.
+     */
+    Event readValue();
+
+    /**
+     * Reads a quoted string at the current position into {@link _string}.
+     *
+     * @return true if the string was read successfully
+     */
+    bool readString();
+
+    /**
+     * Reads the literal word at the current position.
+     *
+     * @param word  The expected word
+     *
+     * @return true if the word was read successfully
+     */
+    bool readWord(const char* word);
+
+    /**
+     * Reads four hexadecimal digits at the given position.
+     *
+     * @param pos   The position of the first digit
+     * @param code  The value of the digits
+     *
+     * @return true if there were four hexadecimal digits
+     */
+    bool readHex(size_t pos, Uint32& code) const;
+
+    /**
+     * Returns the length of the JSON number at the current position.
+     *
+     * This follows the JSON grammar exactly, so it rejects the leading
+     * plus signs, leading zeroes, hexadecimal values and special values
+     * that strtod would accept.
+     *
+     * @return the length of the JSON number (0 if there is no number)
+     */
+    size_t scanNumber() const;
+
+    /**
+     * Marks the parser as failed with the given message.
+     *
+     * @param message   The error message
+     *
+     * @return {@link Event#ERROR}
+     */
+    Event fail(const std::string& message);
+
+public:
+#pragma mark -
+#pragma mark Constructors
+    /**
+     * Creates a parser with no text.
+     *
+     * NEVER USE A CONSTRUCTOR WITH NEW. If you want to allocate an object on
+     * the heap, use one of the static constructors instead.
+     */
+    JsonParser();
+
+    /**
+     * Deletes this parser, releasing all resources.
+     */
+    ~JsonParser() { dispose(); }
+
+    /**
+     * Initializes this parser with the given JSON text.
+     *
+     * The text is copied, so the parser is safe to use after the string
+     * is released.
+     *
+     * @param text  The JSON text
+     *
+     * @return true if the parser is initialized properly
+     */
+    bool init(const std::string& text);
+
+    /**
+     * Initializes this parser with the contents of the given asset file.
+     *
+     * The file name is relative to the asset directory.
+     *
+     * @param file  The JSON file in the asset directory
+     *
+     * @return true if the parser is initialized properly
+     */
+    bool initWithAsset(const std::string& file);
+
+    /**
+     * Releases the text and resets all state.
+     */
+    void dispose();
+
+    /**
+     * Returns a newly allocated parser for the given JSON text.
+     *
+     * @param text  The JSON text
+     *
+     * @return a newly allocated parser for the given JSON text.
+     */
+    static std::shared_ptr<JsonParser> alloc(const std::string& text) {
+        std::shared_ptr<JsonParser> result = std::make_shared<JsonParser>();
+        return (result->init(text) ? result : nullptr);
+    }
+
+    /**
+     * Returns a newly allocated parser for the given asset file.
+     *
+     * The file name is relative to the asset directory.
+     *
+     * @param file  The JSON file in the asset directory
+     *
+     * @return a newly allocated parser for the given asset file.
+     */
+    static std::shared_ptr<JsonParser> allocWithAsset(const std::string& file) {
+        std::shared_ptr<JsonParser> result = std::make_shared<JsonParser>();
+        return (result->initWithAsset(file) ? result : nullptr);
+    }
+
+#pragma mark -
+#pragma mark Parsing
+    /**
+     * Returns the next event in the text.
+     *
+     * After a {@link Event#KEY}, the next event is always the value for that
+     * key.  Once the whole value has been read, this returns {@link Event#END}.
+     *
+     * @return the next event in the text.
+     */
+    Event next();
+
+    /**
+     * Skips the current value.
+     *
+     * If the last event was {@link Event#KEY}, this skips the value for that
+     * key.  If it began an object or array, this skips to (and consumes) the
+     * matching end.  Otherwise it does nothing, as scalars are already read.
+     *
+     * @return false if the parser failed while skipping
+     */
+    bool skip();
+
+    /**
+     * Returns the most recent event.
+     *
+     * @return the most recent event.
+     */
+    Event getEvent() const { return _event; }
+
+    /**
+     * Returns the number of containers currently open.
+     *
+     * @return the number of containers currently open.
+     */
+    size_t getDepth() const { return _stack.size(); }
+
+    /**
+     * Returns the current key or string value.
+     *
+     * @return the current key or string value.
+     */
+    const std::string& getString() const { return _string; }
+
+    /**
+     * Returns the current number value.
+     *
+     * @return the current number value.
+     */
+    double getNumber() const { return _number; }
+
+    /**
+     * Returns the current number value as a float.
+     *
+     * @return the current number value as a float.
+     */
+    float getFloat() const { return (float)_number; }
+
+    /**
+     * Returns the current number value as an int.
+     *
+     * @return the current number value as an int.
+     */
+    int getInt() const { return (int)_number; }
+
+    /**
+     * Returns the current boolean value.
+     *
+     * @return the current boolean value.
+     */
+    bool getBool() const { return _boolean; }
+
+    /**
+     * Returns true if the parser has encountered an error.
+     *
+     * @return true if the parser has encountered an error.
+     */
+    bool failed() const { return _event == Event::ERROR; }
+
+    /**
+     * Returns the error message if the parser failed.
+     *
+     * The message includes the offset of the error in the text.
+     *
+     * @return the error message if the parser failed.
+     */
+    const std::string& getError() const { return _error; }
+};
+
+}
+
+#endif /* __CU_JSON_PARSER_H__ */
@@ -0,0 +1,162 @@
+//
+//  CUMappedFile.h
+//  Cornell University Game Library (CUGL)
+//
+//  This module provides read-only access to the whole contents of a file as
+//  a single block of memory.  Where the platform allows it, the file is
+//  memory mapped, so opening it costs nothing until the pages are touched,
+//  and the pages are shared with the file cache.  On platforms where the
+//  assets are not ordinary files (such as Android), or that lack mmap (such
+//  as Windows), the file is read into a single buffer instead.
+//
+//  This is the backing store for packed binary assets like sound banks and
+//  compiled levels, which are parsed in place rather than copied.
+//
+//  This class uses our standard shared-pointer architecture.
+//
+//  1. The constructor does not perform any initialization; it just sets all
+//     attributes to their defaults.
+//
+//  2. All initialization takes place via init methods, which can fail if an
+//     object is initialized more than once.
+//
+//  3. All allocation takes place via static constructors which return a shared
+//     pointer.
+//
+//  CUGL MIT License:
+//      This software is provided 'as-is', without any express or implied
+//      warranty.  In no event will the authors be held liable for any damages
+//      arising from the use of this software.
+//
+//      Permission is granted to anyone to use this software for any purpose,
+//      including commercial applications, and to alter it and redistribute it
+//      freely, subject to the following restrictions:
+//
+//      1. The origin of this software must not be misrepresented; you must not
+//      claim that you wrote the original software. If you use this software
+//      in a product, an acknowledgment in the product documentation would be
+//      appreciated but is not required.
+//
+//      2. Altered source versions must be plainly marked as such, and must not
+//      be misrepresented as being the original software.
+//
+//      3. This notice may not be removed or altered from any source distribution.
+//
+//  Author: Dragonglass Studios
+//  Version: 10/18/26
+//
+#ifndef __CU_MAPPED_FILE_H__
+#define __CU_MAPPED_FILE_H__
+#include <cugl/base/CUBase.h>
+#include <SDL/SDL.h>
+#include <string>
+#include <memory>
+
+namespace cugl {
+
+/**
+ * Read-only contents of a file as a single block of memory.
+ *
+ * The contents are memory mapped where the platform allows it, and read
+ * into a buffer otherwise.  Either way, {@link data()} is valid until the
+ * file is disposed, and it must never be written to.
+ *
+ * Unlike the other readers in this package, the file name is used as is.
+ * To open an asset, prefix it with {@link Application#getAssetDirectory}.
+ */
+class MappedFile {
+private:
+    /** This macro disables the copy constructor (not allowed on mapped files) */
+    CU_DISALLOW_COPY_AND_ASSIGN(MappedFile);
+
+protected:
+    /** The file name */
+    std::string _name;
+    /** The file contents (mapped or read into memory) */
+    Uint8* _data;
+    /** The size of the contents in bytes */
+    size_t _size;
+    /** Whether the contents are memory mapped (as opposed to allocated) */
+    bool _mapped;
+
+public:
+#pragma mark Constructors
+    /**
+     * Creates a degenerate file with no contents.
+     *
+     * NEVER USE A CONSTRUCTOR WITH NEW. If you want to allocate an object on
+     * the heap, use one of the static constructors instead.
+     */
+    MappedFile();
+
+    /**
+     * Deletes this file, releasing all resources.
+     */
+    ~MappedFile() { dispose(); }
+
+    /**
+     * Initializes this file with the contents of the given path.
+     *
+     * The file is memory mapped where the platform allows it.  Otherwise it
+     * is read into a single buffer.  Empty files fail to initialize.
+     *
+     * @param file  The path of the file
+     *
+     * @return true if the file was opened successfully
+     */
+    bool init(const std::string& file);
+
+    /**
+     * Releases the contents of this file.
+     *
+     * Any pointer previously returned by {@link data()} is invalid after
+     * this call.
+     */
+    void dispose();
+
+    /**
+     * Returns a newly allocated file with the contents of the given path.
+     *
+     * @param file  The path of the file
+     *
+     * @return a newly allocated file with the contents of the given path.
+     */
+    static std::shared_ptr<MappedFile> alloc(const std::string& file) {
+        std::shared_ptr<MappedFile> result = std::make_shared<MappedFile>();
+        return (result->init(file) ? result : nullptr);
+    }
+
+#pragma mark -
+#pragma mark Attributes
+    /**
+     * Returns the contents of this file.
+     *
+     * @return the contents of this file.
+     */
+    const Uint8* data() const { return _data; }
+
+    /**
+     * Returns the size of the contents in bytes.
+     *
+     * @return the size of the contents in bytes.
+     */
+    size_t size() const { return _size; }
+
+    /**
+     * Returns true if the contents are memory mapped.
+     *
+     * @return true if the contents are memory mapped.
+     */
+    bool isMapped() const { return _mapped; }
+
+    /**
+     * Returns the name of this file.
+     *
+     * @return the name of this file.
+     */
+    const std::string& getName() const { return _name; }
+};
+
+}
+
+#endif /* __CU_MAPPED_FILE_H__ */
@@ -31,8 +31,10 @@
 #include "CUTextReader.h"
 #include "CUTextWriter.h"
 #include "CUJsonReader.h"
+#include "CUJsonParser.h"
 #include "CUJsonWriter.h"
 #include "CUBinaryReader.h"
 #include "CUBinaryWriter.h"
+#include "CUMappedFile.h"
 
 #endif /* __CU_IO_PKG_H__ */
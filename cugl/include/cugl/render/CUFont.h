@@ -57,6 +57,9 @@
 #include <cugl/render/CUMesh.h>
 #include <SDL/SDL_ttf.h>
 
+/** The characters whose atlas data is stored densely (ASCII and Latin-1) */
+#define CU_FONT_DENSE   256
+
 namespace cugl {
     
 /**
@@ -229,6 +232,8 @@ protected:
     std::string _stylename;
     /** The font size in points */
     int _size;
+    /** The font file, to render glyphs at a higher resolution */
+    std::string _source;
     
     /** The underlying SDL data */
     TTF_Font* _data;
@@ -254,6 +259,8 @@ protected:
     Hinting _hints;
     /** The rendering resolution (when there is no atlas) */
     Resolution _render;
+    /** The distance field spread of the atlas in pixels (0 for a bitmap atlas) */
+    Uint32 _spread;
     
     // Altas support
     /** Whether this font has an active atlas */
@@ -264,8 +271,30 @@ protected:
     std::unordered_map<Uint32, Rect> _glyphmap;
     /** The cached metrics for each font glyph */
     std::unordered_map<Uint32, Metrics> _glyphsize;
-    /** The kerning for each pair of characters */
-    std::unordered_map<Uint32, std::unordered_map<Uint32, Uint32> > _kernmap;
+
+    /** The atlas data of a glyph, for the dense glyph table */
+    class Glyph {
+    public:
+        /** The location of the glyph in the atlas texture */
+        Rect bounds;
+        /** The glyph metrics */
+        Metrics metrics;
+        /** Whether the glyph is in the atlas */
+        bool valid;
+    };
+    /** The atlas data of the first CU_FONT_DENSE characters, indexed by character */
+    std::vector<Glyph> _glyphtable;
+
+    /** A pair of characters in the kerning table */
+    class KernPair {
+    public:
+        /** The two characters, first character in the high bits (all ones if empty) */
+        Uint64 key;
+        /** The kerning of the pair */
+        Uint32 value;
+    };
+    /** The nonzero kerning of character pairs, as an open-addressed hash table */
+    std::vector<KernPair> _kerntable;
     /** The OpenGL texture representing this atlas */
     std::shared_ptr<Texture> _texture;
     /** A (temporary) SDL surface for computing the atlas texture */
@@ -558,6 +587,54 @@ public:
      */
     void setResolution(Resolution resolution) { clearAtlas(); _render = resolution; }
 
+    /**
+     * Returns the distance field spread of the atlas in pixels.
+     *
+     * If this value is positive, the atlas stores a signed distance field
+     * instead of a bitmap. The alpha of each pixel is how far it is from
+     * the edge of its glyph, where 0.5 is the edge itself, and 0 and 1
+     * are this many pixels outside or inside the glyph. Larger spreads
+     * allow wider outlines and glows, at the cost of precision. Each glyph
+     * quad extends this many pixels past the glyph, to make room for them.
+     *
+     * A distance field atlas must be drawn by a {@link SpriteBatch} with a
+     * distance edge (which {@link scene2::Label} does automatically). It
+     * then stays crisp at any scale, so one large font can serve every
+     * size of text. This value is 0 by default.
+     *
+     * @return the distance field spread of the atlas in pixels.
+     */
+    Uint32 getDistanceSpread() const { return _spread; }
+
+    /**
+     * Sets the distance field spread of the atlas in pixels.
+     *
+     * Changing this value will delete any atlas that is present.  The atlas
+     * must be regenerated.
+     *
+     * If this value is positive, the atlas stores a signed distance field
+     * instead of a bitmap. The alpha of each pixel is how far it is from
+     * the edge of its glyph, where 0.5 is the edge itself, and 0 and 1
+     * are this many pixels outside or inside the glyph. Larger spreads
+     * allow wider outlines and glows, at the cost of precision. Each glyph
+     * quad extends this many pixels past the glyph, to make room for them.
+     *
+     * A distance field atlas must be drawn by a {@link SpriteBatch} with a
+     * distance edge (which {@link scene2::Label} does automatically). It
+     * then stays crisp at any scale, so one large font can serve every
+     * size of text. This value is 0 by default.
+     *
+     * @param spread    The distance field spread of the atlas in pixels.
+     */
+    void setDistanceSpread(Uint32 spread) { clearAtlas(); _spread = spread; }
+
+    /**
+     * Returns true if this font has an atlas that is a distance field.
+     *
+     * @return true if this font has an atlas that is a distance field.
+     */
+    bool hasDistanceField() const { return _hasAtlas && _spread > 0; }
+
 
     
 #pragma mark -
@@ -1382,9 +1459,64 @@ protected:
     
     /**
      * Gathers the kerning information for the atlas.
+     *
+     * Only pairs with nonzero kerning are stored. The table is open-addressed
+     * with linear probing, and is never more than half full.
      */
     void prepareAtlasKerning();
 
+    /**
+     * Copies the atlas data of the ASCII and Latin-1 glyphs to a dense table.
+     *
+     * This must be called once the glyphs have their final place in the atlas.
+     */
+    void prepareGlyphTable();
+
+    /**
+     * Returns the location of the given character in the atlas.
+     *
+     * This method returns nullptr if the character is not in the atlas.
+     *
+     * @param thechar   The Unicode character to look up
+     *
+     * @return the location of the given character in the atlas.
+     */
+    const Rect* findGlyph(Uint32 thechar) const {
+        if (thechar < _glyphtable.size()) {
+            return _glyphtable[thechar].valid ? &_glyphtable[thechar].bounds : nullptr;
+        }
+        auto it = _glyphmap.find(thechar);
+        return it == _glyphmap.end() ? nullptr : &(it->second);
+    }
+
+    /**
+     * Returns the metrics of the given character in the atlas.
+     *
+     * The character must be in the atlas.
+     *
+     * @param thechar   The Unicode character to look up
+     *
+     * @return the metrics of the given character in the atlas.
+     */
+    const Metrics& getAtlasMetrics(Uint32 thechar) const {
+        if (thechar < _glyphtable.size()) {
+            return _glyphtable[thechar].metrics;
+        }
+        return _glyphsize.at(thechar);
+    }
+
+    /**
+     * Returns the kerning between two characters of the atlas.
+     *
+     * This method returns 0 for any pair that is not in the kerning table.
+     *
+     * @param a     The first Unicode character in the pair
+     * @param b     The second Unicode character in the pair
+     *
+     * @return the kerning between two characters of the atlas.
+     */
+    Uint32 getAtlasKerning(Uint32 a, Uint32 b) const;
+
     /**
      * Returns the metrics for the given character if available.
      * 
@@ -1452,6 +1584,19 @@ protected:
      * @return true if the surface was successfully generated.
      */
     bool generateSurface(int width, int height);
+
+    /**
+     * Writes the distance field of a glyph to its cell in the SDL surface.
+     *
+     * The glyph is measured at a higher resolution than the atlas, so that
+     * the edges are placed more precisely than a pixel. The cell includes a
+     * frame of the spread on each side, so the field is never cut off.
+     *
+     * @param glyph     The glyph rendered at scale times the font size
+     * @param scale     The resolution of the glyph relative to the atlas
+     * @param bounds    The location of the glyph cell in the atlas
+     */
+    void generateDistanceField(SDL_Surface* glyph, int scale, const Rect& bounds);
     
     /**
      * Allocates a blank surface of the given size.
@@ -520,6 +520,19 @@ public:
      * return control to the default render target (the screen) when done.
      */
     void begin();
+
+    /**
+     * Resumes sending draw commands to this render target.
+     *
+     * This method is like {@link #begin}, except that the output textures
+     * are not cleared. Drawing adds to whatever this render target already
+     * holds, so it can accumulate over several passes.
+     *
+     * It is NOT safe to call a resume/end pair of a render target inside of
+     * another render target.  Render targets do not keep a stack.  They alway
+     * return control to the default render target (the screen) when done.
+     */
+    void resume();
     
     /**
      * Stops sendinging draw commands to this render target.
@@ -47,6 +47,9 @@
 #define __CU_SPRITE_BATCH_H__
 
 #include <SDL/SDL.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
 #include <vector>
 #include "CUSpriteVertex.h"
 #include "CUMesh.h"
@@ -166,10 +169,39 @@ private:
         GLsizei blockptr;
         /** The pixel step for our blur function */
         GLuint  blurstep;
+        /** The edge of a distance field texture (0 if not a distance field) */
+        GLfloat distedge;
         /** The dirty bits relative to the previous set of uniforms */
         GLuint dirty;
     };
 
+    /**
+     * A class storing a frame recorded in deferred mode.
+     *
+     * A frame is everything that {@link flush} would have sent to OpenGL,
+     * kept until {@link submit}. The index ranges of the contexts and their
+     * block offsets are relative to the whole frame. Once published, a
+     * frame is never modified until it is submitted.
+     */
+    class Frame {
+    public:
+        /** The vertices of the frame */
+        std::vector<SpriteVertex3> vertices;
+        /** The indices of the frame */
+        std::vector<GLuint> indices;
+        /** The recorded uniforms, in drawing order */
+        std::vector<Context> contexts;
+        /** The uniform blocks for gradients and scissors */
+        std::vector<float> blocks;
+        /** The texture active at the end of the frame */
+        std::shared_ptr<Texture> texture;
+
+        /**
+         * Empties this frame, keeping its memory for the next one.
+         */
+        void clear();
+    };
+
     /** Whether this sprite batch has been initialized yet */
     bool _initialized;
     /** Whether this sprite batch is currently active */
@@ -218,6 +250,22 @@ private:
     unsigned int _vertTotal;
     /** The number of OpenGL calls in this pass (so far) */
     unsigned int _callTotal;
+
+    // Deferred drawing
+    /** Whether this sprite batch records frames instead of drawing them */
+    bool _deferred;
+    /** The storage for the frames in deferred mode */
+    Frame _frames[3];
+    /** The frame being recorded */
+    Frame* _recording;
+    /** The frame last submitted */
+    Frame* _submitted;
+    /** The last published frame, with the low bit set if not submitted */
+    std::atomic<uintptr_t> _published;
+    /** The mutex guarding a hand-off of the published frame */
+    std::mutex _publishMutex;
+    /** The condition signalled when the published frame is submitted */
+    std::condition_variable _publishCondition;
     
 
 #pragma mark -
@@ -492,15 +540,6 @@ public:
      */
     void setShader(const std::shared_ptr<Shader>& shader);
 
-    void setViewport(const Vec2 res);
-    
-    /**
-     *Sets the splatter locations for this batch.
-     *
-     *@param 
-     */
-    void setSplats(const Vec2 s1, const Vec2 s2, const Vec2 s3, const Vec2 s4, const Vec4 c1, const Vec4 c2, const Vec4 c3, const Vec4 c4);
-    
     /**
      * Returns the shader for this sprite batch
      *
@@ -813,6 +852,48 @@ public:
      * @return the blur step in pixels (0 if there is no blurring).
      */
     GLuint getBlurStep() const { return _context->blurstep; }
+
+    /**
+     * Sets the edge of a distance field texture (0 if not a distance field).
+     *
+     * A distance field texture stores in its alpha how far each pixel is
+     * from the edge of a shape, such as a glyph of a distance field font.
+     * When this value is positive, the alpha of the texture is compared
+     * to this edge, and the shape is cut out with an antialiased border
+     * one screen pixel wide. As this border does not depend on the size
+     * of the texture, the shape stays crisp at any scale.
+     *
+     * An edge of 0.5 draws the shape itself. Lower values grow the shape,
+     * which can be used to draw an outline or glow underneath it, while
+     * higher values shrink it.
+     *
+     * Setting this value to 0 will disable distance fields. This value
+     * is 0 by default.
+     *
+     * @param edge  The edge of a distance field texture
+     */
+    void setDistanceEdge(GLfloat edge);
+
+    /**
+     * Returns the edge of a distance field texture (0 if not a distance field).
+     *
+     * A distance field texture stores in its alpha how far each pixel is
+     * from the edge of a shape, such as a glyph of a distance field font.
+     * When this value is positive, the alpha of the texture is compared
+     * to this edge, and the shape is cut out with an antialiased border
+     * one screen pixel wide. As this border does not depend on the size
+     * of the texture, the shape stays crisp at any scale.
+     *
+     * An edge of 0.5 draws the shape itself. Lower values grow the shape,
+     * which can be used to draw an outline or glow underneath it, while
+     * higher values shrink it.
+     *
+     * Setting this value to 0 will disable distance fields. This value
+     * is 0 by default.
+     *
+     * @return the edge of a distance field texture
+     */
+    GLfloat getDistanceEdge() const { return _context->distedge; }
     
 
 #pragma mark -
@@ -861,6 +942,58 @@ public:
     void flush();
 
     
+#pragma mark -
+#pragma mark Deferred Drawing
+    /**
+     * Sets whether this sprite batch defers its drawing to {@link submit}.
+     *
+     * A deferred sprite batch makes no OpenGL calls while drawing. Instead,
+     * everything drawn is recorded into a frame. A call to {@link publish}
+     * completes the frame, and {@link submit} sends the latest complete frame
+     * to OpenGL. This allows drawing to happen on a thread without an OpenGL
+     * context, while the thread with the context submits the previous frame.
+     *
+     * Drawing and publishing must happen on one thread, and submitting on
+     * one other. Publishing waits until the previous frame is submitted, so
+     * every published frame must be submitted. The frames hold on to their
+     * textures until they are submitted.
+     *
+     * This value may not be changed while drawing. It is false by default.
+     *
+     * @param deferred  Whether this sprite batch defers its drawing
+     */
+    void setDeferred(bool deferred);
+
+    /**
+     * Returns true if this sprite batch defers its drawing to {@link submit}.
+     *
+     * @return true if this sprite batch defers its drawing to {@link submit}.
+     */
+    bool isDeferred() const { return _deferred; }
+
+    /**
+     * Completes the frame recorded since the last call.
+     *
+     * The frame becomes the one drawn by the next call to {@link submit}.
+     * If the previous frame has not been submitted yet, this method waits
+     * until it is. This method may only be called in deferred mode, and not
+     * while drawing.
+     */
+    void publish();
+
+    /**
+     * Sends the latest published frame to OpenGL.
+     *
+     * This method must be called on the thread with the OpenGL context. It
+     * draws nothing if no frame has been published since the last call.
+     * Calling this method will reset the vertex and OpenGL call counters to
+     * those of the frame.
+     *
+     * @return true if a frame was drawn
+     */
+    bool submit();
+
+
 #pragma mark -
 #pragma mark Solid Shapes
     /**
@@ -1908,6 +2041,25 @@ private:
      * This method is called upon flushing or cleanup.
      */
     void unwind();
+
+    /**
+     * Moves the vertices and uniforms batched so far into the current frame.
+     *
+     * This method is called instead of drawing upon flushing in deferred
+     * mode.
+     */
+    void defer();
+
+    /**
+     * Applies the given uniforms to the shader and OpenGL state.
+     *
+     * Only the dirty values are applied, with the exception of the uniform
+     * block. As the block depends on what is loaded in the uniform buffer,
+     * that is left to the caller.
+     *
+     * @param context   The uniforms to apply
+     */
+    void apply(const Context* context);
     
     /**
      * Sets the active uniform block to agree with the gradient and stroke.
@@ -48,6 +48,9 @@
 #include <cugl/render/CUOrthographicCamera.h>
 
 namespace cugl {
+
+// Forward declarations
+class ThreadPool;
     
 /**
  * This class provides the root node of a two-dimensional scene graph.
@@ -65,6 +68,12 @@ namespace cugl {
  * Scenes do support optional z-ordering.  This is not a true depth value, as
  * depth filtering is incompatible with alpha compositing.  However, it does
  * provide a way to dynamically reorder how siblings are composed.
+ *
+ * The traversal is not recursive. The scene graph is flattened into an array
+ * in draw order, which is kept until nodes are added, removed, or reordered.
+ * Each render first computes the transforms and screen bounds of every node,
+ * level by level, and then draws only the nodes that are visible on screen
+ * and inside their scissors.
  */
 class Scene2 {
 #pragma mark Values
@@ -81,6 +90,8 @@ protected:
     bool _zDirty;
     /** Indicates whether auto-sorting is active */
     bool _zSort;
+    /** Indicates whether anything has changed since the last render */
+    bool _dirty;
     
     /** The blending equation for this scene */
     GLenum _blendEquation;
@@ -92,6 +103,44 @@ protected:
     /** Whether or note this scene is still active */
     bool _active;
 
+    /** A node of the flattened scene graph */
+    class RenderEntry {
+    public:
+        /** The scene graph node */
+        scene2::SceneNode* node;
+        /** The offset of the parent entry (-1 for a child of the scene) */
+        int parent;
+        /** The offset just past the last descendant of this node */
+        int end;
+        /** The depth of this node (0 for a child of the scene) */
+        int depth;
+        /** Whether this node is visible and not scissored out */
+        bool visible;
+        /** The node to world transform */
+        Mat4 transform;
+        /** The tint to draw the node with */
+        Color4 tint;
+        /** The bounds of what this node draws, in clip space */
+        Rect bounds;
+        /** The bounds of what this node and its descendants draw, in clip space */
+        Rect reach;
+        /** The region of clip space that this node may draw in */
+        Rect clip;
+    };
+
+    /** The flattened scene graph, in draw order */
+    std::vector<RenderEntry> _flat;
+    /** The offsets of the flattened nodes, sorted by depth */
+    std::vector<int> _order;
+    /** The start of each depth in _order, followed by the end of the last */
+    std::vector<int> _levels;
+    /** Whether nodes were added, removed, or reordered since flattening */
+    bool _flatDirty;
+    /** The scissors to restore as drawing leaves a subtree */
+    std::vector<std::pair<size_t,std::shared_ptr<Scissor>>> _scissors;
+    /** The thread pool to compute node bounds with (or null) */
+    std::shared_ptr<ThreadPool> _cullPool;
+
 #pragma mark -
 #pragma mark Constructors
 public:
@@ -327,7 +376,27 @@ public:
      *
      * @param color  The tint color for this scene.
      */
-    void setColor(Color4 color) { _color = color; }
+    void setColor(Color4 color) { _color = color; _dirty = true; }
+
+    /**
+     * Returns the thread pool that computes node bounds when rendering.
+     *
+     * If this is null, the bounds are computed on the rendering thread.
+     *
+     * @return the thread pool that computes node bounds when rendering.
+     */
+    const std::shared_ptr<ThreadPool>& getThreadPool() const { return _cullPool; }
+
+    /**
+     * Sets the thread pool that computes node bounds when rendering.
+     *
+     * Only depths of the scene graph with many nodes are split across the
+     * pool, as small scenes are faster to process on one thread. If this is
+     * null, the bounds are computed on the rendering thread.
+     *
+     * @param pool  The thread pool that computes node bounds when rendering.
+     */
+    void setThreadPool(const std::shared_ptr<ThreadPool>& pool) { _cullPool = pool; }
     
     /**
      * Returns a string representation of this scene for debugging purposes.
@@ -364,6 +433,7 @@ public:
      */
     void setSize(const Size size) {
         _camera->set(size);
+        _dirty = true;
     }
     
     /**
@@ -376,6 +446,7 @@ public:
      */
     void setSize(float width, float height) {
         _camera->set(width,height);
+        _dirty = true;
     }
     
 
@@ -388,6 +459,7 @@ public:
      */
     void setWidth(float width) {
         _camera->set(width,_camera->getViewport().size.height);
+        _dirty = true;
     }
     
     /**
@@ -400,6 +472,7 @@ public:
 
     void setHeight(float height) {
         _camera->set(_camera->getViewport().size.width,height);
+        _dirty = true;
     }
 
     /**
@@ -422,6 +495,7 @@ public:
      */
     void setBounds(const Rect rect) {
         _camera->set(rect);
+        _dirty = true;
     }
     
     /**
@@ -436,6 +510,7 @@ public:
      */
     void setBounds(const Vec2 origin, const Size size) {
          _camera->set(origin,size);
+        _dirty = true;
     }
     
     /**
@@ -452,6 +527,7 @@ public:
      */
     void setBounds(float x, float y, float width, float height) {
         _camera->set(x,y,width,height);
+        _dirty = true;
     }
     
     /**
@@ -465,6 +541,7 @@ public:
      */
     void setOffset(const Vec2 origin) {
         _camera->set(origin,_camera->getViewport().size);
+        _dirty = true;
     }
     
     /**
@@ -898,6 +975,31 @@ public:
      */
     virtual void setActive(bool value) { _active = value; }
 
+    /**
+     * Returns true if this scene has changed since it was last rendered.
+     *
+     * A scene is dirty whenever one of its nodes changes how it looks, or
+     * a node is added or removed. Rendering the scene clears this value.
+     * An application with nothing dirty to show can skip drawing the frame
+     * altogether, as the last frame is still on the screen.
+     *
+     * A new scene is always dirty.
+     *
+     * @return true if this scene has changed since it was last rendered.
+     */
+    bool isDirty() const { return _dirty; }
+
+    /**
+     * Sets whether this scene has changed since it was last rendered.
+     *
+     * You should never need to set this value to false, as rendering the
+     * scene does that. Set it to true if the scene must be drawn again for
+     * a reason that the scene graph does not know about.
+     *
+     * @param value Whether this scene has changed since it was last rendered.
+     */
+    void setDirty(bool value) { _dirty = value; }
+
     /**
      * The method called to update the scene.
      *
@@ -923,10 +1025,72 @@ public:
      * That means that parents are always draw before (and behind children).
      * To override this draw order, scene nodes do support a z-axis offset.
      *
+     * Rendering the scene clears {@link isDirty()}.
+     *
      * @param batch     The SpriteBatch to draw with.
      */
     virtual void render(const std::shared_ptr<SpriteBatch>& batch);
     
+protected:
+#pragma mark -
+#pragma mark Render Passes
+    /**
+     * Draws all of the children in this scene as seen by the given camera.
+     *
+     * The sprite batch must already be drawing. This flattens the scene graph
+     * if it has changed, computes the bounds of every node, and then draws
+     * the nodes that can be seen.
+     *
+     * @param batch     The SpriteBatch to draw with.
+     * @param camera    The camera matrix the batch is drawing with.
+     */
+    void renderNodes(const std::shared_ptr<SpriteBatch>& batch, const Mat4& camera);
+
+    /**
+     * Rebuilds the flattened scene graph from the children of this scene.
+     */
+    void flatten();
+
+    /**
+     * Adds the given node and its descendants to the flattened scene graph.
+     *
+     * @param node      The node to add
+     * @param parent    The offset of the parent entry (-1 for none)
+     * @param depth     The depth of the node
+     */
+    void flattenNode(scene2::SceneNode* node, int parent, int depth);
+
+    /**
+     * Computes the transforms and bounds of the flattened nodes.
+     *
+     * Transforms are computed from the top depth down, and the bounds of
+     * each subtree from the bottom depth up. Every depth depends only on
+     * the one before it, so the nodes of a depth may be split across the
+     * thread pool.
+     *
+     * @param camera    The camera matrix the batch is drawing with.
+     */
+    void cullNodes(const Mat4& camera);
+
+    /**
+     * Computes the transforms or subtree bounds of part of a depth.
+     *
+     * @param first     The first offset in the depth order
+     * @param last      The offset just past the last one in the depth order
+     * @param down      Whether to compute transforms (or else subtree bounds)
+     * @param camera    The camera matrix the batch is drawing with.
+     */
+    void cullRange(int first, int last, bool down, const Mat4& camera);
+
+    /**
+     * Draws the flattened nodes that can be seen, in order.
+     *
+     * Any subtree that is hidden or has nothing on screen is skipped.
+     *
+     * @param batch     The SpriteBatch to draw with.
+     */
+    void drawNodes(const std::shared_ptr<SpriteBatch>& batch);
+
 private:
 #pragma mark -
 #pragma mark Internal Helpers
@@ -948,6 +1112,14 @@ private:
      * @param value Whether the children of this node needs resorting.
      */
     void setZDirty(bool value) { _zDirty = value; }
+
+    /**
+     * Marks the flattened scene graph as out of date.
+     *
+     * Nodes call this whenever children are added, removed, or reordered
+     * anywhere in the scene graph.
+     */
+    void setFlatDirty() { _flatDirty = true; }
     
     // Tightly couple with Node
     friend class scene2::SceneNode;
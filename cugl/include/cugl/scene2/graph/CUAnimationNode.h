@@ -200,7 +200,7 @@ public:
      */
     static std::shared_ptr<AnimationNode> alloc(const std::shared_ptr<Texture>& texture,
                                                 int rows, int cols) {
-        std::shared_ptr<AnimationNode> node = std::make_shared<AnimationNode>();
+        std::shared_ptr<AnimationNode> node = std::allocate_shared<AnimationNode>(SlabAllocator<AnimationNode>());
         return (node->initWithFilmstrip(texture,rows,cols) ? node : nullptr);
 
     }
@@ -225,7 +225,7 @@ public:
      */
     static std::shared_ptr<AnimationNode> alloc(const std::shared_ptr<Texture>& texture,
                                                 int rows, int cols, int size) {
-        std::shared_ptr<AnimationNode> node = std::make_shared<AnimationNode>();
+        std::shared_ptr<AnimationNode> node = std::allocate_shared<AnimationNode>(SlabAllocator<AnimationNode>());
         return (node->initWithFilmstrip(texture,rows,cols,size) ? node : nullptr);
     }
     
@@ -252,7 +252,7 @@ public:
      */
     static std::shared_ptr<SceneNode> allocWithData(const Scene2Loader* loader,
                                                     const std::shared_ptr<JsonValue>& data) {
-        std::shared_ptr<AnimationNode> result = std::make_shared<AnimationNode>();
+        std::shared_ptr<AnimationNode> result = std::allocate_shared<AnimationNode>(SlabAllocator<AnimationNode>());
         if (!result->initWithData(loader,data)) { result = nullptr; }
         return std::dynamic_pointer_cast<SceneNode>(result);
     }
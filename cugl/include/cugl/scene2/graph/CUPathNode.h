@@ -245,7 +245,7 @@ public:
      * @return an empty path node.
      */
     static std::shared_ptr<PathNode> alloc() {
-        std::shared_ptr<PathNode> node = std::make_shared<PathNode>();
+        std::shared_ptr<PathNode> node = std::allocate_shared<PathNode>(SlabAllocator<PathNode>());
         return (node->init() ? node : nullptr);
     }
     
@@ -270,7 +270,7 @@ public:
                                                        poly2::Joint joint = poly2::Joint::NONE,
                                                        poly2::EndCap cap = poly2::EndCap::NONE,
                                                        bool closed = true) {
-        std::shared_ptr<PathNode> node = std::make_shared<PathNode>();
+        std::shared_ptr<PathNode> node = std::allocate_shared<PathNode>(SlabAllocator<PathNode>());
         return (node->initWithVertices(vertices,stroke,joint,cap,closed) ? node : nullptr);
     }
     
@@ -297,7 +297,7 @@ public:
     static std::shared_ptr<PathNode> allocWithPoly(const Poly2& poly, float stroke,
                                                    poly2::Joint joint = poly2::Joint::NONE,
                                                    poly2::EndCap cap = poly2::EndCap::NONE) {
-        std::shared_ptr<PathNode> node = std::make_shared<PathNode>();
+        std::shared_ptr<PathNode> node = std::allocate_shared<PathNode>(SlabAllocator<PathNode>());
         return (node->initWithPoly(poly,stroke,joint,cap) ? node : nullptr);
     }
     
@@ -319,7 +319,7 @@ public:
     static std::shared_ptr<PathNode> allocWithRect(const Rect rect, float stroke,
                                                    poly2::Joint joint = poly2::Joint::NONE,
                                                    poly2::EndCap cap = poly2::EndCap::NONE) {
-        std::shared_ptr<PathNode> node = std::make_shared<PathNode>();
+        std::shared_ptr<PathNode> node = std::allocate_shared<PathNode>(SlabAllocator<PathNode>());
         return (node->initWithPoly(Poly2(rect,false),stroke,joint,cap) ? node : nullptr);
     }
     
@@ -350,7 +350,7 @@ public:
      */
     static std::shared_ptr<SceneNode> allocWithData(const Scene2Loader* loader,
                                                     const std::shared_ptr<JsonValue>& data) {
-        std::shared_ptr<PathNode> result = std::make_shared<PathNode>();
+        std::shared_ptr<PathNode> result = std::allocate_shared<PathNode>(SlabAllocator<PathNode>());
         if (!result->initWithData(loader,data)) { result = nullptr; }
         return std::dynamic_pointer_cast<SceneNode>(result);
     }
@@ -557,6 +557,16 @@ public:
      * @param tint      The tint to blend with the Node color.
      */
     virtual void draw(const std::shared_ptr<SpriteBatch>& batch, const Mat4& transform, Color4 tint) override;
+
+    /**
+     * Returns the bounds of what {@link draw} draws, in node space.
+     *
+     * When the stroke is positive, this includes the extruded path, which
+     * may extend past the content size.
+     *
+     * @return the bounds of what {@link draw} draws, in node space.
+     */
+    virtual Rect getDrawBounds() const override;
     
 
     
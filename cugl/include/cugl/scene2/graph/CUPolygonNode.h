@@ -127,7 +127,7 @@ public:
      * @return an empty polygon with the degenerate texture.
      */
     static std::shared_ptr<PolygonNode> alloc() {
-        std::shared_ptr<PolygonNode> node = std::make_shared<PolygonNode>();
+        std::shared_ptr<PolygonNode> node = std::allocate_shared<PolygonNode>(SlabAllocator<PolygonNode>());
         return (node->init() ? node : nullptr);
     }
     
@@ -147,7 +147,7 @@ public:
      * @return a solid polygon with the given vertices.
      */
     static std::shared_ptr<PolygonNode> alloc(const std::vector<Vec2>& vertices) {
-        std::shared_ptr<PolygonNode> node = std::make_shared<PolygonNode>();
+        std::shared_ptr<PolygonNode> node = std::allocate_shared<PolygonNode>(SlabAllocator<PolygonNode>());
         return (node->init(vertices) ? node : nullptr);
     }
     
@@ -163,7 +163,7 @@ public:
      * @return a solid polygon given polygon shape.
      */
     static std::shared_ptr<PolygonNode> alloc(const Poly2& poly) {
-        std::shared_ptr<PolygonNode> node = std::make_shared<PolygonNode>();
+        std::shared_ptr<PolygonNode> node = std::allocate_shared<PolygonNode>(SlabAllocator<PolygonNode>());
         return (node->init(poly) ? node : nullptr);
     }
     
@@ -182,7 +182,7 @@ public:
      * @return a solid polygon with the given rect.
      */
     static std::shared_ptr<PolygonNode> alloc(const Rect rect) {
-        std::shared_ptr<PolygonNode> node = std::make_shared<PolygonNode>();
+        std::shared_ptr<PolygonNode> node = std::allocate_shared<PolygonNode>(SlabAllocator<PolygonNode>());
         return (node->init(rect) ? node : nullptr);
     }
     
@@ -197,7 +197,7 @@ public:
      * @return  a textured polygon from the image filename.
      */
     static std::shared_ptr<PolygonNode> allocWithFile(const std::string& filename) {
-        std::shared_ptr<PolygonNode> node = std::make_shared<PolygonNode>();
+        std::shared_ptr<PolygonNode> node = std::allocate_shared<PolygonNode>(SlabAllocator<PolygonNode>());
         return (node->initWithFile(filename) ? node : nullptr);
     }
     
@@ -215,7 +215,7 @@ public:
      */
     static std::shared_ptr<PolygonNode> allocWithFile(const std::string& filename,
                                                       const std::vector<Vec2>& vertices) {
-        std::shared_ptr<PolygonNode> node = std::make_shared<PolygonNode>();
+        std::shared_ptr<PolygonNode> node = std::allocate_shared<PolygonNode>(SlabAllocator<PolygonNode>());
         return (node->initWithFile(filename,vertices) ? node : nullptr);
     }
     
@@ -228,7 +228,7 @@ public:
      * @return a textured polygon from the image filename and the given polygon.
      */
     static std::shared_ptr<PolygonNode> allocWithFile(const std::string& filename, const Poly2& poly) {
-        std::shared_ptr<PolygonNode> node = std::make_shared<PolygonNode>();
+        std::shared_ptr<PolygonNode> node = std::allocate_shared<PolygonNode>(SlabAllocator<PolygonNode>());
         return (node->initWithFile(filename,poly) ? node : nullptr);
     }
     
@@ -244,7 +244,7 @@ public:
      * @return a textured polygon from the image filename and the given rect.
      */
     static std::shared_ptr<PolygonNode> allocWithFile(const std::string& filename, const Rect rect) {
-        std::shared_ptr<PolygonNode> node = std::make_shared<PolygonNode>();
+        std::shared_ptr<PolygonNode> node = std::allocate_shared<PolygonNode>(SlabAllocator<PolygonNode>());
         return (node->initWithFile(filename,rect) ? node : nullptr);
     }
     
@@ -259,7 +259,7 @@ public:
      * @return a textured polygon from a Texture object.
      */
     static std::shared_ptr<PolygonNode> allocWithTexture(const std::shared_ptr<Texture>& texture) {
-        std::shared_ptr<PolygonNode> node = std::make_shared<PolygonNode>();
+        std::shared_ptr<PolygonNode> node = std::allocate_shared<PolygonNode>(SlabAllocator<PolygonNode>());
         return (node->initWithTexture(texture) ? node : nullptr);
     }
     
@@ -277,7 +277,7 @@ public:
      */
     static std::shared_ptr<PolygonNode> allocWithTexture(const std::shared_ptr<Texture>& texture,
                                                          const std::vector<Vec2>& vertices) {
-        std::shared_ptr<PolygonNode> node = std::make_shared<PolygonNode>();
+        std::shared_ptr<PolygonNode> node = std::allocate_shared<PolygonNode>(SlabAllocator<PolygonNode>());
         return (node->initWithTexture(texture,vertices) ? node : nullptr);
     }
     /**
@@ -290,7 +290,7 @@ public:
      */
     static std::shared_ptr<PolygonNode> allocWithTexture(const std::shared_ptr<Texture>& texture,
                                                          const Poly2& poly) {
-        std::shared_ptr<PolygonNode> node = std::make_shared<PolygonNode>();
+        std::shared_ptr<PolygonNode> node = std::allocate_shared<PolygonNode>(SlabAllocator<PolygonNode>());
         return (node->initWithTexture(texture,poly) ? node : nullptr);
     }
     
@@ -307,7 +307,7 @@ public:
      */
     static std::shared_ptr<PolygonNode> allocWithTexture(const std::shared_ptr<Texture>& texture,
                                                          const Rect rect)  {
-        std::shared_ptr<PolygonNode> node = std::make_shared<PolygonNode>();
+        std::shared_ptr<PolygonNode> node = std::allocate_shared<PolygonNode>(SlabAllocator<PolygonNode>());
         return (node->initWithTexture(texture,rect) ? node : nullptr);
     }
 
@@ -334,7 +334,7 @@ public:
      */
     static std::shared_ptr<SceneNode> allocWithData(const Scene2Loader* loader,
                                                     const std::shared_ptr<JsonValue>& data) {
-        std::shared_ptr<PolygonNode> result = std::make_shared<PolygonNode>();
+        std::shared_ptr<PolygonNode> result = std::allocate_shared<PolygonNode>(SlabAllocator<PolygonNode>());
         if (!result->initWithData(loader,data)) { result = nullptr; }
         return std::dynamic_pointer_cast<SceneNode>(result);
     }
@@ -44,6 +44,7 @@
 
 #include <cugl/math/cu_math.h>
 #include <cugl/util/CUDebug.h>
+#include <cugl/util/CUSlabAllocator.h>
 #include <cugl/render/CUSpriteBatch.h>
 #include <cugl/render/CUScissor.h>
 #include <cugl/assets/CUJsonValue.h>
@@ -177,8 +178,17 @@ protected:
      */
     Mat4  _combined;
     
-    /** The array of children nodes */
-    std::vector<std::shared_ptr<SceneNode>> _children;
+    /**
+     * The array of children nodes
+     *
+     * Removing a child leaves a hole (a nullptr) in its place, so that no
+     * other child has to move. The holes are filled by compactChildren(),
+     * which happens lazily before anything looks at the children by position.
+     * The last element is never a hole.
+     */
+    mutable std::vector<std::shared_ptr<SceneNode>> _children;
+    /** The number of holes in the array of children */
+    mutable size_t _holes;
 
     /** A weaker pointer to the parent (or null if root) */
     SceneNode* _parent;
@@ -409,7 +419,7 @@ public:
      * @return a newly allocated node at the world origin.
      */
     static std::shared_ptr<SceneNode> alloc() {
-        std::shared_ptr<SceneNode> result = std::make_shared<SceneNode>();
+        std::shared_ptr<SceneNode> result = std::allocate_shared<SceneNode>(SlabAllocator<SceneNode>());
         return (result->init() ? result : nullptr);
     }
     
@@ -424,7 +434,7 @@ public:
      * @return a newly allocated node at the given position.
      */
     static std::shared_ptr<SceneNode> allocWithPosition(const Vec2 pos) {
-        std::shared_ptr<SceneNode> result = std::make_shared<SceneNode>();
+        std::shared_ptr<SceneNode> result = std::allocate_shared<SceneNode>(SlabAllocator<SceneNode>());
         return (result->initWithPosition(pos) ? result : nullptr);
     }
     
@@ -440,7 +450,7 @@ public:
      * @return a newly allocated node at the given position.
      */
     static std::shared_ptr<SceneNode> allocWithPosition(float x, float y) {
-        std::shared_ptr<SceneNode> result = std::make_shared<SceneNode>();
+        std::shared_ptr<SceneNode> result = std::allocate_shared<SceneNode>(SlabAllocator<SceneNode>());
         return (result->initWithPosition(x,y) ? result : nullptr);
     }
 
@@ -457,7 +467,7 @@ public:
      * @return a newly allocated node with the given size.
      */
     static std::shared_ptr<SceneNode> allocWithBounds(const Size size) {
-        std::shared_ptr<SceneNode> result = std::make_shared<SceneNode>();
+        std::shared_ptr<SceneNode> result = std::allocate_shared<SceneNode>(SlabAllocator<SceneNode>());
         return (result->initWithBounds(size) ? result : nullptr);
     }
     
@@ -475,7 +485,7 @@ public:
      * @return a newly allocated node with the given size.
      */
     static std::shared_ptr<SceneNode> allocWithBounds(float width, float height) {
-        std::shared_ptr<SceneNode> result = std::make_shared<SceneNode>();
+        std::shared_ptr<SceneNode> result = std::allocate_shared<SceneNode>(SlabAllocator<SceneNode>());
         return (result->initWithBounds(width,height) ? result : nullptr);
     }
     
@@ -495,7 +505,7 @@ public:
      * @return a newly allocated node with the given bounds.
      */
     static std::shared_ptr<SceneNode> allocWithBounds(const Rect rect) {
-        std::shared_ptr<SceneNode> result = std::make_shared<SceneNode>();
+        std::shared_ptr<SceneNode> result = std::allocate_shared<SceneNode>(SlabAllocator<SceneNode>());
         return (result->initWithBounds(rect) ? result : nullptr);
     }
     
@@ -518,7 +528,7 @@ public:
      * @return a newly allocated node with the given bounds.
      */
     static std::shared_ptr<SceneNode> allocWithBounds(float x, float y, float width, float height) {
-        std::shared_ptr<SceneNode> result = std::make_shared<SceneNode>();
+        std::shared_ptr<SceneNode> result = std::allocate_shared<SceneNode>(SlabAllocator<SceneNode>());
         return (result->initWithBounds(x,y,width,height) ? result : nullptr);
     }
     
@@ -546,7 +556,7 @@ public:
      */
     static std::shared_ptr<SceneNode> allocWithData(const Scene2Loader* loader,
                                                     const std::shared_ptr<JsonValue>& data) {
-        std::shared_ptr<SceneNode> result = std::make_shared<SceneNode>();
+        std::shared_ptr<SceneNode> result = std::allocate_shared<SceneNode>(SlabAllocator<SceneNode>());
         return (result->initWithData(loader,data) ? result : nullptr);
     }
 
@@ -967,7 +977,7 @@ public:
      *
      * @param color the color tinting this node.
      */
-    virtual void setColor(Color4 color) { _tintColor = color; }
+    virtual void setColor(Color4 color) { _tintColor = color; markDirty(); }
 
     /**
      * Returns the absolute color tinting this node.
@@ -1000,7 +1010,7 @@ public:
      *
      * @param visible   true if the node is visible.
      */
-    void setVisible(bool visible) { _isVisible = visible; }
+    void setVisible(bool visible) { _isVisible = visible; markDirty(); }
     
     /**
      * Returns true if this node is tinted by its parent.
@@ -1022,7 +1032,7 @@ public:
      *
      * @param flag  Whether this node is tinted by its parent.
      */
-    void setRelativeColor(bool flag) { _hasParentColor = flag; }
+    void setRelativeColor(bool flag) { _hasParentColor = flag; markDirty(); }
     
     /**
      * Returns the scissor associated with this node.
@@ -1078,7 +1088,7 @@ public:
      *
      * @param scissor   The scissor associated with this node.
      */
-    void setScissor(const std::shared_ptr<Scissor>& scissor) { _scissor = scissor;}
+    void setScissor(const std::shared_ptr<Scissor>& scissor) { _scissor = scissor; markDirty(); }
 
     /**
      * Sets a content-bounded scissor associated with this node.
@@ -1102,7 +1112,7 @@ public:
      * of the same orientation. The rule for this intersection will
      * be the same as {@link Scissor#intersect}.
      */
-    void setScissor() { _scissor = Scissor::alloc(getContentSize());}
+    void setScissor() { _scissor = Scissor::alloc(getContentSize()); markDirty(); }
 
     
 #pragma mark -
@@ -1515,7 +1525,7 @@ public:
      *
      * @return The number of children of this node.
      */
-    size_t getChildCount() const { return _children.size(); }
+    size_t getChildCount() const { return _children.size()-_holes; }
 
     /**
      * Returns the child at the given position.
@@ -1645,14 +1655,14 @@ public:
      *
      * @return the list of the node's children.
      */
-    std::vector<std::shared_ptr<SceneNode>> getChildren() { return _children; }
+    std::vector<std::shared_ptr<SceneNode>> getChildren() { compactChildren(); return _children; }
 
     /**
      * Returns the list of the node's children.
      *
      * @return the list of the node's children.
      */
-    const std::vector<std::shared_ptr<SceneNode>>& getChildren() const { return _children; }
+    const std::vector<std::shared_ptr<SceneNode>>& getChildren() const { compactChildren(); return _children; }
     
     /**
      * Adds a child to this node.
@@ -1802,12 +1812,23 @@ public:
      */
     const Scene2* getScene() const { return _graph; }
 
+    /**
+     * Marks the scene graph of this node as needing to be drawn again.
+     *
+     * Every method that changes how this node looks calls this method, so
+     * that the scene knows there is something new to draw. Subclasses that
+     * draw something that changes on its own, without calling any of those
+     * methods, must call this method whenever it does. If the node is not
+     * in a scene graph, nothing happens.
+     */
+    void markDirty();
+
     /**
      * Removes this node from its parent node.
      *
      * If the node has no parent, nothing happens.
      */
-    void removeFromParent() { if (_parent) { _parent->removeChild(_childOffset); } }
+    void removeFromParent() { if (_parent) { _parent->eraseChild(_childOffset); } }
     
     /**
      * Removes the child at the given position from this Node.
@@ -1823,7 +1844,8 @@ public:
      * Removes a child from this Node.
      *
      * Removing a child alters the position of every child after it.  Hence
-     * it is unsafe to cache child positions.
+     * it is unsafe to cache child positions. Unlike removing by position, this
+     * takes constant time, as the child only leaves a hole behind.
      *
      * If the child is not in this node, nothing happens.
      *
@@ -1915,6 +1937,18 @@ public:
      * @param tint      The tint to blend with the Node color.
      */
     virtual void draw(const std::shared_ptr<SpriteBatch>& batch, const Mat4& transform, Color4 tint) {}
+
+    /**
+     * Returns the bounds of what {@link draw} draws, in node space.
+     *
+     * A scene skips drawing a node whose bounds are outside of the screen or
+     * its scissor. By default, this is the rectangle with origin (0,0) and
+     * the content size. Nodes that draw outside of that rectangle must
+     * override this method, or they may be skipped while on screen.
+     *
+     * @return the bounds of what {@link draw} draws, in node space.
+     */
+    virtual Rect getDrawBounds() const { return Rect(Vec2::ZERO,_contentSize); }
     
     
 #pragma mark -
@@ -2009,6 +2043,24 @@ private:
      */
     void pushScene(Scene2* scene);
 
+    /**
+     * Removes the child at the given offset, leaving a hole in its place.
+     *
+     * This takes constant time, as no other child is moved. Once holes make
+     * up half of the array, the children are compacted.
+     *
+     * @param offset    The offset of the child in the array of children.
+     */
+    void eraseChild(unsigned int offset);
+
+    /**
+     * Fills the holes left in the array of children by removed children.
+     *
+     * The remaining children keep their order, and their offsets are updated.
+     * This is called before anything accesses the children by position.
+     */
+    void compactChildren() const;
+
     /**
      * Returns true if sibling a is less than b in sorted z-order.
      *
@@ -459,7 +459,7 @@ public:
      * @param srcFactor Specifies how the source blending factors are computed
      * @param dstFactor Specifies how the destination blending factors are computed.
      */
-    void setBlendFunc(GLenum srcFactor, GLenum dstFactor) { _srcFactor = srcFactor; _dstFactor = dstFactor; }
+    void setBlendFunc(GLenum srcFactor, GLenum dstFactor) { _srcFactor = srcFactor; _dstFactor = dstFactor; markDirty(); }
     
     /**
      * Returns the source blending factor
@@ -504,7 +504,7 @@ public:
      *
      * @param equation  Specifies how source and destination colors are combined
      */
-    void setBlendEquation(GLenum equation) { _blendEquation = equation; }
+    void setBlendEquation(GLenum equation) { _blendEquation = equation; markDirty(); }
     
     /**
      * Returns the blending equation for this textured node
@@ -606,6 +606,7 @@ public:
     void setAbsolute(bool flag) {
         _absolute = flag;
         _anchor = Vec2::ANCHOR_BOTTOM_LEFT;
+        markDirty();
     }
     
     /**
@@ -694,6 +695,16 @@ public:
      */
     virtual void draw(const std::shared_ptr<SpriteBatch>& batch,
                       const Mat4& transform, Color4 tint) override = 0;
+
+    /**
+     * Returns the bounds of what {@link draw} draws, in node space.
+     *
+     * This is the polygon scaled to the content size. If the polygon is not
+     * absolute, it is shifted so that its bounding rect starts at the origin.
+     *
+     * @return the bounds of what {@link draw} draws, in node space.
+     */
+    virtual Rect getDrawBounds() const override;
     
     /**
      * Refreshes this node to restore the render data.
@@ -220,7 +220,7 @@ public:
      * @return an empty wireframe node.
      */
     static std::shared_ptr<WireNode> alloc() {
-        std::shared_ptr<WireNode> node = std::make_shared<WireNode>();
+        std::shared_ptr<WireNode> node = std::allocate_shared<WireNode>(SlabAllocator<WireNode>());
         return (node->init() ? node : nullptr);
     }
     
@@ -236,7 +236,7 @@ public:
      * @return a (closed) wireframe with the given vertices.
      */
     static std::shared_ptr<WireNode> alloc(const std::vector<Vec2>& vertices) {
-        std::shared_ptr<WireNode> node = std::make_shared<WireNode>();
+        std::shared_ptr<WireNode> node = std::allocate_shared<WireNode>(SlabAllocator<WireNode>());
         return (node->init(vertices) ? node : nullptr);
     }
     
@@ -252,7 +252,7 @@ public:
      * @return a wireframe with the given polygon.
      */
     static std::shared_ptr<WireNode> alloc(const Poly2& poly) {
-        std::shared_ptr<WireNode> node = std::make_shared<WireNode>();
+        std::shared_ptr<WireNode> node = std::allocate_shared<WireNode>(SlabAllocator<WireNode>());
         node->_traversal = poly2::Traversal::NONE;
         return (node->init(poly) ? node : nullptr);
     }
@@ -285,7 +285,7 @@ public:
      */
     static std::shared_ptr<WireNode> allocWithTraversal(const Poly2& poly,
                                                         poly2::Traversal traversal) {
-        std::shared_ptr<WireNode> node = std::make_shared<WireNode>();
+        std::shared_ptr<WireNode> node = std::allocate_shared<WireNode>(SlabAllocator<WireNode>());
         return (node->initWithTraversal(poly,traversal) ? node : nullptr);
     }
     
@@ -303,7 +303,7 @@ public:
      */
     static std::shared_ptr<WireNode> allocWithTraversal(const std::vector<Vec2>& vertices,
                                                         poly2::Traversal traversal) {
-        std::shared_ptr<WireNode> node = std::make_shared<WireNode>();
+        std::shared_ptr<WireNode> node = std::allocate_shared<WireNode>(SlabAllocator<WireNode>());
         return (node->initWithTraversal(vertices,traversal) ? node : nullptr);
     }
     
@@ -332,7 +332,7 @@ public:
      */
     static std::shared_ptr<SceneNode> allocWithData(const Scene2Loader* loader,
                                                     const std::shared_ptr<JsonValue>& data) {
-        std::shared_ptr<WireNode> result = std::make_shared<WireNode>();
+        std::shared_ptr<WireNode> result = std::allocate_shared<WireNode>(SlabAllocator<WireNode>());
         if (!result->initWithData(loader,data)) { result = nullptr; }
         return std::dynamic_pointer_cast<SceneNode>(result);
     }
@@ -266,7 +266,7 @@ public:
      * @return a newly allocated button with the given up node.
      */
     static std::shared_ptr<Button> alloc(const std::shared_ptr<SceneNode>& up) {
-        std::shared_ptr<Button> node = std::make_shared<Button>();
+        std::shared_ptr<Button> node = std::allocate_shared<Button>(SlabAllocator<Button>());
         return (node->init(up) ? node : nullptr);
     }
 
@@ -282,7 +282,7 @@ public:
      * @return a newly allocated button with the given node and color
      */
     static std::shared_ptr<Button> alloc(const std::shared_ptr<SceneNode>& up, Color4 down) {
-        std::shared_ptr<Button> node = std::make_shared<Button>();
+        std::shared_ptr<Button> node = std::allocate_shared<Button>(SlabAllocator<Button>());
         return (node->init(up,down) ? node : nullptr);
     }
 
@@ -299,7 +299,7 @@ public:
      * @return a newly allocated button with the given nodes
      */
     static std::shared_ptr<Button> alloc(const std::shared_ptr<SceneNode>& up, const std::shared_ptr<SceneNode>& down) {
-        std::shared_ptr<Button> node = std::make_shared<Button>();
+        std::shared_ptr<Button> node = std::allocate_shared<Button>(SlabAllocator<Button>());
         return (node->init(up,down) ? node : nullptr);
     }
 
@@ -326,7 +326,7 @@ public:
      */
     static std::shared_ptr<SceneNode> allocWithData(const Scene2Loader* loader,
                                                     const std::shared_ptr<JsonValue>& data) {
-        std::shared_ptr<Button> result = std::make_shared<Button>();
+        std::shared_ptr<Button> result = std::allocate_shared<Button>(SlabAllocator<Button>());
         if (!result->initWithData(loader,data)) { result = nullptr; }
         return std::dynamic_pointer_cast<SceneNode>(result);
     }
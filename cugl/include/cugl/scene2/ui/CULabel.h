@@ -226,8 +226,27 @@ protected:
 
     /** Whether or not the glyphs have been rendered */
     bool _rendered;
+    /** Whether or not the text bounds have been computed */
+    bool _sized;
     /** The glyph vertices */
     Mesh<SpriteVertex2> _mesh;
+
+    /** Where the glyphs of a character start in the mesh */
+    class GlyphStart {
+    public:
+        /** The number of mesh vertices before this character */
+        Uint32 vertex;
+        /** The number of mesh indices before this character */
+        Uint32 index;
+        /** The pen position before this character (and its kerning) */
+        float pen;
+    };
+    /** The text laid out in the mesh (empty if it cannot be reused) */
+    std::string _meshText;
+    /** The text origin of the mesh */
+    Vec2 _meshOrigin;
+    /** The start of each character of _meshText, plus one for the end */
+    std::vector<GlyphStart> _meshGlyphs;
     /** The font bounds */
     Rect _bounds;
     /** The underlying atlas texture */
@@ -366,7 +385,7 @@ public:
      * @return a newly allocated label with the given size and font atlas
      */
     static std::shared_ptr<Label> alloc(const Size size, const std::shared_ptr<Font>& font) {
-        std::shared_ptr<Label> result = std::make_shared<Label>();
+        std::shared_ptr<Label> result = std::allocate_shared<Label>(SlabAllocator<Label>());
         return (result->init(size,font) ? result : nullptr);
     }
 
@@ -388,7 +407,7 @@ public:
      * @return a newly allocated label with the given text and font atlas
      */
     static std::shared_ptr<Label> alloc(const std::string& text, const std::shared_ptr<Font>& font) {
-        std::shared_ptr<Label> result = std::make_shared<Label>();
+        std::shared_ptr<Label> result = std::allocate_shared<Label>(SlabAllocator<Label>());
         return (result->initWithText(text,font) ? result : nullptr);
     }
     
@@ -413,7 +432,7 @@ public:
      * @return a newly allocated label with the given text and font atlas
      */
     static std::shared_ptr<Label> alloc(const char* text, const std::shared_ptr<Font>& font) {
-        std::shared_ptr<Label> result = std::make_shared<Label>();
+        std::shared_ptr<Label> result = std::allocate_shared<Label>(SlabAllocator<Label>());
         return (result->initWithText(text,font) ? result : nullptr);
     }
 
@@ -444,7 +463,7 @@ public:
      */
     static std::shared_ptr<SceneNode> allocWithData(const Scene2Loader* loader,
                                                     const std::shared_ptr<JsonValue>& data) {
-        std::shared_ptr<Label> result = std::make_shared<Label>();
+        std::shared_ptr<Label> result = std::allocate_shared<Label>(SlabAllocator<Label>());
         if (!result->initWithData(loader,data)) { result = nullptr; }
         return std::dynamic_pointer_cast<SceneNode>(result);
     }
@@ -814,7 +833,7 @@ public:
      * @param srcFactor Specifies how the source blending factors are computed
      * @param dstFactor Specifies how the destination blending factors are computed.
      */
-    void setBlendFunc(GLenum srcFactor, GLenum dstFactor) { _srcFactor = srcFactor; _dstFactor = dstFactor; }
+    void setBlendFunc(GLenum srcFactor, GLenum dstFactor) { _srcFactor = srcFactor; _dstFactor = dstFactor; markDirty(); }
     
     /**
      * Returns the source blending factor
@@ -859,7 +878,7 @@ public:
      *
      * @param equation  Specifies how source and destination colors are combined
      */
-    void setBlendEquation(GLenum equation) { _blendEquation = equation; }
+    void setBlendEquation(GLenum equation) { _blendEquation = equation; markDirty(); }
     
     /**
      * Returns the blending equation for this textured node
@@ -900,6 +919,17 @@ public:
      */
     virtual void draw(const std::shared_ptr<SpriteBatch>& batch, const Mat4& transform, Color4 tint) override;
     
+    /**
+     * Returns the bounds of what {@link draw} draws, in node space.
+     *
+     * This includes the text bounds, as the text may extend past the content
+     * size of this label. Distance field glyphs extend past the text by the
+     * spread of the font.
+     *
+     * @return the bounds of what {@link draw} draws, in node space.
+     */
+    virtual Rect getDrawBounds() const override;
+    
 private:
 #pragma mark -
 #pragma mark Internal Helpers
@@ -917,13 +947,28 @@ private:
 
     /**
      * Allocate the render data necessary to render this node.
+     *
+     * If the font has an atlas and the text is ASCII, the glyphs of the
+     * previous text are kept up to the first character that changed, and
+     * only the rest of the text is laid out again. Hence a score counter
+     * only pays for the digits that actually changed. Text that moves with
+     * its alignment keeps its glyphs too, as they are only shifted.
      */
     void generateRenderData();
     
     /**
-     * Clears the render data, releasing all vertices and indices.
+     * Clears the render data, so that it is regenerated on the next draw.
+     *
+     * The vertices and indices are kept, so that {@link generateRenderData}
+     * can reuse the glyphs that did not change.  Call {@link clearGlyphs}
+     * to release them.
      */
     void clearRenderData();
+
+    /**
+     * Releases all vertices and indices, and the layout of their text.
+     */
+    void clearGlyphs();
     
     /**
      * Updates the color value for any other data that needs it.
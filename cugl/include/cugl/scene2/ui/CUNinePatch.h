@@ -240,7 +240,7 @@ public:
      * @return a simple NinePatch with the degenerate texture.
      */
     static std::shared_ptr<NinePatch> alloc() {
-        std::shared_ptr<NinePatch> node = std::make_shared<NinePatch>();
+        std::shared_ptr<NinePatch> node = std::allocate_shared<NinePatch>(SlabAllocator<NinePatch>());
         return (node->init() ? node : nullptr);
     }
     
@@ -260,7 +260,7 @@ public:
      * @return a newly allocated NinePatch with the given interior from the image filename.
      */
     static std::shared_ptr<NinePatch> allocWithFile(const std::string& filename) {
-        std::shared_ptr<NinePatch> node = std::make_shared<NinePatch>();
+        std::shared_ptr<NinePatch> node = std::allocate_shared<NinePatch>(SlabAllocator<NinePatch>());
         return (node->initWithFile(filename) ? node : nullptr);
     }
     
@@ -280,7 +280,7 @@ public:
      * @return a newly allocated NinePatch with the given interior from the image filename.
      */
     static std::shared_ptr<NinePatch> allocWithFile(const std::string& filename, const Rect interior) {
-        std::shared_ptr<NinePatch> node = std::make_shared<NinePatch>();
+        std::shared_ptr<NinePatch> node = std::allocate_shared<NinePatch>(SlabAllocator<NinePatch>());
         return (node->initWithFile(filename,interior) ? node : nullptr);
     }
     
@@ -296,7 +296,7 @@ public:
      * @return a newly allocated degenerate NinePatch from a Texture object.
      */
     static std::shared_ptr<NinePatch> allocWithTexture(const std::shared_ptr<Texture>& texture) {
-        std::shared_ptr<NinePatch> node = std::make_shared<NinePatch>();
+        std::shared_ptr<NinePatch> node = std::allocate_shared<NinePatch>(SlabAllocator<NinePatch>());
         return (node->initWithTexture(texture) ? node : nullptr);
     }
 
@@ -318,7 +318,7 @@ public:
      */
     static std::shared_ptr<NinePatch> allocWithTexture(const std::shared_ptr<Texture>& texture,
                                                        const Rect interior) {
-        std::shared_ptr<NinePatch> node = std::make_shared<NinePatch>();
+        std::shared_ptr<NinePatch> node = std::allocate_shared<NinePatch>(SlabAllocator<NinePatch>());
         return (node->initWithTexture(texture,interior) ? node : nullptr);
     }
     
@@ -343,7 +343,7 @@ public:
      */
     static std::shared_ptr<SceneNode> allocWithData(const Scene2Loader* loader,
                                                     const std::shared_ptr<JsonValue>& data) {
-        std::shared_ptr<NinePatch> result = std::make_shared<NinePatch>();
+        std::shared_ptr<NinePatch> result = std::allocate_shared<NinePatch>(SlabAllocator<NinePatch>());
         if (!result->initWithData(loader,data)) { result = nullptr; }
         return std::dynamic_pointer_cast<SceneNode>(result);
     }
@@ -453,7 +453,7 @@ public:
      * @param srcFactor Specifies how the source blending factors are computed
      * @param dstFactor Specifies how the destination blending factors are computed.
      */
-    void setBlendFunc(GLenum srcFactor, GLenum dstFactor) { _srcFactor = srcFactor; _dstFactor = dstFactor; }
+    void setBlendFunc(GLenum srcFactor, GLenum dstFactor) { _srcFactor = srcFactor; _dstFactor = dstFactor; markDirty(); }
     
     /**
      * Returns the source blending factor
@@ -498,7 +498,7 @@ public:
      *
      * @param equation  Specifies how source and destination colors are combined
      */
-    void setBlendEquation(GLenum equation) { _blendEquation = equation; }
+    void setBlendEquation(GLenum equation) { _blendEquation = equation; markDirty(); }
     
     /**
      * Returns the blending equation for this textured node
@@ -284,7 +284,7 @@ public:
      * @return a newly allocated texture-less progress bar of the given size.
      */
     static std::shared_ptr<ProgressBar> alloc(const Size size) {
-        std::shared_ptr<ProgressBar> node = std::make_shared<ProgressBar>();
+        std::shared_ptr<ProgressBar> node = std::allocate_shared<ProgressBar>(SlabAllocator<ProgressBar>());
         return (node->init(size) ? node : nullptr);
     }
 
@@ -301,7 +301,7 @@ public:
      * @return a newly allocated progress bar with the given texture.
      */
     static std::shared_ptr<ProgressBar> alloc(const std::shared_ptr<Texture>& background) {
-        std::shared_ptr<ProgressBar> node = std::make_shared<ProgressBar>();
+        std::shared_ptr<ProgressBar> node = std::allocate_shared<ProgressBar>(SlabAllocator<ProgressBar>());
         return (node->init(background) ? node : nullptr);
     }
 
@@ -319,7 +319,7 @@ public:
      * @return a newly allocated progress bar with the given texture and size
      */
     static std::shared_ptr<ProgressBar> alloc(const std::shared_ptr<Texture>& background, const Size size) {
-        std::shared_ptr<ProgressBar> node = std::make_shared<ProgressBar>();
+        std::shared_ptr<ProgressBar> node = std::allocate_shared<ProgressBar>(SlabAllocator<ProgressBar>());
         return (node->init(background,size) ? node : nullptr);
     }
 
@@ -337,7 +337,7 @@ public:
      */
     static std::shared_ptr<ProgressBar> alloc(const std::shared_ptr<Texture>& background,
                                               const std::shared_ptr<Texture>& foreground) {
-        std::shared_ptr<ProgressBar> node = std::make_shared<ProgressBar>();
+        std::shared_ptr<ProgressBar> node = std::allocate_shared<ProgressBar>(SlabAllocator<ProgressBar>());
         return (node->init(background,foreground) ? node : nullptr);
     }
     
@@ -357,7 +357,7 @@ public:
     static std::shared_ptr<ProgressBar> alloc(const std::shared_ptr<Texture>& background,
                                               const std::shared_ptr<Texture>& foreground,
                                               const Size size) {
-        std::shared_ptr<ProgressBar> node = std::make_shared<ProgressBar>();
+        std::shared_ptr<ProgressBar> node = std::allocate_shared<ProgressBar>(SlabAllocator<ProgressBar>());
         return (node->init(background,foreground,size) ? node : nullptr);
     }
 
@@ -379,7 +379,7 @@ public:
                                                       const std::shared_ptr<Texture>& foreground,
                                                       const std::shared_ptr<Texture>& beginCap,
                                                       const std::shared_ptr<Texture>& finalCap) {
-        std::shared_ptr<ProgressBar> node = std::make_shared<ProgressBar>();
+        std::shared_ptr<ProgressBar> node = std::allocate_shared<ProgressBar>(SlabAllocator<ProgressBar>());
         return (node->initWithCaps(background,foreground,beginCap,finalCap) ? node : nullptr);
     }
     
@@ -403,7 +403,7 @@ public:
                                                       const std::shared_ptr<Texture>& beginCap,
                                                       const std::shared_ptr<Texture>& finalCap,
                                                       const Size size) {
-        std::shared_ptr<ProgressBar> node = std::make_shared<ProgressBar>();
+        std::shared_ptr<ProgressBar> node = std::allocate_shared<ProgressBar>(SlabAllocator<ProgressBar>());
         return (node->initWithCaps(background,foreground,beginCap,finalCap,size) ? node : nullptr);
     }
     
@@ -429,7 +429,7 @@ public:
      */
     static std::shared_ptr<SceneNode> allocWithData(const Scene2Loader* loader,
                                                     const std::shared_ptr<JsonValue>& data) {
-        std::shared_ptr<ProgressBar> result = std::make_shared<ProgressBar>();
+        std::shared_ptr<ProgressBar> result = std::allocate_shared<ProgressBar>(SlabAllocator<ProgressBar>());
         if (!result->initWithData(loader,data)) { result = nullptr; }
         return std::dynamic_pointer_cast<SceneNode>(result);
     }
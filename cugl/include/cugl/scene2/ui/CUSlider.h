@@ -280,7 +280,7 @@ public:
      * @return a newly allocated  slider with the default values.
      */
     static std::shared_ptr<Slider> alloc() {
-        std::shared_ptr<Slider> node = std::make_shared<Slider>();
+        std::shared_ptr<Slider> node = std::allocate_shared<Slider>(SlabAllocator<Slider>());
         return (node->init() ? node : nullptr);
     }
 
@@ -303,7 +303,7 @@ public:
      * @return a newly allocated slider with given bounds.
      */
     static std::shared_ptr<Slider> alloc(const Vec2 range, const Rect bounds) {
-        std::shared_ptr<Slider> node = std::make_shared<Slider>();
+        std::shared_ptr<Slider> node = std::allocate_shared<Slider>(SlabAllocator<Slider>());
         return (node->init(range,bounds) ? node : nullptr);
     }
     
@@ -330,7 +330,7 @@ public:
     static std::shared_ptr<Slider> allocWithUI(const Vec2 range, const Rect bounds,
                                                const std::shared_ptr<SceneNode>& path,
                                                const std::shared_ptr<Button>& knob) {
-        std::shared_ptr<Slider> node = std::make_shared<Slider>();
+        std::shared_ptr<Slider> node = std::allocate_shared<Slider>(SlabAllocator<Slider>());
         return (node->initWithUI(range,bounds,path,knob) ? node : nullptr);
     }
     
@@ -359,7 +359,7 @@ public:
      */
     static std::shared_ptr<SceneNode> allocWithData(const Scene2Loader* loader,
                                                     const std::shared_ptr<JsonValue>& data) {
-        std::shared_ptr<Slider> node = std::make_shared<Slider>();
+        std::shared_ptr<Slider> node = std::allocate_shared<Slider>(SlabAllocator<Slider>());
         return (node->initWithData(loader,data) ? node : nullptr);
         return std::dynamic_pointer_cast<SceneNode>(node);
     }
@@ -199,7 +199,7 @@ public:
      * @return a newly allocated text field with the given size and font.
      */
     static std::shared_ptr<TextField> alloc(const Size size, const std::shared_ptr<Font>& font) {
-        std::shared_ptr<TextField> result = std::make_shared<TextField>();
+        std::shared_ptr<TextField> result = std::allocate_shared<TextField>(SlabAllocator<TextField>());
         return (result->Label::init(size,font) ? result : nullptr);
     }
 
@@ -221,7 +221,7 @@ public:
      * @return a newly allocated text field with the given text and font.
      */
     static std::shared_ptr<TextField> alloc(const std::string& text, const std::shared_ptr<Font>& font) {
-        std::shared_ptr<TextField> result = std::make_shared<TextField>();
+        std::shared_ptr<TextField> result = std::allocate_shared<TextField>(SlabAllocator<TextField>());
         return (result->initWithText(text,font) ? result : nullptr);
     }
 
@@ -243,7 +243,7 @@ public:
      * @return a newly allocated text field with the given text and font.
      */
     static std::shared_ptr<TextField> alloc(const char* text, const std::shared_ptr<Font>& font) {
-        std::shared_ptr<TextField> result = std::make_shared<TextField>();
+        std::shared_ptr<TextField> result = std::allocate_shared<TextField>(SlabAllocator<TextField>());
         return (result->initWithText(text,font) ? result : nullptr);
     }
     
@@ -274,7 +274,7 @@ public:
      */
     static std::shared_ptr<SceneNode> allocWithData(const Scene2Loader* loader,
                                                     const std::shared_ptr<JsonValue> data) {
-        std::shared_ptr<TextField> node = std::make_shared<TextField>();
+        std::shared_ptr<TextField> node = std::allocate_shared<TextField>(SlabAllocator<TextField>());
         if (!node->initWithData(loader,data)) { node = nullptr; }
         return std::dynamic_pointer_cast<SceneNode>(node);
     }
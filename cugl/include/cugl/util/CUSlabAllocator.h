@@ -0,0 +1,236 @@
+//
+//  CUSlabAllocator.h
+//  Cornell University Game Library (CUGL)
+//
+//  This header provides an allocator that carves objects of the same size out
+//  of large slabs of memory.  Scene graphs create and destroy a lot of small
+//  nodes, and giving each one its own heap allocation scatters them across
+//  memory.  A slab allocator keeps nodes of the same type next to each other,
+//  and recycles the memory of deleted nodes without going back to the heap.
+//
+//  Unlike FreeList, this is a standard allocator.  Hence it can be given to
+//  std::allocate_shared, so that the object and its reference count share a
+//  single slot of the slab.
+//
+//  This is not a class. It is a class template. Templates do not have cpp
+//  files. They only have a header file.  When you include the header, it
+//  compiles the specific template used by your program. Hence all of the code
+//  for this templated class is in this header.
+//
+//  CUGL MIT License:
+//      This software is provided 'as-is', without any express or implied
+//      warranty.  In no event will the authors be held liable for any damages
+//      arising from the use of this software.
+//
+//      Permission is granted to anyone to use this software for any purpose,
+//      including commercial applications, and to alter it and redistribute it
+//      freely, subject to the following restrictions:
+//
+//      1. The origin of this software must not be misrepresented; you must not
+//      claim that you wrote the original software. If you use this software
+//      in a product, an acknowledgment in the product documentation would be
+//      appreciated but is not required.
+//
+//      2. Altered source versions must be plainly marked as such, and must not
+//      be misrepresented as being the original software.
+//
+//      3. This notice may not be removed or altered from any source distribution.
+//
+//  Author: Dragonglass Studios
+//  Version: 10/18/26
+//
+#ifndef __CU_SLAB_ALLOCATOR_H__
+#define __CU_SLAB_ALLOCATOR_H__
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <vector>
+
+/** The number of objects in each slab */
+#define CU_SLAB_COUNT 64
+
+namespace cugl {
+
+#pragma mark -
+#pragma mark SlabPool
+
+/**
+ * A pool of fixed size slots, allocated a slab at a time.
+ *
+ * Each slab holds {@link CU_SLAB_COUNT} slots. Free slots are linked through
+ * their own memory, so freeing and reusing a slot never touches the heap.
+ * Slabs are only allocated when every slot is in use, and they are never
+ * returned to the heap.
+ *
+ * There is one pool for each combination of size and alignment, which is
+ * accessed with {@link get()}. The pools are never deleted, so that objects
+ * freed during static destruction still have a pool to go back to. A pool
+ * is safe to use from any thread.
+ */
+class SlabPool {
+private:
+    /** A free slot, linked to the next free slot */
+    struct Slot {
+        Slot* next;
+    };
+
+    /** The mutex guarding this pool */
+    std::mutex _mutex;
+    /** The first free slot (or null if there are none) */
+    Slot* _free;
+    /** The size of each slot, which is a multiple of the alignment */
+    size_t _size;
+    /** The alignment of each slot */
+    size_t _align;
+    /** The allocated slabs, kept so that a leak checker can find them */
+    std::vector<void*> _slabs;
+
+    /**
+     * Creates a pool of slots with the given size and alignment.
+     *
+     * The pool does not allocate a slab until the first slot is requested.
+     *
+     * @param size  The size of each slot
+     * @param align The alignment of each slot
+     */
+    SlabPool(size_t size, size_t align) : _free(nullptr) {
+        _align = align < alignof(Slot) ? alignof(Slot) : align;
+        _size  = size < sizeof(Slot) ? sizeof(Slot) : size;
+        _size  = (_size+_align-1) & ~(_align-1);
+    }
+
+    /**
+     * Allocates a new slab, and adds all of its slots to the free list.
+     *
+     * This method must be called while holding the mutex.
+     */
+    void grow() {
+        char* slab = (char*)::operator new(_size*CU_SLAB_COUNT+_align);
+        _slabs.push_back(slab);
+        uintptr_t start = ((uintptr_t)slab+_align-1) & ~(uintptr_t)(_align-1);
+        for(int ii = CU_SLAB_COUNT-1; ii >= 0; ii--) {
+            Slot* slot = (Slot*)(start+ii*_size);
+            slot->next = _free;
+            _free = slot;
+        }
+    }
+
+public:
+    /**
+     * Returns the pool for slots of the given size and alignment.
+     *
+     * @return the pool for slots of the given size and alignment.
+     */
+    template <size_t S, size_t A>
+    static SlabPool* get() {
+        static SlabPool* pool = new SlabPool(S,A);
+        return pool;
+    }
+
+    /**
+     * Returns a free slot from this pool.
+     *
+     * If there are no free slots, this allocates a new slab.
+     *
+     * @return a free slot from this pool.
+     */
+    void* malloc() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_free == nullptr) {
+            grow();
+        }
+        Slot* slot = _free;
+        _free = slot->next;
+        return slot;
+    }
+
+    /**
+     * Returns a slot to this pool.
+     *
+     * The slot must have come from {@link malloc()} on this pool.
+     *
+     * @param ptr   The slot to free
+     */
+    void free(void* ptr) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        Slot* slot = (Slot*)ptr;
+        slot->next = _free;
+        _free = slot;
+    }
+};
+
+#pragma mark -
+#pragma mark SlabAllocator Template
+
+/**
+ * Template for a standard allocator backed by slab pools.
+ *
+ * Single objects are allocated from the {@link SlabPool} for their type.
+ * Arrays of objects are allocated from the heap, as they do not fit a slot.
+ * The allocator itself has no state, so all copies are interchangeable.
+ *
+ * The main use of this allocator is to allocate shared objects, such as
+ *
+ *     std::allocate_shared<T>(SlabAllocator<T>())
+ *
+ * Which puts the object and its reference count in one slot of a slab.
+ */
+template <class T>
+class SlabAllocator {
+public:
+    /** The type of the allocated objects */
+    typedef T value_type;
+
+    /**
+     * Creates a slab allocator.
+     */
+    SlabAllocator() {}
+
+    /**
+     * Creates a slab allocator from one for another type.
+     */
+    template <class U>
+    SlabAllocator(const SlabAllocator<U>& other) {}
+
+    /**
+     * Returns memory for n objects of type T.
+     *
+     * @param n The number of objects
+     *
+     * @return memory for n objects of type T.
+     */
+    T* allocate(size_t n) {
+        if (n == 1) {
+            return (T*)SlabPool::get<sizeof(T),alignof(T)>()->malloc();
+        }
+        return (T*)::operator new(n*sizeof(T));
+    }
+
+    /**
+     * Frees memory for n objects of type T.
+     *
+     * The memory must have come from {@link allocate()} with the same n.
+     *
+     * @param ptr   The memory to free
+     * @param n     The number of objects
+     */
+    void deallocate(T* ptr, size_t n) {
+        if (n == 1) {
+            SlabPool::get<sizeof(T),alignof(T)>()->free(ptr);
+        } else {
+            ::operator delete(ptr);
+        }
+    }
+
+    /** Returns true, as all slab allocators are interchangeable */
+    template <class U>
+    bool operator==(const SlabAllocator<U>& other) const { return true; }
+
+    /** Returns false, as all slab allocators are interchangeable */
+    template <class U>
+    bool operator!=(const SlabAllocator<U>& other) const { return false; }
+};
+
+}
+#endif /* __CU_SLAB_ALLOCATOR_H__ */
@@ -10,6 +10,11 @@
 //  the code for asynchronous asset loading. We generalized that class added
 //  some notable safety changes.
 //
+//  Tasks are scheduled by work stealing. Each worker has its own deques of
+//  tasks (one per priority), which other workers steal from when they run
+//  out. Tasks are stored inline in pooled task objects, so adding a small
+//  task does not allocate.
+//
 //  CUGL MIT License:
 //      This software is provided 'as-is', without any express or implied
 //      warranty.  In no event will the authors be held liable for any damages
@@ -36,10 +41,15 @@
 #define __CU_THREAD_POOL_H__
 #include <cugl/base/CUBase.h>
 #include <SDL/SDL.h>
+#include <atomic>
 #include <condition_variable>
+#include <cstddef>
+#include <deque>
 #include <functional>
+#include <new>
 #include <stdio.h>
-#include <queue>
+#include <type_traits>
+#include <utility>
 #include <vector>
 #include <thread>
 
@@ -48,6 +58,13 @@
     #define CU_SDL_THREADS 1
 #endif
 
+/** The number of bytes a task may capture before it is put on the heap */
+#define CU_TASK_STORAGE     48
+/** The number of tasks each worker deque can hold (a power of two) */
+#define CU_TASK_DEQUE       1024
+/** The number of pooled task objects per worker */
+#define CU_TASK_POOL        256
+
 namespace cugl {
 
 #pragma mark -
@@ -56,9 +73,18 @@ namespace cugl {
 /**
  *  Class to providing a collection of worker threads.
  *
- *  This is a general purpose class for performing tasks asynchronously.  There 
- *  is no notification process for when a task is complete.  Instead, your task 
- *  should either set a flag, or execute a callback when it is done.
+ *  This is a general purpose class for performing tasks asynchronously. By
+ *  default, there is no notification process for when a task is complete.
+ *  Your task should either set a flag, or execute a callback when it is done.
+ *  Alternatively, tasks may be added with a {@link Counter}, which can be
+ *  waited on for the whole batch. A task may add more tasks to the same
+ *  counter, so waiting on a counter also waits on all of their children.
+ *
+ *  Each worker thread has its own deques of tasks. Tasks added by a worker go
+ *  on its own deque, and tasks added by any other thread go on a shared
+ *  queue. A worker without tasks of its own takes from the shared queue, or
+ *  steals from the other workers. There are two priorities. Frame tasks are
+ *  always taken before loading tasks.
  *
  *  There are some important safety considerations for using this class over
  *  direct thread objects. For example, stopping a thread pool does not shut it 
@@ -66,7 +92,7 @@ namespace cugl {
  *  it is not safe to delete a thread pool until it is completely shutdown.
  *
  *  More importantly, we do not allow for detached threads. This makes no sense
- *  in this application, because the threads share a resource (_taskQueue) with 
+ *  in this application, because the threads share a resource (the tasks) with
  *  the main thread that will be deleted.  It is therefore unsafe for the 
  *  threads to ever detach.
  *
@@ -74,46 +100,266 @@ namespace cugl {
  *  pool.
  */
 class ThreadPool {
+public:
+    /**
+     * The priority of a task.
+     *
+     * A worker only takes a loading task if it can find no frame tasks.
+     */
+    enum class Priority : int {
+        /** Work that the current animation frame is waiting for */
+        FRAME = 0,
+        /** Work that may take several frames, like loading assets */
+        LOADING = 1
+    };
+    
+    /**
+     * A class counting the unfinished tasks of a batch.
+     *
+     * A counter must outlive the tasks added with it.
+     */
+    class Counter {
+    private:
+        /** The number of tasks added and not finished */
+        std::atomic<int> _count;
+        
+        friend class ThreadPool;
+        
+    public:
+        /**
+         * Creates a counter with no tasks.
+         */
+        Counter() : _count(0) {}
+        
+        /**
+         * Returns true if all of the tasks of this counter are finished.
+         *
+         * @return true if all of the tasks of this counter are finished.
+         */
+        bool isDone() const { return _count.load(std::memory_order_acquire) == 0; }
+    };
+    
 private:
+    /**
+     * A class storing a task waiting to be run.
+     *
+     * The task function is constructed in place in the storage. Functions too
+     * big for the storage are put on the heap instead.
+     */
+    class Task {
+    public:
+        /** The task function */
+        alignas(std::max_align_t) unsigned char storage[CU_TASK_STORAGE];
+        /** Calls the task function in the storage */
+        void (*invoke)(void*);
+        /** Destroys the task function in the storage */
+        void (*destroy)(void*);
+        /** The counter of the task, or nullptr */
+        Counter* counter;
+        /** The next free task in the pool */
+        std::atomic<Uint32> next;
+        /** The index of this task in the pool, or -1 if not pooled */
+        Uint32 index;
+    };
+    
+    /**
+     * A class wrapping a task function that is too big for a task.
+     */
+    template<typename F>
+    class Boxed {
+    public:
+        /** The task function on the heap */
+        F* func;
+        
+        /** Creates a box for the given function */
+        explicit Boxed(F* func) : func(func) {}
+        
+        /** Deletes the boxed function */
+        ~Boxed() { delete func; }
+        
+        /** Calls the boxed function */
+        void operator()() { (*func)(); }
+    };
+    
+    /**
+     * A class implementing a Chase-Lev work stealing deque.
+     *
+     * Only the owning worker may push and pop, at the bottom. Any thread may
+     * steal, at the top. The deque has a fixed capacity.
+     */
+    class Deque {
+    private:
+        /** The index of the oldest task */
+        std::atomic<Sint64> _top;
+        /** The index after the newest task */
+        std::atomic<Sint64> _bottom;
+        /** The tasks, indexed modulo the capacity */
+        std::atomic<Task*> _items[CU_TASK_DEQUE];
+        
+    public:
+        /** Creates an empty deque */
+        Deque() : _top(0), _bottom(0) {}
+        
+        /**
+         * Pushes a task at the bottom. Only the owner may call this.
+         *
+         * @param task  The task to push
+         *
+         * @return false if the deque is full
+         */
+        bool push(Task* task);
+        
+        /**
+         * Pops the newest task. Only the owner may call this.
+         *
+         * @return the task, or nullptr if there is none
+         */
+        Task* pop();
+        
+        /**
+         * Steals the oldest task. Any thread may call this.
+         *
+         * @return the task, or nullptr if there is none or the steal lost a race
+         */
+        Task* steal();
+    };
+    
+    /**
+     * A class storing the state of one worker thread.
+     */
+    class Worker {
+    public:
+        /** The thread pool of this worker */
+        ThreadPool* pool;
+        /** The index of this worker in the pool */
+        Uint32 index;
+        /** The tasks added by this worker, one deque per priority */
+        Deque deques[2];
+    };
+    
     /** The individual worker threads for this thread pool */
 #ifdef CU_SDL_THREADS
     std::vector<SDL_Thread*> _workers;
 #else
     std::vector<std::thread> _workers;
 #endif
-    
-    /** Tasks waiting to be assigned to a thread */
-    std::queue< std::function<void()> > _taskQueue;
-    
-    /** A mutex lock for the task queue */
+    /** The state of each worker thread */
+    std::vector<Worker*> _states;
+    /** Tasks added by threads outside of the pool, one queue per priority */
+    std::deque<Task*> _shared[2];
+    /** A mutex lock for the shared queues and sleeping workers */
     std::mutex _queueMutex;
-    /** A condition variable to manage tasks waiting for a worker */
+    /** A condition variable to manage workers waiting for a task */
     std::condition_variable _taskCondition;
-    
+    /** The number of tasks not yet taken by a thread */
+    std::atomic<int> _pending;
+    /** The number of workers waiting for a task */
+    std::atomic<int> _sleeping;
+    /** The pooled task objects */
+    Task* _tasks;
+    /** The number of pooled task objects */
+    Uint32 _capacity;
+    /** The first free pooled task (low bits) and a tag against ABA (high bits) */
+    std::atomic<Uint64> _free;
     /** Whether or not the thread pool has been marked for shutdown */
-    bool _stop;
+    std::atomic<bool> _stop;
     /** The number of child threads that are completed */
-    int _complete;
+    std::atomic<int> _complete;
     
     /**
      * The body function of a single thread.
      *
-     * This function pulls tasks from the task queue.  
+     * This function runs tasks until the pool is stopped.
      *
-     * This implementation is safe to use with std::thread.
+     * @param worker    The state of the thread
      */
-    void threadFunc();
-
+    void run(Worker* worker);
+    
     /**
      * The body function of a single thread.
      *
-     * This function pulls tasks from the task queue.
+     * This function runs tasks until the pool is stopped.
      *
      * This static implementation uses the SDL thread API.  It should be used
      * on Android and Windows, which have special thread requirements.
      */
     static int sdlThreadFunc(void* ptr);
     
+    /**
+     * Returns the worker state of the calling thread in this pool.
+     *
+     * @return the worker state, or nullptr if the caller is not a worker
+     */
+    Worker* current() const;
+    
+    /**
+     * Returns a task object, from the pool if one is free.
+     *
+     * @return a task object
+     */
+    Task* acquire();
+    
+    /**
+     * Returns a task object after its task has been run.
+     *
+     * @param task  The task object
+     */
+    void release(Task* task);
+    
+    /**
+     * Schedules a task with the given priority.
+     *
+     * @param task      The task to schedule
+     * @param priority  The task priority
+     */
+    void schedule(Task* task, Priority priority);
+    
+    /**
+     * Finds a task of the given priority for the given worker.
+     *
+     * The worker tries its own deque first, then the shared queue, and then
+     * steals from the other workers.
+     *
+     * @param worker    The worker, or nullptr if the caller is not a worker
+     * @param priority  The task priority
+     *
+     * @return the task, or nullptr if there is none
+     */
+    Task* find(Worker* worker, Priority priority);
+    
+    /**
+     * Runs a task and releases it.
+     *
+     * @param task  The task to run
+     */
+    void execute(Task* task);
+    
+    /**
+     * Adds a task function with the given counter and priority.
+     *
+     * @param task      The task function
+     * @param counter   The counter of the task, or nullptr
+     * @param priority  The task priority
+     */
+    template<typename F>
+    void push(F&& task, Counter* counter, Priority priority) {
+        typedef typename std::decay<F>::type Func;
+        Task* next = acquire();
+        if constexpr (sizeof(Func) <= CU_TASK_STORAGE && alignof(Func) <= alignof(std::max_align_t)) {
+            new (next->storage) Func(std::forward<F>(task));
+            next->invoke  = [](void* data) { (*(Func*)data)(); };
+            next->destroy = [](void* data) { ((Func*)data)->~Func(); };
+        } else {
+            new (next->storage) Boxed<Func>(new Func(std::forward<F>(task)));
+            next->invoke  = [](void* data) { (*(Boxed<Func>*)data)(); };
+            next->destroy = [](void* data) { ((Boxed<Func>*)data)->~Boxed<Func>(); };
+        }
+        next->counter = counter;
+        if (counter != nullptr) {
+            counter->_count.fetch_add(1, std::memory_order_relaxed);
+        }
+        schedule(next, priority);
+    }
 
 #pragma mark Constructors
 public:
@@ -125,7 +371,8 @@ public:
      * NEVER USE A CONSTRUCTOR WITH NEW. If you want to allocate a thread pool 
      * on the heap, use one of the static constructors instead.
      */
-    ThreadPool() :_stop(false), _complete(0) { }
+    ThreadPool() : _pending(0), _sleeping(0), _tasks(nullptr), _capacity(0),
+    _free(0), _stop(false), _complete(0) { }
     
     /**
      * Deletes this thread pool, destroying all resources.
@@ -144,6 +391,8 @@ public:
      * idea to destroy the thread pool if the pool is not yet shut down. The 
      * task queue is shared by the child threads, so we cannot delete it until 
      * all the threads complete.  This destructor will block unti showndown.
+     *
+     * Tasks that have not started are destroyed without being run.
      */
     void dispose();
     
@@ -159,7 +408,6 @@ public:
      * @return true if the threed pool is initialized properly, false otherwise.
      */
     virtual bool init(int threads = 4);
-
     
 #pragma mark Static Constructors
     /**
@@ -178,7 +426,6 @@ public:
         return (result->init(threads) ? result : nullptr);
     }
     
-    
 #pragma mark Task Management
     /**
      * Adds a task to the thread pool.
@@ -188,9 +435,43 @@ public:
      * will not be executed immediately, but must wait for the first available 
      * worker.
      *
+     * A task that captures no more than CU_TASK_STORAGE bytes is stored
+     * without allocating memory.
+     *
      * @param  task     the task function to add to the thread pool
+     * @param  priority the task priority
      */
-    void addTask(const std::function<void()> &task);
+    template<typename F>
+    void addTask(F&& task, Priority priority = Priority::FRAME) {
+        push(std::forward<F>(task), nullptr, priority);
+    }
+    
+    /**
+     * Adds a task to the thread pool as part of a batch.
+     *
+     * The counter is incremented now, and decremented when the task is done.
+     * Use {@link wait} or {@link Counter#isDone} to find out when every task
+     * of the batch is done. The counter must outlive the task.
+     *
+     * @param  task     the task function to add to the thread pool
+     * @param  counter  the counter of the batch
+     * @param  priority the task priority
+     */
+    template<typename F>
+    void addTask(F&& task, Counter& counter, Priority priority = Priority::FRAME) {
+        push(std::forward<F>(task), &counter, priority);
+    }
+    
+    /**
+     * Waits until every task of the given counter is done.
+     *
+     * The calling thread runs tasks itself while it waits, so it is safe
+     * for a task to wait on the tasks that it added. Threads outside of the
+     * pool only run frame tasks, so that they are never held up by loading.
+     *
+     * @param  counter  the counter of the batch
+     */
+    void wait(const Counter& counter);
     
     /**
      * Stop the thread pool, marking it for shut down.
@@ -219,8 +500,8 @@ public:
      *
      * @return whether the thread pool has been shut down.
      */
-    bool isShutdown() const { return _workers.size() == _complete; }
-  
+    bool isShutdown() const { return _workers.size() == (size_t)_complete.load(); }
+
 private:  
     /** Copying is only allowed via shared pointer. */
     CU_DISALLOW_COPY_AND_ASSIGN(ThreadPool);
@@ -35,6 +35,7 @@
 #include "CUFiletools.h"
 #include "CUFreeList.h"
 #include "CUGreedyFreeList.h"
+#include "CUSlabAllocator.h"
 #include "CUThreadPool.h"
 
 #endif /* __CU_UTIL_PKG_H__ */
@@ -77,6 +77,7 @@ bool AssetManager::init() {
  */
 void AssetManager::dispose() {
     detachAll();
+    _categories.clear();
     _workers = nullptr;
 }
 
@@ -223,7 +224,7 @@ void AssetManager::sync() {
     _workers->addTask([=](void) {
         this->block();
         this->block(); // Two blocks force one complete cycle
-    });
+    }, ThreadPool::Priority::LOADING);
 }
 
 /**
@@ -300,6 +301,8 @@ bool AssetManager::loadDirectory(const std::shared_ptr<JsonValue>& json) {
 			success = readCategory(typeid(WidgetValue).hash_code(), child) && success;
         } else if (child->key() == "scene2s") {
             success = readCategory(typeid(scene2::SceneNode).hash_code(),child) && success;
+        } else if (_categories.find(child->key()) != _categories.end()) {
+            success = readCategory(_categories[child->key()],child) && success;
         } else {
             CULogError("Unknown asset category '%s'",child->key().c_str());
             success = false;
@@ -389,6 +392,8 @@ void AssetManager::loadDirectoryAsync(const std::shared_ptr<JsonValue>& json, Lo
             readCategory(typeid(JsonValue).hash_code(),child,callback);
         } else if (child->key() == "widgets") {
             readCategory(typeid(WidgetValue).hash_code(),child,callback);
+        } else if (_categories.find(child->key()) != _categories.end()) {
+            readCategory(_categories[child->key()],child,callback);
         } else if (child->key() != "scene2s") {
             CULogError("Unknown asset category '%s'",child->key().c_str());
         }
@@ -447,7 +452,7 @@ void AssetManager::loadDirectoryAsync(const std::string& directory, LoaderCallba
         std::shared_ptr<JsonValue> json = reader->readJson();
         loadDirectoryAsync(json,callback);
         _preload = false;
-    });
+    }, ThreadPool::Priority::LOADING);
 }
 
 /**
@@ -476,6 +481,8 @@ bool AssetManager::unloadDirectory(const std::shared_ptr<JsonValue>& json) {
             success = purgeCategory(typeid(WidgetValue).hash_code(),child) && success;
         } else if (child->key() == "scene2s") {
             success = purgeCategory(typeid(scene2::SceneNode).hash_code(),child) && success;
+        } else if (_categories.find(child->key()) != _categories.end()) {
+            success = purgeCategory(_categories[child->key()],child) && success;
         } else {
             CULogError("Unknown asset category '%s'",child->key().c_str());
             success = false;
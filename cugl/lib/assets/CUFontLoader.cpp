@@ -55,6 +55,8 @@ using namespace cugl;
 #define UNKNOWN_CHARS   ""
 /** The default character set (ASCII) */
 #define UNKNOWN_SIZE    12
+/** The default distance field spread (a bitmap atlas) */
+#define UNKNOWN_SPREAD  0
 
 #pragma mark -
 #pragma mark Constructor
@@ -67,7 +69,8 @@ using namespace cugl;
  */
 FontLoader::FontLoader() : Loader<Font>(),
 _fontsize(UNKNOWN_SIZE),
-_charset(UNKNOWN_CHARS) {
+_charset(UNKNOWN_CHARS),
+_spread(UNKNOWN_SPREAD) {
 }
 
 
@@ -84,10 +87,12 @@ _charset(UNKNOWN_CHARS) {
  * @param source    The pathname to the asset
  * @param charset   The atlas character set
  * @param charset   The font size
+ * @param spread    The distance field spread of the atlas (0 for a bitmap)
  *
  * @return the font asset with no generated atlas
  */
-std::shared_ptr<Font> FontLoader::preload(const std::string& source, const std::string& charset, int size) {
+std::shared_ptr<Font> FontLoader::preload(const std::string& source, const std::string& charset,
+                                          int size, Uint32 spread) {
     // Make sure we reference the asset directory
 #if defined (__WINDOWS__)
     bool absolute = (bool)strstr(source.c_str(),":") || source[0] == '\\';
@@ -103,6 +108,8 @@ std::shared_ptr<Font> FontLoader::preload(const std::string& source, const std::
         return result;
     }
     
+    // The distance field is computed here too, off the main thread
+    result->setDistanceSpread(spread);
     if (charset.empty()) {
         result->buildAtlasAsync();
     } else {
@@ -172,7 +179,7 @@ bool FontLoader::read(const std::string& key, const std::string& source, int siz
     
     bool success = false;
     if (_loader == nullptr || !async) {
-        std::shared_ptr<Font> font = preload(source,_charset,size);
+        std::shared_ptr<Font> font = preload(source,_charset,size,_spread);
         if (font != nullptr) {
             success = true;
             materialize(key,font,callback);
@@ -181,12 +188,12 @@ bool FontLoader::read(const std::string& key, const std::string& source, int siz
         }
     } else {
         _loader->addTask([=](void) {
-            std::shared_ptr<Font> font = this->preload(source,_charset,size);
+            std::shared_ptr<Font> font = this->preload(source,_charset,size,_spread);
             Application::get()->schedule([=](void){
                 this->materialize(key,font,callback);
                 return false;
             });
-        });
+        }, ThreadPool::Priority::LOADING);
     }
     
     return success;
@@ -209,6 +216,7 @@ bool FontLoader::read(const std::string& key, const std::string& source, int siz
  *      "file":         The path to the asset
  *      "size":         This font size (int)
  *      "charset":      The set of characters for the font atlas (string)
+ *      "spread":       The distance field spread of the atlas (int, 0 for a bitmap)
  *
  * @param json      The directory entry for the asset
  * @param callback  An optional callback for asynchronous loading
@@ -226,10 +234,11 @@ bool FontLoader::read(const std::shared_ptr<JsonValue>& json, LoaderCallback cal
     std::string source  = json->getString("file",UNKNOWN_SOURCE);
     std::string charset = json->getString("charset",UNKNOWN_CHARS);
     int size = json->getInt("size",UNKNOWN_SIZE);
+    Uint32 spread = (Uint32)json->getInt("spread",UNKNOWN_SPREAD);
     
     bool success = false;
     if (_loader == nullptr || !async) {
-        std::shared_ptr<Font> font = preload(source,charset,size);
+        std::shared_ptr<Font> font = preload(source,charset,size,spread);
         if (font != nullptr) {
             success = true;
             materialize(key,font,callback);
@@ -238,12 +247,12 @@ bool FontLoader::read(const std::shared_ptr<JsonValue>& json, LoaderCallback cal
         }
     } else {
         _loader->addTask([=](void) {
-            std::shared_ptr<Font> font = this->preload(source,charset,size);
+            std::shared_ptr<Font> font = this->preload(source,charset,size,spread);
             Application::get()->schedule([=](void){
                 this->materialize(key,font,callback);
                 return false;
             });
-        });
+        }, ThreadPool::Priority::LOADING);
     }
     
     return success;
@@ -116,7 +116,7 @@ bool JsonLoader::read(const std::string& key, const std::string& source, LoaderC
                 this->materialize(key,json,callback);
                 return false;
             });
-        });
+        }, ThreadPool::Priority::LOADING);
     }
     
     return success;
@@ -167,7 +167,7 @@ bool JsonLoader::read(const std::shared_ptr<JsonValue>& json, LoaderCallback cal
                 this->materialize(key,json,callback);
                 return false;
             });
-        });
+        }, ThreadPool::Priority::LOADING);
     }
     
     return success;
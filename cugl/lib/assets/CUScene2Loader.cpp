@@ -409,7 +409,7 @@ bool Scene2Loader::read(const std::string& key, const std::string& source,
                 this->materialize(node,callback);
                 return false;
             });
-        });
+        }, ThreadPool::Priority::LOADING);
     }
     
     return success;
@@ -473,7 +473,7 @@ bool Scene2Loader::read(const std::shared_ptr<JsonValue>& json, LoaderCallback c
                 this->materialize(node,callback);
                 return false;
             });
-        });
+        }, ThreadPool::Priority::LOADING);
     }
     
     return success;
@@ -48,6 +48,7 @@
 #include <cugl/audio/CUSound.h>
 #include <cugl/audio/CUAudioSample.h>
 #include <cugl/audio/CUAudioWaveform.h>
+#include <cugl/audio/CUSoundBank.h>
 #include <cugl/util/CUStrings.h>
 
 using namespace cugl;
@@ -75,6 +76,38 @@ _volume(UNKNOWN_VOLUME) {
 
 #pragma mark -
 #pragma mark Asset Loading
+/**
+ * Returns a sound for a clip in a sound bank.
+ *
+ * The bank is opened the first time any of its clips is loaded, and is
+ * shared by every later clip from the same file.  This method is safe
+ * to call from the loader thread.
+ *
+ * @param json      The directory entry for the asset
+ *
+ * @return a sound for a clip in a sound bank.
+ */
+std::shared_ptr<Sound> SoundLoader::allocBanked(const std::shared_ptr<JsonValue>& json) {
+    std::string source = json->getString("file",UNKNOWN_SOURCE);
+    std::string clip = json->getString("clip",json->key());
+    std::string path = Application::get()->getAssetDirectory() + source;
+
+    std::shared_ptr<SoundBank> bank = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(_bankMutex);
+        auto it = _banks.find(path);
+        if (it != _banks.end()) {
+            bank = it->second;
+        } else {
+            bank = SoundBank::alloc(path);
+            if (bank != nullptr) {
+                _banks[path] = bank;
+            }
+        }
+    }
+    return BankedSound::alloc(bank,clip);
+}
+
 /**
  * Finishes loading the sound file, setting its default volume.
  *
@@ -165,7 +198,7 @@ bool SoundLoader::read(const std::string& key, const std::string& source, Loader
                     return false;
                 });
             }
-        });
+        }, ThreadPool::Priority::LOADING);
     }
     
     return success;
@@ -185,7 +218,9 @@ bool SoundLoader::read(const std::string& key, const std::string& source, Loader
  * This version of read provides support for JSON directories. A soundfx
  * directory entry has the following values
  *
- *      "file":         The path to the asset
+ *      "type":         One of "sample", "waveform", or "bank"
+ *      "file":         The path to the asset (or sound bank)
+ *      "clip":         The clip name in the bank (defaults to the key)
  *      "volume":       This default sound volume (float)
  *
  * @param json      The directory entry for the asset
@@ -211,6 +246,8 @@ bool SoundLoader::read(const std::shared_ptr<JsonValue>& json, LoaderCallback ca
             sound = AudioSample::allocWithData(json);
         } else if (type == "waveform") {
             sound = AudioWaveform::allocWithData(json);
+        } else if (type == "bank") {
+            sound = allocBanked(json);
         }
         success = (sound != nullptr);
         if (success) {
@@ -224,6 +261,8 @@ bool SoundLoader::read(const std::shared_ptr<JsonValue>& json, LoaderCallback ca
                 sound = AudioSample::allocWithData(json);
             } else if (type == "waveform") {
                 sound = AudioWaveform::allocWithData(json);
+            } else if (type == "bank") {
+                sound = allocBanked(json);
             }
             if (sound != nullptr) {
                 sound->setVolume(volume);
@@ -232,7 +271,7 @@ bool SoundLoader::read(const std::shared_ptr<JsonValue>& json, LoaderCallback ca
                     return false;
                 });
             }
-        });
+        }, ThreadPool::Priority::LOADING);
     }
     
     return success;
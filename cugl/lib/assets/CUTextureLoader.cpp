@@ -321,7 +321,7 @@ bool TextureLoader::read(const std::string& key, const std::string& source, Load
                 this->materialize(key,surface,callback);
                 return false;
             });
-        });
+        }, ThreadPool::Priority::LOADING);
     }
 
 	if (success) {
@@ -390,7 +390,7 @@ bool TextureLoader::read(const std::shared_ptr<JsonValue>& json, LoaderCallback
                 this->materialize(json,surface,callback);
                 return false;
             });
-        });
+        }, ThreadPool::Priority::LOADING);
     }
     
     if (success) {
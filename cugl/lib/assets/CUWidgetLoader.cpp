@@ -125,7 +125,7 @@ bool WidgetLoader::read(const std::string& key, const std::string& source, Loade
                 this->materialize(key,widget,callback);
                 return false;
             });
-        });
+        }, ThreadPool::Priority::LOADING);
     }
     
     return success;
@@ -175,7 +175,7 @@ bool WidgetLoader::read(const std::shared_ptr<JsonValue>& json, LoaderCallback c
                 this->materialize(key,widget,callback);
                 return false;
             });
-        });
+        }, ThreadPool::Priority::LOADING);
     }
     
     return success;
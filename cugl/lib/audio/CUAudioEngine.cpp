@@ -105,6 +105,7 @@ bool AudioEngine::init(const std::shared_ptr<AudioOutput>& device, Uint32 slots)
             std::shared_ptr<AudioQueue> music = AudioQueue::alloc(cover);
             if (music != nullptr) {
                 _queues.push_back(music);
+                _queueCovers.push_back(cover);
             }
         }
     }
@@ -145,6 +146,7 @@ void AudioEngine::dispose() {
         _mixer = nullptr;
         
         _queues.clear();
+        _queueCovers.clear();
 		_actives.clear();
         _evicts.clear();
 	}
@@ -486,6 +488,7 @@ std::shared_ptr<AudioQueue> AudioEngine::allocQueue() {
     std::shared_ptr<AudioQueue> music = std::make_shared<AudioQueue>();
     if (music->init(cover)) {
         _queues.push_back(music);
+        _queueCovers.push_back(cover);
     }
     
     if (paused) {
@@ -537,6 +540,7 @@ void AudioEngine::freeQueue(const std::shared_ptr<AudioQueue>& queue) {
     }
     _mixer->setWidth(_mixer->getWidth()-1);
     _queues.erase(_queues.begin()+pos);
+    _queueCovers.erase(_queueCovers.begin()+pos);
     queue->dispose();
 }
 
@@ -618,6 +622,7 @@ bool AudioEngine::play(const std::string key, const std::shared_ptr<Sound>& soun
     fader->setGain(volume);
     fader->setTag(audioID);
     fader->setName(key);
+    _covers[audioID]->resetReadTime();
     _slots[audioID]->play(fader, loop ? -1 : 0);
     _actives.emplace(key,fader);
     _evicts.push_back(key);
@@ -704,6 +709,7 @@ bool AudioEngine::play(const std::string key, const std::shared_ptr<audio::Audio
     fader->setGain(volume);
     fader->setTag(audioID);
     fader->setName(key);
+    _covers[audioID]->resetReadTime();
     _slots[audioID]->play(fader, loop ? -1 : 0);
     _actives.emplace(key,fader);
     _evicts.push_back(key);
@@ -1246,3 +1252,92 @@ void AudioEngine::resume()  {
     }
 }
 
+#pragma mark -
+#pragma mark Performance Statistics
+/**
+ * Returns a snapshot of the audio thread performance counters.
+ *
+ * The counters are accumulated lock-free in the audio thread, so this
+ * method never blocks playback.  It is intended for debugging overlays
+ * and for tuning the buffer size of the output device.
+ *
+ * @return a snapshot of the audio thread performance counters.
+ */
+AudioEngine::Statistics AudioEngine::getStatistics() const {
+    CUAssertLog(_output != nullptr, "Attempt to use an unintiatialized audio engine");
+    Statistics result;
+    result.deadline  = _output->getDeadline();
+    result.last      = _output->getOverhead();
+    result.worst     = _output->getWorstOverhead();
+    result.median    = _output->getPercentileOverhead(0.50f);
+    result.p95       = _output->getPercentileOverhead(0.95f);
+    result.p99       = _output->getPercentileOverhead(0.99f);
+    result.callbacks = _output->getCallbacks();
+    result.underruns = _output->getUnderruns();
+    result.voices = 0;
+    for(auto it = _slots.begin(); it != _slots.end(); ++it) {
+        if ((*it)->isPlaying()) {
+            result.voices++;
+        }
+    }
+    return result;
+}
+
+/**
+ * Resets the audio thread performance counters.
+ *
+ * This resets the output device as well as the timing of every slot.
+ */
+void AudioEngine::resetStatistics() {
+    CUAssertLog(_output != nullptr, "Attempt to use an unintiatialized audio engine");
+    _output->resetStatistics();
+    _mixer->resetReadTime();
+    for(auto it = _covers.begin(); it != _covers.end(); ++it) {
+        (*it)->resetReadTime();
+    }
+    for(auto it = _queueCovers.begin(); it != _queueCovers.end(); ++it) {
+        (*it)->resetReadTime();
+    }
+}
+
+/**
+ * Returns the average time in microseconds to read the given sound effect.
+ *
+ * This is the time for the entire audio subtree of the slot playing
+ * the sound, including any fader or panner wrappers.  The average is
+ * measured since the sound started playing.  If the key does not
+ * correspond to an active sound effect, this method returns 0.
+ *
+ * @param  key  the reference key for the sound effect
+ *
+ * @return the average time in microseconds to read the given sound effect.
+ */
+Uint64 AudioEngine::getReadTime(const std::string key) const {
+    CUAssertLog(_output != nullptr, "Attempt to use an unintiatialized audio engine");
+    auto it = _actives.find(key);
+    if (it == _actives.end()) {
+        return 0;
+    }
+    std::shared_ptr<AudioFader> cover = _covers.at(it->second->getTag());
+    Uint64 count = cover->getReadCount();
+    return count ? cover->getReadTime()/count : 0;
+}
+
+/**
+ * Returns the average time in microseconds to read the music queues.
+ *
+ * This is the combined average over all of the music slots since the
+ * statistics were last reset.
+ *
+ * @return the average time in microseconds to read the music queues.
+ */
+Uint64 AudioEngine::getMusicReadTime() const {
+    CUAssertLog(_output != nullptr, "Attempt to use an unintiatialized audio engine");
+    Uint64 time = 0;
+    Uint64 count = 0;
+    for(auto it = _queueCovers.begin(); it != _queueCovers.end(); ++it) {
+        time  += (*it)->getReadTime();
+        count += (*it)->getReadCount();
+    }
+    return count ? time/count : 0;
+}
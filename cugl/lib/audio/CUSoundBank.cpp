@@ -0,0 +1,441 @@
+//
+//  CUSoundBank.cpp
+//  Cornell University Game Library (CUGL)
+//
+//  This module provides a packed bank of short sound effects.  Traditional
+//  audio samples are fully decoded to float PCM when they are loaded.  That
+//  is four times the size of 16-bit PCM and far larger than the compressed
+//  source file.  It also means all of the decoding happens at startup.
+//
+//  A sound bank is a single file with a small index followed by 16-bit PCM
+//  clips.  The file is memory mapped (where the platform allows it), so the
+//  clips cost no decoding at load time.  A clip is only converted to float
+//  the first time that it is played, and the converted buffers are kept in
+//  a bounded LRU cache.
+//
+//  This class uses our standard shared-pointer architecture.
+//
+//  1. The constructor does not perform any initialization; it just sets all
+//     attributes to their defaults.
+//
+//  2. All initialization takes place via init methods, which can fail if an
+//     object is initialized more than once.
+//
+//  3. All allocation takes place via static constructors which return a shared
+//     pointer.
+//
+//
+//  CUGL MIT License:
+//      This software is provided 'as-is', without any express or implied
+//      warranty.  In no event will the authors be held liable for any damages
+//      arising from the use of this software.
+//
+//      Permission is granted to anyone to use this software for any purpose,
+//      including commercial applications, and to alter it and redistribute it
+//      freely, subject to the following restrictions:
+//
+//      1. The origin of this software must not be misrepresented; you must not
+//      claim that you wrote the original software. If you use this software
+//      in a product, an acknowledgment in the product documentation would be
+//      appreciated but is not required.
+//
+//      2. Altered source versions must be plainly marked as such, and must not
+//      be misrepresented as being the original software.
+//
+//      3. This notice may not be removed or altered from any source distribution.
+//
+//  Author: Dragonglass Studios
+//  Version: 10/18/26
+//
+#include <cugl/audio/CUSoundBank.h>
+#include <cugl/util/CUDebug.h>
+#include <cstring>
+
+using namespace cugl;
+
+/** The magic number at the start of every bank */
+#define SOUNDBANK_MAGIC     "CUSB"
+/** The current version of the bank format */
+#define SOUNDBANK_VERSION   1
+/** The size of the bank header in bytes */
+#define SOUNDBANK_HEADER    8
+
+/**
+ * Returns the little-endian 16-bit value at the given address.
+ *
+ * @param data  The (possibly unaligned) address
+ *
+ * @return the little-endian 16-bit value at the given address.
+ */
+static Uint16 readLE16(const Uint8* data) {
+    Uint16 value;
+    std::memcpy(&value,data,sizeof(Uint16));
+    return SDL_SwapLE16(value);
+}
+
+/**
+ * Returns the little-endian 32-bit value at the given address.
+ *
+ * @param data  The (possibly unaligned) address
+ *
+ * @return the little-endian 32-bit value at the given address.
+ */
+static Uint32 readLE32(const Uint8* data) {
+    Uint32 value;
+    std::memcpy(&value,data,sizeof(Uint32));
+    return SDL_SwapLE32(value);
+}
+
+#pragma mark -
+#pragma mark Constructors
+/**
+ * Creates a degenerate sound bank with no clips.
+ *
+ * NEVER USE A CONSTRUCTOR WITH NEW. If you want to allocate an asset on
+ * the heap, use one of the static constructors instead.
+ */
+SoundBank::SoundBank() :
+_data(nullptr),
+_size(0),
+_capacity(SOUNDBANK_CACHE_SIZE),
+_resident(0) {
+}
+
+/**
+ * Initializes this sound bank from the given file.
+ *
+ * The file is memory mapped where the platform allows it.  On platforms
+ * where the assets are not ordinary files (such as Android), it is read
+ * into a single 16-bit buffer instead.  Either way, no clip is decoded
+ * until it is first acquired.
+ *
+ * @param file      The bank file
+ * @param capacity  The maximum number of bytes of decoded clips to cache
+ *
+ * @return true if the bank was initialized successfully
+ */
+bool SoundBank::init(const std::string& file, size_t capacity) {
+    CUAssertLog(_data == nullptr, "Sound bank is already initialized");
+    _file = file;
+    _capacity = capacity;
+
+    _contents = MappedFile::alloc(file);
+    if (_contents != nullptr) {
+        _data = _contents->data();
+        _size = _contents->size();
+    }
+
+    if (_data == nullptr || !parseIndex()) {
+        CULogError("Sound bank '%s' is not a valid bank file.", file.c_str());
+        dispose();
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Releases the bank contents and clears the cache.
+ *
+ * Clips that are still playing are unaffected, as they own their
+ * decoded buffers.
+ */
+void SoundBank::dispose() {
+    purge();
+    _entries.clear();
+    _lookup.clear();
+    _contents = nullptr;
+    _data = nullptr;
+    _size = 0;
+    _file.clear();
+}
+
+/**
+ * Parses the clip index from the bank contents.
+ *
+ * @return true if the index is valid
+ */
+bool SoundBank::parseIndex() {
+    if (_size < SOUNDBANK_HEADER || std::memcmp(_data, SOUNDBANK_MAGIC, 4) != 0) {
+        return false;
+    }
+    Uint16 version = readLE16(_data+4);
+    if (version != SOUNDBANK_VERSION) {
+        CULogError("Unsupported sound bank version %d.", version);
+        return false;
+    }
+
+    Uint16 count = readLE16(_data+6);
+    if (SOUNDBANK_HEADER+(size_t)count*SOUNDBANK_ENTRY_SIZE > _size) {
+        return false;
+    }
+
+    _entries.reserve(count);
+    const Uint8* record = _data+SOUNDBANK_HEADER;
+    for(Uint16 ii = 0; ii < count; ii++) {
+        Entry entry;
+        const char* name = (const char*)record;
+        entry.name = std::string(name, strnlen(name, SOUNDBANK_NAME_SIZE));
+        entry.channels = record[SOUNDBANK_NAME_SIZE];
+        entry.encoding = (Encoding)record[SOUNDBANK_NAME_SIZE+1];
+        entry.rate   = readLE32(record+SOUNDBANK_NAME_SIZE+4);
+        entry.frames = readLE32(record+SOUNDBANK_NAME_SIZE+8);
+        entry.offset = readLE32(record+SOUNDBANK_NAME_SIZE+12);
+
+        size_t bytes = (size_t)entry.frames*entry.channels*sizeof(Sint16);
+        if (entry.encoding != Encoding::PCM16 || entry.channels == 0 ||
+            (size_t)entry.offset+bytes > _size) {
+            CULogError("Sound bank clip '%s' is corrupt.", entry.name.c_str());
+            return false;
+        }
+        _lookup[entry.name] = _entries.size();
+        _entries.push_back(entry);
+        record += SOUNDBANK_ENTRY_SIZE;
+    }
+    return true;
+}
+
+#pragma mark -
+#pragma mark Attributes
+/**
+ * Returns the index entry for the given clip, or nullptr if missing.
+ *
+ * @param name  The clip name
+ *
+ * @return the index entry for the given clip, or nullptr if missing.
+ */
+const SoundBank::Entry* SoundBank::getEntry(const std::string& name) const {
+    auto it = _lookup.find(name);
+    return it == _lookup.end() ? nullptr : &_entries[it->second];
+}
+
+/**
+ * Sets the maximum number of bytes of decoded clips to cache.
+ *
+ * If the cache is currently larger than this, the least recently used
+ * clips are evicted immediately.
+ *
+ * @param capacity  The maximum number of bytes of decoded clips to cache
+ */
+void SoundBank::setCapacity(size_t capacity) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _capacity = capacity;
+    trim();
+}
+
+/**
+ * Returns the number of bytes of decoded clips currently cached.
+ *
+ * This does not include the (mapped) 16-bit clip data.
+ *
+ * @return the number of bytes of decoded clips currently cached.
+ */
+size_t SoundBank::getResidentSize() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _resident;
+}
+
+#pragma mark -
+#pragma mark Decoding
+/**
+ * Returns the decoded clip with the given name.
+ *
+ * If the clip is cached, this marks it as most recently used.  Otherwise
+ * it is converted to float PCM and added to the cache, evicting older
+ * clips as necessary.  This method returns nullptr if there is no clip
+ * with that name.
+ *
+ * @param name  The clip name
+ *
+ * @return the decoded clip with the given name.
+ */
+std::shared_ptr<AudioSample> SoundBank::acquire(const std::string& name) {
+    auto found = _lookup.find(name);
+    if (found == _lookup.end()) {
+        return nullptr;
+    }
+    size_t pos = found->second;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto hit = _cache.find(pos);
+    if (hit != _cache.end()) {
+        _recent.splice(_recent.begin(), _recent, hit->second.second);
+        return hit->second.first;
+    }
+
+    const Entry& entry = _entries[pos];
+    std::shared_ptr<AudioSample> sample = AudioSample::alloc(entry.channels, entry.rate, entry.frames);
+    if (sample == nullptr) {
+        return nullptr;
+    }
+
+    float* output = sample->getBuffer();
+    const Uint8* input = _data+entry.offset;
+    size_t total = (size_t)entry.frames*entry.channels;
+    for(size_t ii = 0; ii < total; ii++) {
+        output[ii] = (Sint16)readLE16(input+ii*sizeof(Sint16))/32768.0f;
+    }
+
+    _recent.push_front(pos);
+    _cache.emplace(pos, std::make_pair(sample, _recent.begin()));
+    _resident += total*sizeof(float);
+    trim();
+    return sample;
+}
+
+/**
+ * Removes all decoded clips from the cache.
+ */
+void SoundBank::purge() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _cache.clear();
+    _recent.clear();
+    _resident = 0;
+}
+
+/**
+ * Evicts least recently used clips until the cache fits in its capacity.
+ *
+ * This method assumes the cache mutex is held.  The most recently used
+ * clip is never evicted, even if it alone exceeds the capacity.
+ */
+void SoundBank::trim() {
+    while (_resident > _capacity && _recent.size() > 1) {
+        size_t pos = _recent.back();
+        _recent.pop_back();
+        const Entry& entry = _entries[pos];
+        _resident -= (size_t)entry.frames*entry.channels*sizeof(float);
+        _cache.erase(pos);
+    }
+}
+
+/**
+ * Writes a sound bank containing the given sound files.
+ *
+ * This is the offline compiler for the bank format.  Each source is
+ * decoded with the standard {@link AudioSample} decoders and stored as
+ * 16-bit PCM under the matching name.  The sources and destination are
+ * ordinary paths (not relative to the asset directory), so this should
+ * be run from a desktop build.
+ *
+ * @param dest      The path of the bank to write
+ * @param names     The clip names
+ * @param sources   The sound files, one for each name
+ *
+ * @return true if the bank was written successfully
+ */
+bool SoundBank::compile(const std::string& dest,
+                        const std::vector<std::string>& names,
+                        const std::vector<std::string>& sources) {
+    CUAssertLog(names.size() == sources.size(), "Each clip must have a name");
+    CUAssertLog(names.size() <= 0xFFFF, "Too many clips for a single bank");
+
+    std::vector<std::shared_ptr<AudioSample>> samples;
+    for(auto it = sources.begin(); it != sources.end(); ++it) {
+        std::shared_ptr<AudioSample> sample = AudioSample::alloc(*it);
+        if (sample == nullptr) {
+            CULogError("Could not decode '%s' for sound bank.", it->c_str());
+            return false;
+        }
+        samples.push_back(sample);
+    }
+
+    SDL_RWops* out = SDL_RWFromFile(dest.c_str(), "wb");
+    if (out == nullptr) {
+        CULogError("Could not create sound bank '%s': %s", dest.c_str(), SDL_GetError());
+        return false;
+    }
+
+    SDL_RWwrite(out, SOUNDBANK_MAGIC, 1, 4);
+    SDL_WriteLE16(out, SOUNDBANK_VERSION);
+    SDL_WriteLE16(out, (Uint16)names.size());
+
+    Uint32 offset = SOUNDBANK_HEADER+(Uint32)(names.size()*SOUNDBANK_ENTRY_SIZE);
+    for(size_t ii = 0; ii < names.size(); ii++) {
+        CUAssertLog(names[ii].size() < SOUNDBANK_NAME_SIZE, "Clip name '%s' is too long", names[ii].c_str());
+        char name[SOUNDBANK_NAME_SIZE];
+        std::memset(name, 0, SOUNDBANK_NAME_SIZE);
+        std::strncpy(name, names[ii].c_str(), SOUNDBANK_NAME_SIZE-1);
+        SDL_RWwrite(out, name, 1, SOUNDBANK_NAME_SIZE);
+        SDL_WriteU8(out, (Uint8)samples[ii]->getChannels());
+        SDL_WriteU8(out, (Uint8)Encoding::PCM16);
+        SDL_WriteLE16(out, 0);
+        SDL_WriteLE32(out, samples[ii]->getRate());
+        SDL_WriteLE32(out, (Uint32)samples[ii]->getLength());
+        SDL_WriteLE32(out, offset);
+
+        Uint32 bytes = (Uint32)(samples[ii]->getLength()*samples[ii]->getChannels()*sizeof(Sint16));
+        offset += (bytes+3) & ~3;
+    }
+
+    for(size_t ii = 0; ii < samples.size(); ii++) {
+        const float* input = samples[ii]->getBuffer();
+        size_t total = (size_t)(samples[ii]->getLength()*samples[ii]->getChannels());
+        for(size_t jj = 0; jj < total; jj++) {
+            float value = std::max(-1.0f, std::min(input[jj], 1.0f));
+            SDL_WriteLE16(out, (Uint16)(Sint16)(value*32767.0f));
+        }
+        size_t pad = ((total*sizeof(Sint16)+3) & ~3)-total*sizeof(Sint16);
+        for(size_t jj = 0; jj < pad; jj++) {
+            SDL_WriteU8(out, 0);
+        }
+    }
+
+    SDL_RWclose(out);
+    return true;
+}
+
+#pragma mark -
+#pragma mark Banked Sound
+/**
+ * Initializes this sound as the named clip of the given bank.
+ *
+ * @param bank  The sound bank
+ * @param name  The clip name
+ *
+ * @return true if the sound was initialized successfully
+ */
+bool BankedSound::init(const std::shared_ptr<SoundBank>& bank, const std::string& name) {
+    const SoundBank::Entry* entry = bank == nullptr ? nullptr : bank->getEntry(name);
+    if (entry == nullptr) {
+        CULogError("Sound bank has no clip '%s'.", name.c_str());
+        return false;
+    }
+    _bank = bank;
+    _name = name;
+    _file = bank->getFile();
+    _channels = entry->channels;
+    _rate   = entry->rate;
+    _frames = entry->frames;
+    return true;
+}
+
+/**
+ * Releases the bank reference and resets all attributes.
+ */
+void BankedSound::dispose() {
+    _bank = nullptr;
+    _name.clear();
+    _frames = 0;
+    Sound::dispose();
+}
+
+/**
+ * Returns a playable audio node for this clip.
+ *
+ * This decodes the clip through the bank cache if necessary.  Nodes are
+ * distinct.  Each call to this method allocates a new audio node.
+ *
+ * @return a playable audio node for this clip.
+ */
+std::shared_ptr<audio::AudioNode> BankedSound::createNode() {
+    if (_bank == nullptr) {
+        return nullptr;
+    }
+    std::shared_ptr<AudioSample> sample = _bank->acquire(_name);
+    if (sample == nullptr) {
+        return nullptr;
+    }
+    std::shared_ptr<audio::AudioNode> node = sample->createNode();
+    node->setGain(_volume);
+    return node;
+}
@@ -37,6 +37,7 @@
 #include <cugl/audio/CUAudioDevices.h>
 #include <cugl/math/dsp/CUDSPMath.h>
 #include <cugl/util/CUDebug.h>
+#include <cugl/util/CUTimestamp.h>
 #include <atomic>
 
 using namespace cugl;
@@ -248,7 +249,11 @@ Uint32 AudioMixer::read(float* buffer, Uint32 frames) {
         for(int ii = 0; ii < _width; ii++) {
             temp = std::atomic_load_explicit(_inputs+ii,std::memory_order_relaxed);
             if (temp) {
+                // Time each input so that we can profile the subtrees
+                Timestamp start;
                 Uint32 amt = temp->read(_buffer,frames);
+                Timestamp end;
+                temp->recordRead(Timestamp::ellapsedMicros(start,end));
                 actual = std::max(amt,actual);
                 if (amt < frames) {
                     std::memset(_buffer+amt,0,(frames-amt)*_channels*sizeof(float));
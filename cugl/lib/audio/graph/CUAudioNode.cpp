@@ -77,6 +77,8 @@ AudioNode::AudioNode() : _channels(0), _sampling(0) {
     _polling = false;
     _booted = false;
     _tag = -1;
+    _readtime = 0;
+    _readcount = 0;
 }
 
 /**
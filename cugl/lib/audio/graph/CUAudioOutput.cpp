@@ -51,6 +51,7 @@
 #include <cugl/util/CUTimestamp.h>
 #include <atomic>
 #include <cstring>
+#include <algorithm>
 
 using namespace cugl::audio;
 
@@ -142,12 +143,18 @@ static int paddingSize(Uint32 inrate, Uint32 outrate) {
 AudioOutput::AudioOutput() : AudioNode(),
 _dvname(""),
 _overhd(0),
+_worst(0),
+_callbacks(0),
+_underruns(0),
 _cvtratio(1.0f),
 _cvtbuffer(nullptr),
 _input(nullptr) {
     _classname = "AudioOutput";
     _resampler = NULL;
     _bitrate = sizeof(float);
+    for(int ii = 0; ii < AUDIO_HISTOGRAM_SIZE; ii++) {
+        _histogram[ii] = 0;
+    }
 }
 
 /**
@@ -550,9 +557,13 @@ Uint32 AudioOutput::read(float* buffer, Uint32 frames) {
         Sint32 take = 0;
         if (_resampler != NULL) {
             bool search = true;
+            Uint64 elapsed = 0;
             while (take < frames && search) {
                 Sint32 amt = std::ceil(frames*_cvtratio);
+                Timestamp begin;
                 amt = input->read(_cvtbuffer, amt);
+                Timestamp after;
+                elapsed += Timestamp::ellapsedMicros(begin,after);
                 if (SDL_AudioStreamPut(_resampler, _cvtbuffer, amt*sizeof(float)*_channels) < 0) {
                     CULogError("[AUDIO] Resampling error.");
                     std::memset(realbuf+take*realchan*_bitrate,0,(frames-take)*realchan*_bitrate);
@@ -572,8 +583,12 @@ Uint32 AudioOutput::read(float* buffer, Uint32 frames) {
                     }
                 }
             }
+            input->recordRead(elapsed);
         } else {
+            Timestamp begin;
             take = input->read(buffer, frames);
+            Timestamp after;
+            input->recordRead(Timestamp::ellapsedMicros(begin,after));
         }
         if (take < frames) {
             std::memset(realbuf+take*realchan*_bitrate,0,(frames-take)*realchan*_bitrate);
@@ -582,6 +597,17 @@ Uint32 AudioOutput::read(float* buffer, Uint32 frames) {
     Timestamp end;
     Uint64 micros = Timestamp::ellapsedMicros(start,end);
     _overhd.store(micros,std::memory_order_relaxed);
+
+    // Statistics are lock-free so we never block the audio thread
+    _callbacks.fetch_add(1,std::memory_order_relaxed);
+    if (micros > _worst.load(std::memory_order_relaxed)) {
+        _worst.store(micros,std::memory_order_relaxed);
+    }
+    if (micros*_audiospec.freq > (Uint64)frames*1000000) {
+        _underruns.fetch_add(1,std::memory_order_relaxed);
+    }
+    size_t bucket = std::min((size_t)(micros/AUDIO_HISTOGRAM_WIDTH),(size_t)AUDIO_HISTOGRAM_SIZE-1);
+    _histogram[bucket].fetch_add(1,std::memory_order_relaxed);
     return frames;
 }
 
@@ -627,6 +653,108 @@ Uint64 AudioOutput::getOverhead() const {
     return _overhd.load(std::memory_order_relaxed);
 }
 
+#pragma mark -
+#pragma mark Performance Statistics
+/**
+ * Returns the number of microseconds available to render one audio frame.
+ *
+ * This is the deadline for a single call to {@link read()}.  It is the
+ * duration of the device buffer, so 512 frames at 48000 Hz has a deadline
+ * of 10666 microseconds.  A read that takes longer than this will cause
+ * an audible glitch.
+ *
+ * @return the number of microseconds available to render one audio frame.
+ */
+Uint64 AudioOutput::getDeadline() const {
+    if (_audiospec.freq <= 0) {
+        return 0;
+    }
+    return ((Uint64)_audiospec.samples*1000000)/_audiospec.freq;
+}
+
+/**
+ * Returns the largest number of microseconds needed to render an audio frame.
+ *
+ * This is the worst case since the last call to {@link resetStatistics()}.
+ *
+ * @return the largest number of microseconds needed to render an audio frame.
+ */
+Uint64 AudioOutput::getWorstOverhead() const {
+    return _worst.load(std::memory_order_relaxed);
+}
+
+/**
+ * Returns the approximate render time at the given percentile.
+ *
+ * The value is computed from a histogram of buckets that are each
+ * {@link AUDIO_HISTOGRAM_WIDTH} microseconds wide.  Hence the result is
+ * the upper bound of the bucket containing the percentile.  Times beyond
+ * the last bucket are clamped to it.
+ *
+ * This method should only be called in the main thread.
+ *
+ * @param percent   The percentile in the range [0,1]
+ *
+ * @return the approximate render time at the given percentile.
+ */
+Uint64 AudioOutput::getPercentileOverhead(float percent) const {
+    Uint32 counts[AUDIO_HISTOGRAM_SIZE];
+    Uint64 total = 0;
+    for(int ii = 0; ii < AUDIO_HISTOGRAM_SIZE; ii++) {
+        counts[ii] = _histogram[ii].load(std::memory_order_relaxed);
+        total += counts[ii];
+    }
+    if (total == 0) {
+        return 0;
+    }
+
+    percent = std::max(0.0f,std::min(percent,1.0f));
+    Uint64 target = (Uint64)std::ceil(percent*total);
+    Uint64 sofar = 0;
+    for(int ii = 0; ii < AUDIO_HISTOGRAM_SIZE; ii++) {
+        sofar += counts[ii];
+        if (sofar >= target && sofar > 0) {
+            return (Uint64)(ii+1)*AUDIO_HISTOGRAM_WIDTH;
+        }
+    }
+    return (Uint64)AUDIO_HISTOGRAM_SIZE*AUDIO_HISTOGRAM_WIDTH;
+}
+
+/**
+ * Returns the number of audio frames rendered since the last reset.
+ *
+ * @return the number of audio frames rendered since the last reset.
+ */
+Uint64 AudioOutput::getCallbacks() const {
+    return _callbacks.load(std::memory_order_relaxed);
+}
+
+/**
+ * Returns the number of audio frames that missed their deadline.
+ *
+ * An underrun is any call to {@link read()} that took longer than the
+ * duration of the buffer it filled.
+ *
+ * @return the number of audio frames that missed their deadline.
+ */
+Uint64 AudioOutput::getUnderruns() const {
+    return _underruns.load(std::memory_order_relaxed);
+}
+
+/**
+ * Resets all of the performance statistics for this device.
+ *
+ * This does not reset the statistics of the nodes in the audio graph.
+ */
+void AudioOutput::resetStatistics() {
+    _worst.store(0,std::memory_order_relaxed);
+    _callbacks.store(0,std::memory_order_relaxed);
+    _underruns.store(0,std::memory_order_relaxed);
+    for(int ii = 0; ii < AUDIO_HISTOGRAM_SIZE; ii++) {
+        _histogram[ii].store(0,std::memory_order_relaxed);
+    }
+}
+
 
 #pragma mark -
 #pragma mark Optional Methods
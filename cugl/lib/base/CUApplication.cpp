@@ -44,6 +44,10 @@
 #define DEFAULT_HEIGHT  576
 /** The default smoothing window for fps calculation */
 #define FPS_WINDOW      10
+/** The number of frames in a row with nothing to draw before going idle */
+#define IDLE_FRAMES     15
+/** The milliseconds between checks for events in the background */
+#define BACKGROUND_WAIT 100
 
 using namespace cugl;
 
@@ -68,10 +72,22 @@ _state(State::NONE),
 _fullscreen(false),
 _highdpi(true),
 _funcid(0),
-_clearColor(Color4f::CORNFLOWER) // Ah, XNA
+_incoming(nullptr),
+_clock(0),
+_clearColor(Color4f::CORNFLOWER), // Ah, XNA
+_idleFrames(0),
+_redraw(true),
+_pipelined(false),
+_drawThread(nullptr),
+_drawStart(nullptr),
+_drawDone(nullptr),
+_drawStop(false),
+_drawPending(false)
 {
     _display.size.set(DEFAULT_WIDTH,DEFAULT_HEIGHT);
     setFPS(60.0f);
+    setIdleFPS(10.0f);
+    std::fill(_wheel, _wheel+CU_CALLBACK_WHEEL, nullptr);
 #if (CU_PLATFORM == CU_PLATFORM_IPHONE || CU_PLATFORM == CU_PLATFORM_ANDROID)
     _fullscreen = true;
 #endif
@@ -90,6 +106,13 @@ _clearColor(Color4f::CORNFLOWER) // Ah, XNA
  * it can be safely reinitialized.
  */
 void Application::dispose() {
+    stopDrawThread();
+    _pipelined = false;
+    _drawPending = false;
+    _idleFrames = 0;
+    _redraw = true;
+    clearCallbacks();
+    _clock = 0;
     _name = "CUGL Game";
     _state = State::NONE;
     _display.set(0,0,DEFAULT_WIDTH,DEFAULT_HEIGHT);
@@ -208,6 +231,8 @@ bool Application::getInput() {
         if (!Input::get()->update(event)) {
             return false;
         }
+        // Anything from input to a window change may need a new frame
+        _redraw = true;
         switch (event.type) {
             // APPLICATION STATE
             case SDL_APP_TERMINATING:
@@ -269,29 +294,146 @@ bool Application::step() {
     Uint32 begin = SDL_GetTicks();
     _start.mark();
     bool running = getInput();
+    bool idle = false;
     if (running &&  _state == State::FOREGROUND) {
         processCallbacks(((Uint32)micros)/1000);
         update(micros/1000000.0f);
 
-        glClearColor(_clearColor.r, _clearColor.g, _clearColor.b, _clearColor.a);
-        glClear( GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-
-        draw();
-        Display::get()->refresh();
+        // Leave the last frame on the screen if nothing changed
+        bool redraw = needsRedraw() || _redraw;
+        _redraw = false;
+        _idleFrames = redraw ? 0 : std::min(_idleFrames+1, (unsigned int)IDLE_FRAMES);
+        // Callbacks, like jobs spread over frames, must not wait for idle frames
+        idle = _idleFrames == IDLE_FRAMES && !hasCallbackDue(_idleDelay);
+        
+        if (_pipelined) {
+            // Draw the next frame while the last one goes to the screen
+            if (redraw) {
+                startDrawThread();
+                SDL_SemPost(_drawStart);
+            }
+            if (_drawPending) {
+                glClearColor(_clearColor.r, _clearColor.g, _clearColor.b, _clearColor.a);
+                glClear( GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+                submit();
+                Display::get()->refresh();
+            }
+            if (redraw) {
+                SDL_SemWait(_drawDone);
+            }
+            _drawPending = redraw;
+        } else {
+            stopDrawThread();
+            _drawPending = false;
+            if (redraw) {
+                glClearColor(_clearColor.r, _clearColor.g, _clearColor.b, _clearColor.a);
+                glClear( GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+                draw();
+                Display::get()->refresh();
+            }
+        }
     } else {
         running = _state == State::BACKGROUND;
     }
+    if (!running) {
+        // Nothing may draw while the application shuts down
+        stopDrawThread();
+    }
 
 	// Sleep the remainder
     // SDL ticks give smoother frame than realistic timestamp
     Uint32 millis = SDL_GetTicks()-begin;
-	if (millis < _delay) {
+    if (_state == State::BACKGROUND) {
+        // Nothing to do but wait to come back
+        waitForEvent(BACKGROUND_WAIT, BACKGROUND_WAIT);
+    } else if (idle) {
+        // Input must still get through at the normal rate
+        if (millis < _idleDelay) {
+            waitForEvent(_idleDelay - millis, _delay);
+        }
+    } else if (millis < _delay) {
 		SDL_Delay(_delay - millis);
 	}
     
     return running;
 }
 
+/**
+ * Sleeps until there is an event to process or the timeout passes.
+ *
+ * SDL_WaitEventTimeout checks for events every millisecond, which keeps
+ * the CPU from ever sleeping. This method only checks every slice of
+ * the given length instead. A callback scheduled by another thread
+ * also ends the sleep, so that it is not held up while idle.
+ *
+ * @param timeout   The maximum time to sleep in milliseconds
+ * @param slice     The time between checks for events in milliseconds
+ */
+void Application::waitForEvent(Uint32 timeout, Uint32 slice) {
+    Uint32 begin = SDL_GetTicks();
+    while (true) {
+        SDL_PumpEvents();
+        if (SDL_HasEvents(SDL_FIRSTEVENT, SDL_LASTEVENT) ||
+            _incoming.load(std::memory_order_relaxed) != nullptr) {
+            return;
+        }
+        Uint32 millis = SDL_GetTicks()-begin;
+        if (millis >= timeout) {
+            return;
+        }
+        SDL_Delay(std::min(slice, timeout-millis));
+    }
+}
+
+/**
+ * The body function of the draw thread.
+ *
+ * @param ptr   The application
+ */
+int Application::drawThreadFunc(void* ptr) {
+    Application* self = (Application*)ptr;
+    while (true) {
+        SDL_SemWait(self->_drawStart);
+        if (self->_drawStop) {
+            break;
+        }
+        self->draw();
+        SDL_SemPost(self->_drawDone);
+    }
+    return 0;
+}
+
+/**
+ * Starts the draw thread, if it is not running.
+ */
+void Application::startDrawThread() {
+    if (_drawThread != nullptr) {
+        return;
+    }
+    _drawStart = SDL_CreateSemaphore(0);
+    _drawDone  = SDL_CreateSemaphore(0);
+    _drawStop  = false;
+    _drawThread = SDL_CreateThread(Application::drawThreadFunc, "Draw", (void*)this);
+}
+
+/**
+ * Stops the draw thread, waiting for it to exit.
+ */
+void Application::stopDrawThread() {
+    if (_drawThread == nullptr) {
+        return;
+    }
+    _drawStop = true;
+    SDL_SemPost(_drawStart);
+    int status;
+    SDL_WaitThread(_drawThread, &status);
+    SDL_DestroySemaphore(_drawStart);
+    SDL_DestroySemaphore(_drawDone);
+    _drawThread = nullptr;
+    _drawStart = nullptr;
+    _drawDone  = nullptr;
+}
+
 /**
  * Cleanly shuts down the application.
  *
@@ -331,21 +473,16 @@ void Application::quit() {
  * It will be executed after the input has been processed, but before
  * the main {@link update} thread.
  *
+ * This method may be called from any thread. It never blocks, as the
+ * callback is handed to the main thread with a lock-free queue.
+ *
  * @param callback  The callback function
  * @param time      The number of milliseconds to delay the callback.
  *
  * @return a unique identifier to unschedule the callback
  */
 Uint32 Application::schedule(std::function<bool()> callback, Uint32 time) {
-    scheduable item;
-    item.callback = callback;
-    item.period = time;
-    item.timer  = time;
-	{
-		std::unique_lock<std::mutex> lk(_queueMutex);
-		_callbacks.emplace(_funcid++, item);
-	}
-    return _funcid-1;
+    return schedule(callback, time, time);
 }
 
 /**
@@ -370,21 +507,22 @@ Uint32 Application::schedule(std::function<bool()> callback, Uint32 time) {
  * It will be executed after the input has been processed, but before
  * the main {@link update} thread.
  *
+ * This method may be called from any thread. It never blocks, as the
+ * callback is handed to the main thread with a lock-free queue.
+ *
  * @param callback  The callback function
  * @param time      The number of milliseconds to delay the callback.
  *
  * @return a unique identifier to unschedule the callback
  */
 Uint32 Application::schedule(std::function<bool()> callback, Uint32 time, Uint32 period) {
-    scheduable item;
-    item.callback = callback;
-    item.period = period;
-    item.timer  = time;
-	{
-		std::unique_lock<std::mutex> lk(_queueMutex);
-		_callbacks.emplace(_funcid++, item);
-	}
-    return _funcid-1;
+    Callback* item = new Callback();
+    item->callback = callback;
+    item->id = _funcid.fetch_add(1,std::memory_order_relaxed);
+    item->period = period;
+    item->due = time;
+    pushCallback(item);
+    return item->id;
 }
 
 /**
@@ -395,17 +533,148 @@ Uint32 Application::schedule(std::function<bool()> callback, Uint32 time, Uint32
  * be executed.  Once unscheduled, a callback must be re-scheduled in
  * order to be activated again.
  *
- * The callback is identified by its function pointer. Therefore, you
- * should be careful when scheduling anonymous closures.
+ * This method may be called from any thread. The callback is removed
+ * before the main thread next processes callbacks, even if it is due.
+ *
+ * The callback is identified by the unique identifier returned by the
+ * appropriate schedule function.  Hence this value should be saved if
+ * you ever wish to unschedule a callback.
+ *
+ * @param id    The callback identifier
  */
 void Application::unschedule(Uint32 id) {
-	std::unique_lock<std::mutex> lk(_queueMutex);
-    auto it = _callbacks.find(id);
-    if (it != _callbacks.end()) {
-        _callbacks.erase(it);
+    // A request without a function, so it stays in order with its schedule
+    Callback* item = new Callback();
+    item->id = id;
+    pushCallback(item);
+}
+
+/**
+ * Pushes a callback on the queue of scheduled callbacks.
+ *
+ * This method is lock-free, and may be called from any thread.
+ *
+ * @param item  The callback to push
+ */
+void Application::pushCallback(Callback* item) {
+    Callback* head = _incoming.load(std::memory_order_relaxed);
+    do {
+        item->link = head;
+    } while (!_incoming.compare_exchange_weak(head, item, std::memory_order_release,
+                                              std::memory_order_relaxed));
+}
+
+/**
+ * Moves everything from the queue of scheduled callbacks to the wheel.
+ *
+ * This method is only called on the main thread.
+ */
+void Application::drainCallbacks() {
+    // Take the whole queue at once, and put it back in order
+    Callback* item = _incoming.exchange(nullptr, std::memory_order_acquire);
+    Callback* order = nullptr;
+    while (item != nullptr) {
+        Callback* link = item->link;
+        item->link = order;
+        order = item;
+        item = link;
+    }
+    
+    while (order != nullptr) {
+        item = order;
+        order = order->link;
+        if (item->callback) {
+            // The delay counts from the clock as it is now
+            item->due += _clock+1;
+            _callbacks.emplace(item->id, item);
+            insertCallback(item);
+        } else {
+            auto it = _callbacks.find(item->id);
+            if (it != _callbacks.end()) {
+                Callback* target = it->second;
+                _callbacks.erase(it);
+                if (target->ready) {
+                    target->cancelled = true;
+                } else {
+                    removeCallback(target);
+                    delete target;
+                }
+            }
+            delete item;
+        }
     }
 }
 
+/**
+ * Adds a callback to the slot of the timer wheel for its due time.
+ *
+ * @param item  The callback to add
+ */
+void Application::insertCallback(Callback* item) {
+    Callback*& slot = _wheel[item->due % CU_CALLBACK_WHEEL];
+    item->ready = false;
+    item->prev = nullptr;
+    item->next = slot;
+    if (slot != nullptr) {
+        slot->prev = item;
+    }
+    slot = item;
+}
+
+/**
+ * Removes a callback from the slot of the timer wheel it is in.
+ *
+ * @param item  The callback to remove
+ */
+void Application::removeCallback(Callback* item) {
+    if (item->prev != nullptr) {
+        item->prev->next = item->next;
+    } else {
+        _wheel[item->due % CU_CALLBACK_WHEEL] = item->next;
+    }
+    if (item->next != nullptr) {
+        item->next->prev = item->prev;
+    }
+    item->prev = nullptr;
+    item->next = nullptr;
+}
+
+/**
+ * Returns true if a callback in the timer wheel is due within the time.
+ *
+ * @param millis    The number of milliseconds from now
+ *
+ * @return true if a callback in the timer wheel is due within the time.
+ */
+bool Application::hasCallbackDue(Uint32 millis) const {
+    Uint64 count = std::min((Uint64)millis, (Uint64)CU_CALLBACK_WHEEL);
+    for (Uint64 tick = _clock+1; tick <= _clock+count; tick++) {
+        for (Callback* item = _wheel[tick % CU_CALLBACK_WHEEL]; item != nullptr; item = item->next) {
+            if (item->due <= _clock+millis) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/**
+ * Deletes all of the scheduled callbacks, including any still queued.
+ */
+void Application::clearCallbacks() {
+    Callback* item = _incoming.exchange(nullptr, std::memory_order_acquire);
+    while (item != nullptr) {
+        Callback* link = item->link;
+        delete item;
+        item = link;
+    }
+    for(auto it = _callbacks.begin(); it != _callbacks.end(); ++it) {
+        delete it->second;
+    }
+    _callbacks.clear();
+    std::fill(_wheel, _wheel+CU_CALLBACK_WHEEL, nullptr);
+}
+
 /**
  * Processes all of the scheduled callback functions.
  *
@@ -413,40 +682,51 @@ void Application::unschedule(Uint32 id) {
  * If they are a one time callback, or if they return false, they are deleted.  
  * If they are a reoccuring callback and return true, the timer is reset.
  *
+ * Only the slots of the timer wheel for the milliseconds that passed
+ * are visited, so the cost depends on the callbacks that are ready,
+ * and not on how many are scheduled.
+ *
  * @param millis    The number of milliseconds since last called
  */
 void Application::processCallbacks(Uint32 millis) {
-	std::vector<Uint32> indeces;
-	std::vector<scheduable> actives;
-	{
-		std::unique_lock<std::mutex> lk(_queueMutex);
-		for (auto it = _callbacks.begin(); it != _callbacks.end(); ++it) {
-			if (it->second.timer < millis) {
-				indeces.push_back(it->first);
-				actives.push_back(it->second);
-				it->second.timer -= std::min(it->second.timer, millis);
-				it->second.timer += it->second.period;
-			} else {
-				it->second.timer -= millis;
-			}
-		}
-	}
-
-	// These can take a while, so do them outside lock
-	for (int ii = 0; ii < actives.size(); ii++) {
-		if (actives[ii].callback()) {
-			indeces[ii] = (Uint32)-1;
-		}
-	}
-
-	{
-		std::unique_lock<std::mutex> lk(_queueMutex);
-		for (auto it = indeces.begin(); it != indeces.end(); ++it) {
-			if (*it != (Uint32)-1) {
-				_callbacks.erase(*it);
-			}
-		}
-	}
+    drainCallbacks();
+    
+    // Gather what is due, as the callbacks may schedule more
+    Uint64 begin = _clock+1;
+    _clock += millis;
+    Uint64 count = std::min((Uint64)millis, (Uint64)CU_CALLBACK_WHEEL);
+    Callback* ready = nullptr;
+    for (Uint64 tick = begin; tick < begin+count; tick++) {
+        Callback* item = _wheel[tick % CU_CALLBACK_WHEEL];
+        while (item != nullptr) {
+            Callback* next = item->next;
+            if (item->due <= _clock) {
+                removeCallback(item);
+                item->ready = true;
+                item->link = ready;
+                ready = item;
+            }
+            item = next;
+        }
+    }
+    
+    while (ready != nullptr) {
+        Callback* item = ready;
+        ready = ready->link;
+        // Let earlier callbacks unschedule this one
+        if (_incoming.load(std::memory_order_relaxed) != nullptr) {
+            drainCallbacks();
+        }
+        if (!item->cancelled && item->callback() && !item->cancelled) {
+            item->due = _clock+item->period+1;
+            insertCallback(item);
+        } else {
+            if (!item->cancelled) {
+                _callbacks.erase(item->id);
+            }
+            delete item;
+        }
+    }
 }
 
 
@@ -631,6 +911,29 @@ void Application::setFPS(float fps) {
     _delay = (int)(1000.0f/_fps);
 }
 
+/**
+ * Sets the frames per second of this application while it is idle.
+ *
+ * An application is idle when {@link needsRedraw()} has returned false
+ * for a number of frames in a row, and no callback is due before the
+ * next idle frame. It then calls update() at this rate, and sleeps in
+ * between. Input still wakes the application up right
+ * away, as it checks for events at the target FPS while it sleeps. The
+ * application returns to the target FPS as soon as it has something
+ * to draw.
+ *
+ * This method may be safely changed at any time while the application
+ * is running.
+ *
+ * By default, this value is 10.
+ *
+ * @param fps   The frames per second while idle
+ */
+void Application::setIdleFPS(float fps) {
+    _idleFPS = fps;
+    _idleDelay = (int)(1000.0f/_idleFPS);
+}
+
 /**
  * Returns the average frames per second over the last 10 frames.
  *
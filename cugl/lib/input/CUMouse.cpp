@@ -44,6 +44,7 @@ void Mouse::dispose() {
     _dragListeners.clear();
     _moveListeners.clear();
     _wheelListeners.clear();
+    _history.clear();
 }
 
 
@@ -411,6 +412,7 @@ void Mouse::clearState() {
     _lastState = _currState;
     _lastPoint = _currPoint;
     _wheelOffset.setZero();
+    _history.clear();
 }
 
 /**
@@ -431,6 +433,7 @@ bool Mouse::updateState(const SDL_Event& event, const Timestamp& stamp) {
 				MouseEvent mevent(SDL_BUTTON(event.button.button), Vec2((float)event.button.x, (float)event.button.y), stamp);
                 _currPoint  = mevent.position;
                 _currState -= mevent.buttons;
+                _history.emplace_back(MouseRecord::Type::RELEASE,mevent);
                 for(auto it = _releaseListeners.begin(); it != _releaseListeners.end(); ++it) {
                     it->second(mevent,event.button.clicks,it->first == _focus);
                 }
@@ -441,6 +444,7 @@ bool Mouse::updateState(const SDL_Event& event, const Timestamp& stamp) {
                 MouseEvent mevent(SDL_BUTTON(event.button.button),Vec2((float)event.button.x, (float)event.button.y),stamp);
                 _currPoint  = mevent.position;
                 _currState |= mevent.buttons;
+                _history.emplace_back(MouseRecord::Type::PRESS,mevent);
                 for(auto it = _pressListeners.begin(); it != _pressListeners.end(); ++it) {
                     it->second(mevent,event.button.clicks,it->first == _focus);
                 }
@@ -452,6 +456,8 @@ bool Mouse::updateState(const SDL_Event& event, const Timestamp& stamp) {
                     MouseEvent mevent(SDL_BUTTON(event.button.button),Vec2((float)event.button.x, (float)event.button.y),stamp);
                     Vec2 previous((float)(event.motion.x-event.motion.xrel),(float)(event.motion.y-event.motion.yrel));
                     _currPoint = mevent.position;
+                    _history.emplace_back(MouseRecord::Type::MOTION,
+                                          MouseEvent(event.motion.state,mevent.position,stamp));
                     for(auto it = _dragListeners.begin(); it != _dragListeners.end(); ++it) {
                         it->second(mevent,previous,it->first == _focus);
                     }
@@ -459,6 +465,8 @@ bool Mouse::updateState(const SDL_Event& event, const Timestamp& stamp) {
                     MouseEvent mevent(SDL_BUTTON(event.button.button),Vec2((float)event.button.x, (float)event.button.y),stamp);
                     Vec2 previous((float)(event.motion.x-event.motion.xrel),(float)(event.motion.y-event.motion.yrel));
                     _currPoint = mevent.position;
+                    _history.emplace_back(MouseRecord::Type::MOTION,
+                                          MouseEvent(event.motion.state,mevent.position,stamp));
                     for(auto it = _dragListeners.begin(); it != _dragListeners.end(); ++it) {
                         it->second(mevent,previous,it->first == _focus);
                     }
@@ -42,6 +42,7 @@ using namespace cugl;
 void Touchscreen::dispose() {
     _current.clear();
     _previous.clear();
+    _history.clear();
     _beginListeners.clear();
     _finishListeners.clear();
     _moveListeners.clear();
@@ -326,6 +327,7 @@ bool Touchscreen::removeMotionListener(Uint32 key) {
 void Touchscreen::clearState() {
     _previous.clear();
     _previous.insert(_current.begin(),_current.end());
+    _history.clear();
 }
 
 /**
@@ -349,6 +351,7 @@ bool Touchscreen::updateState(const SDL_Event& event, const Timestamp& stamp) {
             tevent.position *= Application::get()->getDisplayBounds().size;
             tevent.position += Application::get()->getDisplayBounds().origin;
             _current[tevent.touch] = tevent.position;
+            _history.emplace_back(TouchRecord::Type::BEGIN,tevent);
             for(auto it = _beginListeners.begin(); it != _beginListeners.end(); ++it) {
                 it->second(tevent,it->first == _focus);
             }
@@ -362,6 +365,7 @@ bool Touchscreen::updateState(const SDL_Event& event, const Timestamp& stamp) {
             tevent.position *= Application::get()->getDisplayBounds().size;
             tevent.position += Application::get()->getDisplayBounds().origin;
             _current.erase(tevent.touch);
+            _history.emplace_back(TouchRecord::Type::END,tevent);
             for(auto it = _finishListeners.begin(); it != _finishListeners.end(); ++it) {
                 it->second(tevent,it->first == _focus);
             }
@@ -381,6 +385,7 @@ bool Touchscreen::updateState(const SDL_Event& event, const Timestamp& stamp) {
             previous += origin;
 
             _current[tevent.touch] = tevent.position;
+            _history.emplace_back(TouchRecord::Type::MOTION,tevent);
             for(auto it = _moveListeners.begin(); it != _moveListeners.end(); ++it) {
                 it->second(tevent,previous,it->first == _focus);
             }
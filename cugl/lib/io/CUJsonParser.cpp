@@ -0,0 +1,488 @@
+//
+//  CUJsonParser.cpp
+//  Cornell University Game Library (CUGL)
+//
+//  This module provides a streaming (pull) parser for JSON text.  Unlike
+//  JsonReader, it does not build a tree of JsonValue objects.  Instead, the
+//  caller pulls one event at a time (begin object, key, number, and so on)
+//  and builds whatever compact structure it needs directly.  This avoids the
+//  intermediate DOM, which is significant for files like levels that are
+//  mostly large arrays of integers.
+//
+//  The parser is strict JSON.  It does not support comments or trailing
+//  commas, and it expects the text to hold a single JSON value.
+//
+//  This class uses our standard shared-pointer architecture.
+//
+//  1. The constructor does not perform any initialization; it just sets all
+//     attributes to their defaults.
+//
+//  2. All initialization takes place via init methods, which can fail if an
+//     object is initialized more than once.
+//
+//  3. All allocation takes place via static constructors which return a shared
+//     pointer.
+//
+//  CUGL MIT License:
+//      This software is provided 'as-is', without any express or implied
+//      warranty.  In no event will the authors be held liable for any damages
+//      arising from the use of this software.
+//
+//      Permission is granted to anyone to use this software for any purpose,
+//      including commercial applications, and to alter it and redistribute it
+//      freely, subject to the following restrictions:
+//
+//      1. The origin of this software must not be misrepresented; you must not
+//      claim that you wrote the original software. If you use this software
+//      in a product, an acknowledgment in the product documentation would be
+//      appreciated but is not required.
+//
+//      2. Altered source versions must be plainly marked as such, and must not
+//      be misrepresented as being the original software.
+//
+//      3. This notice may not be removed or altered from any source distribution.
+//
+//  Author: Dragonglass Studios
+//  Version: 10/18/26
+//
+#include <cugl/io/CUJsonParser.h>
+#include <cugl/io/CUTextReader.h>
+#include <cugl/util/CUDebug.h>
+#include <cstdlib>
+#include <cstring>
+
+using namespace cugl;
+
+#pragma mark Constructors
+/**
+ * Creates a parser with no text.
+ *
+ * NEVER USE A CONSTRUCTOR WITH NEW. If you want to allocate an object on
+ * the heap, use one of the static constructors instead.
+ */
+JsonParser::JsonParser() :
+_pos(0),
+_first(false),
+_keyed(false),
+_started(false),
+_event(Event::END),
+_number(0),
+_boolean(false) {
+}
+
+/**
+ * Initializes this parser with the given JSON text.
+ *
+ * The text is copied, so the parser is safe to use after the string
+ * is released.
+ *
+ * @param text  The JSON text
+ *
+ * @return true if the parser is initialized properly
+ */
+bool JsonParser::init(const std::string& text) {
+    _text = text;
+    _pos = 0;
+    _stack.clear();
+    _first = false;
+    _keyed = false;
+    _started = false;
+    _event = Event::END;
+    _error.clear();
+    return true;
+}
+
+/**
+ * Initializes this parser with the contents of the given asset file.
+ *
+ * The file name is relative to the asset directory.
+ *
+ * @param file  The JSON file in the asset directory
+ *
+ * @return true if the parser is initialized properly
+ */
+bool JsonParser::initWithAsset(const std::string& file) {
+    std::shared_ptr<TextReader> reader = TextReader::allocWithAsset(file);
+    if (reader == nullptr) {
+        return false;
+    }
+    std::string text;
+    reader->readAll(text);
+    reader->close();
+    return init(text);
+}
+
+/**
+ * Releases the text and resets all state.
+ */
+void JsonParser::dispose() {
+    _text.clear();
+    _text.shrink_to_fit();
+    _string.clear();
+    _stack.clear();
+    _pos = 0;
+    _started = false;
+    _event = Event::END;
+}
+
+#pragma mark -
+#pragma mark Internal Helpers
+/**
+ * Skips any whitespace at the current position.
+ */
+void JsonParser::skipSpace() {
+    while (_pos < _text.size()) {
+        char c = _text[_pos];
+        if (c != ' ' && c != '\t' && c != '\n' && c != '\r') {
+            return;
+        }
+        _pos++;
+    }
+}
+
+/**
+ * Marks the parser as failed with the given message.
+ *
+ * @param message   The error message
+ *
+ * @return {@link Event#ERROR}
+ */
+JsonParser::Event JsonParser::fail(const std::string& message) {
+    _error = message + " at offset " + std::to_string(_pos);
+    _event = Event::ERROR;
+    return _event;
+}
+
+/**
+ * Reads the literal word at the current position.
+ *
+ * @param word  The expected word
+ *
+ * @return true if the word was read successfully
+ */
+bool JsonParser::readWord(const char* word) {
+    size_t len = std::strlen(word);
+    if (_text.compare(_pos, len, word) != 0) {
+        return false;
+    }
+    _pos += len;
+    return true;
+}
+
+/**
+ * Reads four hexadecimal digits at the given position.
+ *
+ * @param pos   The position of the first digit
+ * @param code  The value of the digits
+ *
+ * @return true if there were four hexadecimal digits
+ */
+bool JsonParser::readHex(size_t pos, Uint32& code) const {
+    if (pos+4 > _text.size()) {
+        return false;
+    }
+    code = 0;
+    for(size_t ii = pos; ii < pos+4; ii++) {
+        char c = _text[ii];
+        code <<= 4;
+        if (c >= '0' && c <= '9') {
+            code |= (Uint32)(c-'0');
+        } else if (c >= 'a' && c <= 'f') {
+            code |= (Uint32)(c-'a'+10);
+        } else if (c >= 'A' && c <= 'F') {
+            code |= (Uint32)(c-'A'+10);
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Returns the length of the JSON number at the current position.
+ *
+ * This follows the JSON grammar exactly, so it rejects the leading
+ * plus signs, leading zeroes, hexadecimal values and special values
+ * that strtod would accept.
+ *
+ * @return the length of the JSON number (0 if there is no number)
+ */
+size_t JsonParser::scanNumber() const {
+    // std::string guarantees null termination, so we may look one past the end
+    const char* text = _text.c_str();
+    size_t pos = _pos;
+    if (text[pos] == '-') {
+        pos++;
+    }
+    if (text[pos] == '0') {
+        pos++;
+    } else if (text[pos] >= '1' && text[pos] <= '9') {
+        while (text[pos] >= '0' && text[pos] <= '9') { pos++; }
+    } else {
+        return 0;
+    }
+    if (text[pos] == '.') {
+        pos++;
+        if (text[pos] < '0' || text[pos] > '9') {
+            return 0;
+        }
+        while (text[pos] >= '0' && text[pos] <= '9') { pos++; }
+    }
+    if (text[pos] == 'e' || text[pos] == 'E') {
+        pos++;
+        if (text[pos] == '+' || text[pos] == '-') {
+            pos++;
+        }
+        if (text[pos] < '0' || text[pos] > '9') {
+            return 0;
+        }
+        while (text[pos] >= '0' && text[pos] <= '9') { pos++; }
+    }
+    return pos-_pos;
+}
+
+/**
+ * Reads a quoted string at the current position into {@link _string}.
+ *
+ * @return true if the string was read successfully
+ */
+bool JsonParser::readString() {
+    _string.clear();
+    _pos++; // Opening quote
+    while (_pos < _text.size()) {
+        char c = _text[_pos++];
+        if (c == '"') {
+            return true;
+        } else if (c != '\\') {
+            _string.push_back(c);
+            continue;
+        } else if (_pos >= _text.size()) {
+            return false;
+        }
+
+        c = _text[_pos++];
+        switch (c) {
+            case '"':
+            case '\\':
+            case '/':
+                _string.push_back(c);
+                break;
+            case 'b':
+                _string.push_back('\b');
+                break;
+            case 'f':
+                _string.push_back('\f');
+                break;
+            case 'n':
+                _string.push_back('\n');
+                break;
+            case 'r':
+                _string.push_back('\r');
+                break;
+            case 't':
+                _string.push_back('\t');
+                break;
+            case 'u':
+            {
+                Uint32 code = 0;
+                if (!readHex(_pos,code)) {
+                    return false;
+                }
+                _pos += 4;
+                // Combine a surrogate pair if present
+                Uint32 low = 0;
+                if (code >= 0xD800 && code < 0xDC00 && _pos+6 <= _text.size() &&
+                    _text[_pos] == '\\' && _text[_pos+1] == 'u') {
+                    if (!readHex(_pos+2,low)) {
+                        return false;
+                    }
+                    if (low >= 0xDC00 && low < 0xE000) {
+                        code = 0x10000+((code-0xD800) << 10)+(low-0xDC00);
+                        _pos += 6;
+                    }
+                }
+                // Encode as UTF8
+                if (code < 0x80) {
+                    _string.push_back((char)code);
+                } else if (code < 0x800) {
+                    _string.push_back((char)(0xC0 | (code >> 6)));
+                    _string.push_back((char)(0x80 | (code & 0x3F)));
+                } else if (code < 0x10000) {
+                    _string.push_back((char)(0xE0 | (code >> 12)));
+                    _string.push_back((char)(0x80 | ((code >> 6) & 0x3F)));
+                    _string.push_back((char)(0x80 | (code & 0x3F)));
+                } else {
+                    _string.push_back((char)(0xF0 | (code >> 18)));
+                    _string.push_back((char)(0x80 | ((code >> 12) & 0x3F)));
+                    _string.push_back((char)(0x80 | ((code >> 6) & 0x3F)));
+                    _string.push_back((char)(0x80 | (code & 0x3F)));
+                }
+            }
+                break;
+            default:
+                return false;
+        }
+    }
+    return false;
+}
+
+/**
+ * Returns the event for the value at the current position.
+ *
+ * @return the event for the value at the current position.
+ */
+JsonParser::Event JsonParser::readValue() {
+    _keyed = false;
+    if (_pos >= _text.size()) {
+        return fail("Unexpected end of text");
+    }
+
+    char c = _text[_pos];
+    switch (c) {
+        case '{':
+            _pos++;
+            _stack.push_back('{');
+            _first = true;
+            _event = Event::BEGIN_OBJECT;
+            break;
+        case '[':
+            _pos++;
+            _stack.push_back('[');
+            _first = true;
+            _event = Event::BEGIN_ARRAY;
+            break;
+        case '"':
+            if (!readString()) {
+                return fail("Malformed string");
+            }
+            _event = Event::STRING;
+            break;
+        case 't':
+        case 'f':
+            if (!readWord(c == 't' ? "true" : "false")) {
+                return fail("Unknown literal");
+            }
+            _boolean = (c == 't');
+            _event = Event::BOOLEAN;
+            break;
+        case 'n':
+            if (!readWord("null")) {
+                return fail("Unknown literal");
+            }
+            _event = Event::NIL;
+            break;
+        default:
+        {
+            size_t len = scanNumber();
+            if (len == 0) {
+                return fail(c == '-' || (c >= '0' && c <= '9') ? "Malformed number" : "Unexpected character");
+            }
+            // The number is valid JSON, so strtod reads exactly the same text
+            const char* start = _text.c_str()+_pos;
+            char* end = nullptr;
+            _number = std::strtod(start, &end);
+            if (end != start+len) {
+                return fail("Malformed number");
+            }
+            _pos += len;
+            _event = Event::NUMBER;
+        }
+            break;
+    }
+    return _event;
+}
+
+#pragma mark -
+#pragma mark Parsing
+/**
+ * Returns the next event in the text.
+ *
+ * After a {@link Event#KEY}, the next event is always the value for that
+ * key.  Once the whole value has been read, this returns {@link Event#END}.
+ *
+ * @return the next event in the text.
+ */
+JsonParser::Event JsonParser::next() {
+    if (_event == Event::ERROR) {
+        return _event;
+    }
+
+    skipSpace();
+    if (_stack.empty()) {
+        if (!_started) {
+            _started = true;
+            return readValue();
+        }
+        if (_pos < _text.size()) {
+            return fail("Unexpected text after value");
+        }
+        _event = Event::END;
+        return _event;
+    }
+
+    if (_keyed) {
+        return readValue();
+    }
+
+    bool object = (_stack.back() == '{');
+    char close  = object ? '}' : ']';
+    if (_pos < _text.size() && _text[_pos] == close) {
+        _pos++;
+        _stack.pop_back();
+        _first = false;
+        _event = object ? Event::END_OBJECT : Event::END_ARRAY;
+        return _event;
+    }
+
+    if (!_first) {
+        if (_pos >= _text.size() || _text[_pos] != ',') {
+            return fail(object ? "Expected ',' or '}'" : "Expected ',' or ']'");
+        }
+        _pos++;
+        skipSpace();
+        if (_pos < _text.size() && _text[_pos] == close) {
+            return fail("Trailing comma");
+        }
+    }
+    _first = false;
+
+    if (!object) {
+        return readValue();
+    }
+
+    if (_pos >= _text.size() || _text[_pos] != '"' || !readString()) {
+        return fail("Expected a key");
+    }
+    skipSpace();
+    if (_pos >= _text.size() || _text[_pos] != ':') {
+        return fail("Expected ':'");
+    }
+    _pos++;
+    _keyed = true;
+    _event = Event::KEY;
+    return _event;
+}
+
+/**
+ * Skips the current value.
+ *
+ * If the last event was {@link Event#KEY}, this skips the value for that
+ * key.  If it began an object or array, this skips to (and consumes) the
+ * matching end.  Otherwise it does nothing, as scalars are already read.
+ *
+ * @return false if the parser failed while skipping
+ */
+bool JsonParser::skip() {
+    if (_event == Event::KEY) {
+        next();
+    }
+    if (_event == Event::BEGIN_OBJECT || _event == Event::BEGIN_ARRAY) {
+        size_t depth = _stack.size()-1;
+        while (_stack.size() > depth) {
+            if (next() == Event::ERROR) {
+                return false;
+            }
+        }
+    }
+    return _event != Event::ERROR;
+}
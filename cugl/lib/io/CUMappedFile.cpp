@@ -0,0 +1,149 @@
+//
+//  CUMappedFile.cpp
+//  Cornell University Game Library (CUGL)
+//
+//  This module provides read-only access to the whole contents of a file as
+//  a single block of memory.  Where the platform allows it, the file is
+//  memory mapped, so opening it costs nothing until the pages are touched,
+//  and the pages are shared with the file cache.  On platforms where the
+//  assets are not ordinary files (such as Android), or that lack mmap (such
+//  as Windows), the file is read into a single buffer instead.
+//
+//  This is the backing store for packed binary assets like sound banks and
+//  compiled levels, which are parsed in place rather than copied.
+//
+//  This class uses our standard shared-pointer architecture.
+//
+//  1. The constructor does not perform any initialization; it just sets all
+//     attributes to their defaults.
+//
+//  2. All initialization takes place via init methods, which can fail if an
+//     object is initialized more than once.
+//
+//  3. All allocation takes place via static constructors which return a shared
+//     pointer.
+//
+//  CUGL MIT License:
+//      This software is provided 'as-is', without any express or implied
+//      warranty.  In no event will the authors be held liable for any damages
+//      arising from the use of this software.
+//
+//      Permission is granted to anyone to use this software for any purpose,
+//      including commercial applications, and to alter it and redistribute it
+//      freely, subject to the following restrictions:
+//
+//      1. The origin of this software must not be misrepresented; you must not
+//      claim that you wrote the original software. If you use this software
+//      in a product, an acknowledgment in the product documentation would be
+//      appreciated but is not required.
+//
+//      2. Altered source versions must be plainly marked as such, and must not
+//      be misrepresented as being the original software.
+//
+//      3. This notice may not be removed or altered from any source distribution.
+//
+//  Author: Dragonglass Studios
+//  Version: 10/18/26
+//
+#include <cugl/io/CUMappedFile.h>
+#include <cugl/util/CUDebug.h>
+
+// Android assets live inside the APK and Windows lacks mmap, so those
+// platforms read the file into a single buffer instead.
+#if !defined (__WINDOWS__) && !defined (__ANDROID__)
+    #define CU_MAPPED_FILE_MMAP 1
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+using namespace cugl;
+
+#pragma mark Constructors
+/**
+ * Creates a degenerate file with no contents.
+ *
+ * NEVER USE A CONSTRUCTOR WITH NEW. If you want to allocate an object on
+ * the heap, use one of the static constructors instead.
+ */
+MappedFile::MappedFile() :
+_data(nullptr),
+_size(0),
+_mapped(false) {
+}
+
+/**
+ * Initializes this file with the contents of the given path.
+ *
+ * The file is memory mapped where the platform allows it.  Otherwise it
+ * is read into a single buffer.  Empty files fail to initialize.
+ *
+ * @param file  The path of the file
+ *
+ * @return true if the file was opened successfully
+ */
+bool MappedFile::init(const std::string& file) {
+    CUAssertLog(_data == nullptr, "File is already initialized");
+    _name = file;
+
+#if defined (CU_MAPPED_FILE_MMAP)
+    int fd = open(file.c_str(), O_RDONLY);
+    if (fd >= 0) {
+        struct stat info;
+        if (fstat(fd, &info) == 0 && info.st_size > 0) {
+            void* addr = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (addr != MAP_FAILED) {
+                _data = (Uint8*)addr;
+                _size = (size_t)info.st_size;
+                _mapped = true;
+            }
+        }
+        close(fd);
+    }
+#endif
+
+    if (_data == nullptr) {
+        SDL_RWops* source = SDL_RWFromFile(file.c_str(), "rb");
+        if (source == nullptr) {
+            CULogError("Could not open '%s': %s", file.c_str(), SDL_GetError());
+            return false;
+        }
+        Sint64 size = SDL_RWsize(source);
+        if (size > 0) {
+            _data = (Uint8*)SDL_malloc((size_t)size);
+            _size = (size_t)size;
+            if (SDL_RWread(source, _data, 1, _size) != _size) {
+                SDL_free(_data);
+                _data = nullptr;
+                _size = 0;
+            }
+        }
+        SDL_RWclose(source);
+    }
+    return _data != nullptr;
+}
+
+/**
+ * Releases the contents of this file.
+ *
+ * Any pointer previously returned by {@link data()} is invalid after
+ * this call.
+ */
+void MappedFile::dispose() {
+    if (_data != nullptr) {
+#if defined (CU_MAPPED_FILE_MMAP)
+        if (_mapped) {
+            munmap(_data, _size);
+        } else {
+            SDL_free(_data);
+        }
+#else
+        SDL_free(_data);
+#endif
+    }
+    _data = nullptr;
+    _size = 0;
+    _mapped = false;
+    _name.clear();
+}
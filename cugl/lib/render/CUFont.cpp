@@ -55,6 +55,8 @@ using namespace cugl;
 
 /** The amount of border to put around a glyph to prevent bleeding. */
 #define GLYPH_BORDER    2
+/** The resolution of glyphs measured for a distance field, relative to the atlas */
+#define DISTANCE_SCALE  4
 
 #pragma mark -
 #pragma mark Constructors
@@ -68,6 +70,7 @@ Font::Font() :
 _name(""),
 _stylename(""),
 _size(0),
+_source(""),
 _data(nullptr),
 _fontHeight(0),
 _fontAscent(0),
@@ -78,6 +81,7 @@ _useKerning(true),
 _style(Style::NORMAL),
 _hints(Hinting::NORMAL),
 _render(Resolution::BLENDED),
+_spread(0),
 _hasAtlas(false),
 _surface(nullptr) { }
 
@@ -93,6 +97,7 @@ void Font::dispose() {
     _name = "";
     _stylename = "";
     _size = 0;
+    _source = "";
     _data = nullptr;
     _fontHeight = 0;
     _fontAscent = 0;
@@ -103,12 +108,14 @@ void Font::dispose() {
     _style  = Style::NORMAL;
     _hints  = Hinting::NORMAL;
     _render = Resolution::BLENDED;
+    _spread = 0;
     _hasAtlas = false;
     _texture = nullptr;
     _glyphset.clear();
     _glyphsize.clear();
     _glyphmap.clear();
-    _kernmap.clear();
+    _glyphtable.clear();
+    _kerntable.clear();
 }
 
 /**
@@ -135,6 +142,7 @@ bool Font::init(const std::string file, int size) {
         return false;
     }
     _size = size;
+    _source = fullpath;
     char* strng = TTF_FontFaceFamilyName(_data);
     _name = std::string(strng);
 
@@ -171,7 +179,7 @@ bool Font::init(const std::string file, int size) {
  */
 bool Font::hasGlyph(Uint32 a) const {
     if (_hasAtlas) {
-        return _glyphmap.find(a) != _glyphmap.end();
+        return findGlyph(a) != nullptr;
     }
     
     return TTF_GlyphIsProvided(_data, (Uint16)a) != 0;
@@ -273,8 +281,8 @@ void Font::setHinting(Hinting hinting) {
  */
 const Font::Metrics Font::getMetrics(Uint32 thechar) const {
     if (_hasAtlas) {
-        CUAssertLog(_glyphmap.find(thechar) != _glyphmap.end(), "Character '%c' is not supported", thechar);
-        return _glyphsize.at(thechar);
+        CUAssertLog(findGlyph(thechar), "Character '%c' is not supported", thechar);
+        return getAtlasMetrics(thechar);
     }
     
     CUAssertLog(TTF_GlyphIsProvided(_data, (Uint16)thechar), "Character '%c' is not supported", thechar);
@@ -299,9 +307,9 @@ const Font::Metrics Font::getMetrics(Uint32 thechar) const {
  */
 unsigned int Font::getKerning(Uint32 a, Uint32 b) const {
     if (_hasAtlas) {
-        CUAssertLog(_glyphmap.find(a) != _glyphmap.end(), "Character '%c' is not supported", a);
-        CUAssertLog(_glyphmap.find(b) != _glyphmap.end(), "Character '%c' is not supported", b);
-        return _kernmap.at(a).at(b);
+        CUAssertLog(findGlyph(a), "Character '%c' is not supported", a);
+        CUAssertLog(findGlyph(b), "Character '%c' is not supported", b);
+        return getAtlasKerning(a, b);
     }
     
     CUAssertLog(TTF_GlyphIsProvided(_data, (Uint16)a), "Character '%c' is not supported", a);
@@ -391,7 +399,8 @@ void Font::clearAtlas() {
     _glyphmap.clear();
     _glyphset.clear();
     _glyphsize.clear();
-    _kernmap.clear();
+    _glyphtable.clear();
+    _kerntable.clear();
     _hasAtlas = false;
 }
 
@@ -418,6 +427,7 @@ bool Font::buildAtlasAsync() {
     prepareAtlasKerning();
     computeAtlasSize(&width,&height);
     _hasAtlas = generateSurface(width,height);
+    prepareGlyphTable();
     return _hasAtlas;
 }
 
@@ -446,6 +456,7 @@ bool Font::buildAtlasAsync(const std::string charset) {
     prepareAtlasKerning();
     computeAtlasSize(&width,&height);
     _hasAtlas = generateSurface(width,height);
+    prepareGlyphTable();
     return _hasAtlas;
 }
 
@@ -502,6 +513,7 @@ std::shared_ptr<Texture> Font::getMesh(const std::string text, const Vec2 origin
                                        Mesh<SpriteVertex2>& mesh, bool utf8) {
     Rect bounds(origin,getSize(text));
     if (_hasAtlas) {
+        bounds.expand((float)_spread);
         getAtlasMesh(text,origin,bounds,mesh,utf8);
         return _texture;
     }
@@ -574,6 +586,7 @@ std::shared_ptr<Texture> Font::getMesh(const std::string text, const Vec2 origin
 std::shared_ptr<Texture> Font::getQuad(Uint32 thechar, Vec2& offset, Mesh<SpriteVertex2>& mesh) {
     Rect bounds(offset.x,offset.y, (float)getMetrics(thechar).advance, (float)_fontHeight);
     if (_hasAtlas) {
+        bounds.expand((float)_spread);
         getAtlasQuad(thechar,offset,bounds,mesh);
         return _texture;
     }
@@ -650,6 +663,7 @@ std::shared_ptr<Texture> Font::getMesh(const std::string text, const Vec2 origin
                                        Mesh<SpriteVertex3>& mesh, float z, bool utf8) {
     Rect bounds(origin,getSize(text));
     if (_hasAtlas) {
+        bounds.expand((float)_spread);
         getAtlasMesh(text,origin,bounds,mesh,z,utf8);
         return _texture;
     }
@@ -724,6 +738,7 @@ std::shared_ptr<Texture> Font::getMesh(const std::string text, const Vec2 origin
 std::shared_ptr<Texture> Font::getQuad(Uint32 thechar, Vec2& offset, Mesh<SpriteVertex3>& mesh, float z) {
     Rect bounds(offset.x,offset.y, (float)getMetrics(thechar).advance, (float)_fontHeight);
     if (_hasAtlas) {
+        bounds.expand((float)_spread);
         getAtlasQuad(thechar,offset,bounds,mesh,z);
         return _texture;
     }
@@ -800,7 +815,7 @@ void Font::getAtlasMesh(const std::string text, const Vec2 origin, const Rect re
     if (!utf8) {
         for(int ii = 0; ii < line.size(); ii++) {
             if (ii > 0) {
-                offset.x -= _kernmap[line[ii-1]][line[ii]];
+                offset.x -= getAtlasKerning(line[ii-1],line[ii]);
             }
             ii = (getAtlasQuad(line[ii],offset,rect,mesh) ? ii+1 : (int)line.size());
         }
@@ -814,7 +829,7 @@ void Font::getAtlasMesh(const std::string text, const Vec2 origin, const Rect re
     
     for(int ii = 0; ii < utf32.size();) {
         if (ii > 0) {
-            offset.x -= _kernmap[utf32[ii-1]][utf32[ii]];
+            offset.x -= getAtlasKerning(utf32[ii-1],utf32[ii]);
         }
         ii = (getAtlasQuad(utf32[ii],offset,rect,mesh) ? ii+1 : (int)utf32.size());
     }
@@ -957,14 +972,18 @@ bool Font::getAtlasQuad(Uint32 thechar, Vec2& offset, const Rect rect, Mesh<Spri
     CUAssertLog(mesh.command == GL_TRIANGLES, "The mesh is not formatted for triangles");
 
     // Technically, this answer is correct
-    if (!hasGlyph(thechar)) { return true; }
+    const Rect* glyph = findGlyph(thechar);
+    if (glyph == nullptr) { return true; }
     
-    Rect bounds = _glyphmap[thechar];
-    Rect quad(offset,bounds.size);
+    // A distance field glyph has a frame of the spread around it
+    Rect bounds = *glyph;
+    Vec2 start(offset.x-_spread,offset.y-_spread);
+    Rect quad(start,bounds.size);
+    float advance = bounds.size.width-2*_spread;
     
     // Skip over glyph, but recognize we may have later glyphs
     if (!rect.doesIntersect(quad)) {
-        offset.x += bounds.size.width;
+        offset.x += advance;
         return quad.getMaxX() <= rect.getMaxX();
     }
     
@@ -973,10 +992,10 @@ bool Font::getAtlasQuad(Uint32 thechar, Vec2& offset, const Rect rect, Mesh<Spri
     bool result = quad.getMaxX() <= rect.getMaxX();
     
     // REMEMBER! Bounds and rect have different y-orientations.
-    bounds.origin.x += quad.origin.x-offset.x;
-    bounds.origin.y -= quad.origin.y+quad.size.height-offset.y-bounds.size.height;
+    bounds.origin.x += quad.origin.x-start.x;
+    bounds.origin.y -= quad.origin.y+quad.size.height-start.y-bounds.size.height;
     
-    offset.x += bounds.size.width;
+    offset.x += advance;
     bounds.size = quad.size;
     
     int width  = _texture->getWidth();
@@ -1163,7 +1182,7 @@ void Font::getAtlasMesh(const std::string text, const Vec2 origin, const Rect re
     if (!utf8) {
         for(int ii = 0; ii < line.size(); ii++) {
             if (ii > 0) {
-                offset.x -= _kernmap[line[ii-1]][line[ii]];
+                offset.x -= getAtlasKerning(line[ii-1],line[ii]);
             }
             ii = (getAtlasQuad(line[ii],offset,rect,mesh,z) ? ii+1 : (int)line.size());
         }
@@ -1177,7 +1196,7 @@ void Font::getAtlasMesh(const std::string text, const Vec2 origin, const Rect re
     
     for(int ii = 0; ii < utf32.size();) {
         if (ii > 0) {
-            offset.x -= _kernmap[utf32[ii-1]][utf32[ii]];
+            offset.x -= getAtlasKerning(utf32[ii-1],utf32[ii]);
         }
         ii = (getAtlasQuad(utf32[ii],offset,rect,mesh,z) ? ii+1 : (int)utf32.size());
     }
@@ -1328,14 +1347,18 @@ bool Font::getAtlasQuad(Uint32 thechar, Vec2& offset, const Rect rect, Mesh<Spri
     CUAssertLog(mesh.command == GL_TRIANGLES, "The mesh is not formatted for triangles");
 
     // Technically, this answer is correct
-    if (!hasGlyph(thechar)) { return true; }
+    const Rect* glyph = findGlyph(thechar);
+    if (glyph == nullptr) { return true; }
     
-    Rect bounds = _glyphmap[thechar];
-    Rect quad(offset,bounds.size);
+    // A distance field glyph has a frame of the spread around it
+    Rect bounds = *glyph;
+    Vec2 start(offset.x-_spread,offset.y-_spread);
+    Rect quad(start,bounds.size);
+    float advance = bounds.size.width-2*_spread;
     
     // Skip over glyph, but recognize we may have later glyphs
     if (!rect.doesIntersect(quad)) {
-        offset.x += bounds.size.width;
+        offset.x += advance;
         return quad.getMaxX() <= rect.getMaxX();
     }
     
@@ -1344,10 +1367,10 @@ bool Font::getAtlasQuad(Uint32 thechar, Vec2& offset, const Rect rect, Mesh<Spri
     bool result = quad.getMaxX() <= rect.getMaxX();
     
     // REMEMBER! Bounds and rect have different y-orientations.
-    bounds.origin.x += quad.origin.x-offset.x;
-    bounds.origin.y -= quad.origin.y+quad.size.height-offset.y-bounds.size.height;
+    bounds.origin.x += quad.origin.x-start.x;
+    bounds.origin.y -= quad.origin.y+quad.size.height-start.y-bounds.size.height;
     
-    offset.x += bounds.size.width;
+    offset.x += advance;
     bounds.size = quad.size;
     
     int width  = _texture->getWidth();
@@ -1544,9 +1567,9 @@ Size Font::getSizeASCII(const std::string text) const {
     for(int ii = 0; ii < text.size(); ii++) {
         if (hasGlyph(text[ii])) {
             if (ii > 0) {
-                result.width -= _kernmap.at((Uint32)text[ii-1]).at((Uint32)text[ii]);
+                result.width -= getAtlasKerning((Uint32)text[ii-1],(Uint32)text[ii]);
             }
-            result.width += _glyphsize.at((Uint32)text[ii]).advance;
+            result.width += getAtlasMetrics((Uint32)text[ii]).advance;
         }
     }
     return result;
@@ -1589,9 +1612,9 @@ Size Font::getSizeUTF8(const std::string text) const {
     for(int ii = 0; ii < utf32.size(); ii++) {
         if (hasGlyph(utf32[ii])) {
             if (ii > 0 && hasGlyph(utf32[ii-1])) {
-                result.width -= _kernmap.at(utf32[ii-1]).at(utf32[ii]);
+                result.width -= getAtlasKerning(utf32[ii-1],utf32[ii]);
             }
-            result.width += _glyphsize.at(utf32[ii]).advance;
+            result.width += getAtlasMetrics(utf32[ii]).advance;
         }
     }
     return result;
@@ -1643,7 +1666,7 @@ Rect Font::getInternalBoundsASCII(const std::string text) const {
     for(int ii = 0; first == 0 && ii < text.size(); ii++) {
         Uint32 ch = (Uint32)text[ii];
         if (hasGlyph(ch)) {
-            metrics = (_hasAtlas ? _glyphsize.at(ch) : computeMetrics(ch));
+            metrics = (_hasAtlas ? getAtlasMetrics(ch) : computeMetrics(ch));
             result.origin.x = (float)metrics.minx;
             result.size.width = (float)metrics.advance-metrics.minx;
             maxy = (metrics.maxy > maxy ? metrics.maxy : maxy);
@@ -1661,8 +1684,8 @@ Rect Font::getInternalBoundsASCII(const std::string text) const {
     for(int ii = first+1; ii < text.size(); ii++) {
         Uint32 ch = (Uint32)text[ii];
         if (hasGlyph(ch)) {
-            result.size.width -= _kernmap.at(last).at(ch);
-            metrics = (_hasAtlas ? _glyphsize.at(ch) : computeMetrics(ch));
+            result.size.width -= (_hasAtlas ? getAtlasKerning(last, ch) : computeKerning(last, ch));
+            metrics = (_hasAtlas ? getAtlasMetrics(ch) : computeMetrics(ch));
             result.size.width += metrics.advance;
             maxy = (metrics.maxy > maxy ? metrics.maxy : maxy);
             miny = (metrics.miny < miny ? metrics.miny : miny);
@@ -1731,7 +1754,7 @@ Rect Font::getInternalBoundsUTF8(const std::string text) const {
     for(int ii = 0; first == -1 && ii < utf32.size(); ii++) {
         Uint32 ch = utf32[ii];
         if (hasGlyph(ch)) {
-            metrics = (_hasAtlas ? _glyphsize.at(ch) : computeMetrics(ch));
+            metrics = (_hasAtlas ? getAtlasMetrics(ch) : computeMetrics(ch));
             result.origin.x = (float)metrics.minx;
             result.size.width = (float)(metrics.advance-metrics.minx);
             maxy = (metrics.maxy > maxy ? metrics.maxy : maxy);
@@ -1749,8 +1772,8 @@ Rect Font::getInternalBoundsUTF8(const std::string text) const {
     for(int ii = first+1; ii < utf32.size(); ii++) {
         Uint32 ch = utf32[ii];
         if (hasGlyph(ch)) {
-            result.size.width -= (_hasAtlas ? _kernmap.at(last).at(ch) : computeKerning(last, ch));
-            metrics = (_hasAtlas ? _glyphsize.at(ch) : computeMetrics(ch));
+            result.size.width -= (_hasAtlas ? getAtlasKerning(last, ch) : computeKerning(last, ch));
+            metrics = (_hasAtlas ? getAtlasMetrics(ch) : computeMetrics(ch));
             result.size.width += metrics.advance;
             maxy = (metrics.maxy > maxy ? metrics.maxy : maxy);
             miny = (metrics.miny < miny ? metrics.miny : miny);
@@ -1786,7 +1809,8 @@ int Font::prepareAtlas() {
         if (TTF_GlyphIsProvided(_data, (Uint16)ii)) {
             Metrics metrics = computeMetrics(ii);
             _glyphsize.emplace(ii,metrics);
-            _glyphmap.emplace(ii,Rect(0,0, (float)(metrics.advance+GLYPH_BORDER), (float)(_fontHeight+GLYPH_BORDER)));
+            _glyphmap.emplace(ii,Rect(0,0, (float)(metrics.advance+2*_spread+GLYPH_BORDER),
+                                      (float)(_fontHeight+2*_spread+GLYPH_BORDER)));
             _glyphset.push_back(ii);
             if (metrics.advance > maxwidth) {
                 maxwidth = metrics.advance;
@@ -1828,7 +1852,8 @@ int Font::prepareAtlas(std::string charset) {
         if (_glyphmap.find(thechar) == _glyphmap.end() && TTF_GlyphIsProvided(_data, (Uint16)thechar)) {
             Metrics metrics = computeMetrics(thechar);
             _glyphsize.emplace(thechar,metrics);
-            _glyphmap.emplace(thechar,Rect(0,0, (float)(metrics.advance+GLYPH_BORDER), (float)(_fontHeight+GLYPH_BORDER)));
+            _glyphmap.emplace(thechar,Rect(0,0, (float)(metrics.advance+2*_spread+GLYPH_BORDER),
+                                           (float)(_fontHeight+2*_spread+GLYPH_BORDER)));
             _glyphset.push_back(thechar);
             if (metrics.advance > maxwidth) {
                 maxwidth = metrics.advance;
@@ -1849,14 +1874,82 @@ int Font::prepareAtlas(std::string charset) {
  * Gathers the kerning information for the atlas.
  */
 void Font::prepareAtlasKerning() {
+    std::vector<KernPair> pairs;
     for(auto it = _glyphset.begin(); it != _glyphset.end(); ++it) {
-        _kernmap.emplace(*it, std::unordered_map<Uint32, Uint32>());
         for(auto jt = _glyphset.begin(); jt != _glyphset.end(); ++jt) {
-            _kernmap[*it].emplace(*jt, computeKerning(*it, *jt));
+            Uint32 value = (Uint32)computeKerning(*it, *jt);
+            if (value != 0) {
+                KernPair pair;
+                pair.key = ((Uint64)*it << 32) | *jt;
+                pair.value = value;
+                pairs.push_back(pair);
+            }
+        }
+    }
+    
+    // Keep the table at most half full, so probes stay short
+    size_t capacity = 16;
+    while (capacity < 2*pairs.size()) {
+        capacity *= 2;
+    }
+    KernPair empty;
+    empty.key = (Uint64)-1;
+    empty.value = 0;
+    _kerntable.assign(capacity, empty);
+    for(auto it = pairs.begin(); it != pairs.end(); ++it) {
+        size_t slot = (size_t)((it->key*0x9E3779B97F4A7C15ull) >> 32) & (capacity-1);
+        while (_kerntable[slot].key != (Uint64)-1) {
+            slot = (slot+1) & (capacity-1);
+        }
+        _kerntable[slot] = *it;
+    }
+}
+
+/**
+ * Copies the atlas data of the ASCII and Latin-1 glyphs to a dense table.
+ *
+ * This must be called once the glyphs have their final place in the atlas.
+ */
+void Font::prepareGlyphTable() {
+    Glyph empty = Glyph();
+    empty.valid = false;
+    _glyphtable.assign(CU_FONT_DENSE, empty);
+    for(auto it = _glyphmap.begin(); it != _glyphmap.end(); ++it) {
+        if (it->first < CU_FONT_DENSE) {
+            Glyph& glyph = _glyphtable[it->first];
+            glyph.bounds = it->second;
+            glyph.metrics = _glyphsize.at(it->first);
+            glyph.valid = true;
         }
     }
 }
 
+/**
+ * Returns the kerning between two characters of the atlas.
+ *
+ * This method returns 0 for any pair that is not in the kerning table.
+ *
+ * @param a     The first Unicode character in the pair
+ * @param b     The second Unicode character in the pair
+ *
+ * @return the kerning between two characters of the atlas.
+ */
+Uint32 Font::getAtlasKerning(Uint32 a, Uint32 b) const {
+    if (_kerntable.empty()) {
+        return 0;
+    }
+    Uint64 key = ((Uint64)a << 32) | b;
+    size_t mask = _kerntable.size()-1;
+    size_t slot = (size_t)((key*0x9E3779B97F4A7C15ull) >> 32) & mask;
+    while (_kerntable[slot].key != (Uint64)-1) {
+        if (_kerntable[slot].key == key) {
+            return _kerntable[slot].value;
+        }
+        slot = (slot+1) & mask;
+    }
+    return 0;
+}
+
 /**
  * Returns the metrics for the given character if available.
  *
@@ -1926,8 +2019,9 @@ int Font::computeKerning(Uint32 a, Uint32 b) const {
  */
 void Font::computeAtlasSize(int* width, int* height) {
     // Make enough room for largest glyph
-    *width  = nextPOT(*width+GLYPH_BORDER);
-    *height = nextPOT(_fontHeight+GLYPH_BORDER);
+    int frame = 2*_spread+GLYPH_BORDER;
+    *width  = nextPOT(*width+frame);
+    *height = nextPOT(_fontHeight+frame);
     
     // Copy the glyphs to make a visited set
     int nrows  = 1;
@@ -1963,8 +2057,8 @@ void Font::computeAtlasSize(int* width, int* height) {
         bool found = false;
 		auto pos = copied.begin();
         for(auto it = copied.begin(); !found && it != copied.end(); ++it) {
-            if (_glyphsize[*it].advance < *width-used[line]) {
-                used[line] += _glyphsize[*it].advance+GLYPH_BORDER;
+            if (_glyphsize[*it].advance+2*(int)_spread < *width-used[line]) {
+                used[line] += _glyphsize[*it].advance+frame;
 				pos = it;
                 found = true;
             }
@@ -2011,11 +2105,11 @@ std::vector< std::vector<Uint32> > Font::planAtlas(int width, int height) {
         
         // Find the largest glyph that will fit on line.
         bool found = false;
-        int fheight = _fontHeight+GLYPH_BORDER;
+        int fheight = _fontHeight+2*_spread+GLYPH_BORDER;
 		auto value = copied.begin();
         for(auto it = copied.begin(); !found && it != copied.end(); ++it) {
             wchar_t thechar = (wchar_t)(*it);
-            int glwidth = _glyphsize[*it].advance+GLYPH_BORDER;
+            int glwidth = _glyphsize[*it].advance+2*_spread+GLYPH_BORDER;
             if (glwidth < left) {
                 result[line].push_back(thechar);
                 _glyphmap[thechar].origin.x = (float)(width-left);
@@ -2055,7 +2149,41 @@ void Font::layoutAtlas(const std::vector< std::vector<Uint32> >& rectangle) {
     srcrect.w = srcrect.h = 2;
     SDL_FillRect(_surface,&srcrect,SDL_MapRGBA(_surface->format, 255, 255, 255, 255));
     
+    // Distance fields are measured on larger glyphs for precise edges
+    TTF_Font* large = nullptr;
+    int scale = 1;
+    if (_spread > 0) {
+        large = TTF_OpenFont(_source.c_str(), _size*DISTANCE_SCALE);
+        if (large != nullptr) {
+            TTF_SetFontStyle(large, TTF_GetFontStyle(_data));
+            TTF_SetFontHinting(large, TTF_GetFontHinting(_data));
+            scale = DISTANCE_SCALE;
+        } else {
+            large = _data;
+        }
+    }
+    
     for(auto it = _glyphset.begin(); it != _glyphset.end(); ++it) {
+        // Resize the boundary now that spacing is safe.
+        _glyphmap[*it].origin.x += GLYPH_BORDER/2;
+        _glyphmap[*it].origin.y += GLYPH_BORDER/2;
+        _glyphmap[*it].size.width  -= GLYPH_BORDER;
+        _glyphmap[*it].size.height -= GLYPH_BORDER;
+        
+        if (_spread > 0) {
+            SDL_Surface* temp = TTF_RenderGlyph_Blended(large, *it, color);
+            if (temp != nullptr && temp->format->format != SDL_PIXELFORMAT_ARGB8888) {
+                SDL_Surface* conv = SDL_ConvertSurfaceFormat(temp, SDL_PIXELFORMAT_ARGB8888, 0);
+                SDL_FreeSurface(temp);
+                temp = conv;
+            }
+            if (temp != nullptr) {
+                generateDistanceField(temp, scale, _glyphmap[*it]);
+                SDL_FreeSurface(temp);
+            }
+            continue;
+        }
+        
 		SDL_Surface* temp = nullptr;
         switch (_render) {
             case Resolution::SOLID:
@@ -2067,12 +2195,6 @@ void Font::layoutAtlas(const std::vector< std::vector<Uint32> >& rectangle) {
                 break;
         }
         
-        // Resize the boundary now that spacing is safe.
-        _glyphmap[*it].origin.x += GLYPH_BORDER/2;
-        _glyphmap[*it].origin.y += GLYPH_BORDER/2;
-        _glyphmap[*it].size.width  -= GLYPH_BORDER;
-        _glyphmap[*it].size.height -= GLYPH_BORDER;
-        
         // Convert to SDL rects
         dstrect.x = (int)_glyphmap[*it].origin.x;
         dstrect.y = (int)_glyphmap[*it].origin.y;
@@ -2087,6 +2209,10 @@ void Font::layoutAtlas(const std::vector< std::vector<Uint32> >& rectangle) {
         SDL_BlitSurface(temp,&srcrect,_surface,&dstrect);
         SDL_FreeSurface(temp);
     }
+    
+    if (large != nullptr && large != _data) {
+        TTF_CloseFont(large);
+    }
 }
 
 /**
@@ -2138,4 +2264,165 @@ SDL_Surface* Font::allocSurface(int width, int height) {
     return result;
 }
 
+#pragma mark -
+#pragma mark Distance Fields
+/** The squared distance to a pixel that has no seed */
+#define SEED_FAR    (1 << 28)
+
+/**
+ * An offset from a pixel to its nearest seed pixel
+ *
+ * This is used by the distance transform in {@link generateDistanceField}.
+ */
+typedef struct {
+    /** The x offset to the seed */
+    int dx;
+    /** The y offset to the seed */
+    int dy;
+    /** The squared distance to the seed */
+    int dist;
+} SeedOffset;
+
+/**
+ * Updates the seed of a pixel from the seed of one of its neighbors.
+ *
+ * @param grid  The seed offsets of the grid
+ * @param w     The grid width
+ * @param h     The grid height
+ * @param x     The x position of the pixel
+ * @param y     The y position of the pixel
+ * @param ox    The x offset of the neighbor
+ * @param oy    The y offset of the neighbor
+ */
+static inline void compareSeed(std::vector<SeedOffset>& grid, int w, int h,
+                               int x, int y, int ox, int oy) {
+    int nx = x+ox;
+    int ny = y+oy;
+    if (nx < 0 || ny < 0 || nx >= w || ny >= h) {
+        return;
+    }
+    const SeedOffset& other = grid[ny*w+nx];
+    if (other.dist == SEED_FAR) {
+        return;
+    }
+    int dx = other.dx+ox;
+    int dy = other.dy+oy;
+    int dist = dx*dx+dy*dy;
+    SeedOffset& self = grid[y*w+x];
+    if (dist < self.dist) {
+        self.dx = dx;
+        self.dy = dy;
+        self.dist = dist;
+    }
+}
+
+/**
+ * Propagates the nearest seed to every pixel of the grid.
+ *
+ * This is the 8-point sequential Euclidean distance transform. It sweeps the
+ * grid down and then up, and is linear in the size of the grid. The result
+ * is off from the exact distance by a fraction of a pixel at worst.
+ *
+ * @param grid  The seed offsets of the grid
+ * @param w     The grid width
+ * @param h     The grid height
+ */
+static void sweepSeeds(std::vector<SeedOffset>& grid, int w, int h) {
+    for(int y = 0; y < h; y++) {
+        for(int x = 0; x < w; x++) {
+            compareSeed(grid,w,h,x,y,-1, 0);
+            compareSeed(grid,w,h,x,y, 0,-1);
+            compareSeed(grid,w,h,x,y,-1,-1);
+            compareSeed(grid,w,h,x,y, 1,-1);
+        }
+        for(int x = w-1; x >= 0; x--) {
+            compareSeed(grid,w,h,x,y, 1, 0);
+        }
+    }
+    for(int y = h-1; y >= 0; y--) {
+        for(int x = w-1; x >= 0; x--) {
+            compareSeed(grid,w,h,x,y, 1, 0);
+            compareSeed(grid,w,h,x,y, 0, 1);
+            compareSeed(grid,w,h,x,y,-1, 1);
+            compareSeed(grid,w,h,x,y, 1, 1);
+        }
+        for(int x = 0; x < w; x++) {
+            compareSeed(grid,w,h,x,y,-1, 0);
+        }
+    }
+}
 
+/**
+ * Writes the distance field of a glyph to its cell in the SDL surface.
+ *
+ * The glyph is measured at a higher resolution than the atlas, so that
+ * the edges are placed more precisely than a pixel. The cell includes a
+ * frame of the spread on each side, so the field is never cut off.
+ *
+ * @param glyph     The glyph rendered at scale times the font size
+ * @param scale     The resolution of the glyph relative to the atlas
+ * @param bounds    The location of the glyph cell in the atlas
+ */
+void Font::generateDistanceField(SDL_Surface* glyph, int scale, const Rect& bounds) {
+    int x0 = (int)bounds.origin.x;
+    int y0 = (int)bounds.origin.y;
+    int width  = (int)bounds.size.width;
+    int height = (int)bounds.size.height;
+    if (width <= 0 || height <= 0) {
+        return;
+    }
+    
+    // The grid is the cell at the resolution of the glyph
+    int w = width*scale;
+    int h = height*scale;
+    int frame = (int)_spread*scale;
+    SeedOffset none = { 0, 0, SEED_FAR };
+    SeedOffset seed = { 0, 0, 0 };
+    std::vector<SeedOffset> inside(w*h,none);
+    std::vector<SeedOffset> outside(w*h,seed);
+    
+    // The glyph is ARGB, so alpha is the high byte of each pixel
+    if (SDL_MUSTLOCK(glyph)) { SDL_LockSurface(glyph); }
+    int gw = std::min(glyph->w,w-frame);
+    int gh = std::min(glyph->h,h-frame);
+    for(int y = 0; y < gh; y++) {
+        const Uint32* row = (const Uint32*)((Uint8*)glyph->pixels+y*glyph->pitch);
+        for(int x = 0; x < gw; x++) {
+            if ((row[x] >> 24) >= 128) {
+                inside[(y+frame)*w+x+frame] = seed;
+                outside[(y+frame)*w+x+frame] = none;
+            }
+        }
+    }
+    if (SDL_MUSTLOCK(glyph)) { SDL_UnlockSurface(glyph); }
+    sweepSeeds(inside,w,h);
+    sweepSeeds(outside,w,h);
+
+    if (SDL_MUSTLOCK(_surface)) { SDL_LockSurface(_surface); }
+    Uint8* pixels = (Uint8*)_surface->pixels;
+    int pitch = _surface->pitch;
+    
+    // The edge lies halfway between an inside and an outside pixel. Each
+    // atlas pixel measures from its center, which is between grid pixels
+    // for an even scale.
+    float half  = (scale % 2 == 0) ? 0.5f : 0.0f;
+    float slope = 0.5f/(_spread*scale);
+    for(int y = 0; y < height; y++) {
+        Uint8* row = pixels+(y0+y)*pitch+4*x0;
+        for(int x = 0; x < width; x++) {
+            int pos = (y*scale+scale/2)*w+x*scale+scale/2;
+            const SeedOffset& nearest = outside[pos].dist > 0 ? outside[pos] : inside[pos];
+            float dx = nearest.dx+half;
+            float dy = nearest.dy+half;
+            float dist = nearest.dist == SEED_FAR ? (float)(w+h) : sqrtf(dx*dx+dy*dy)-0.5f;
+            if (outside[pos].dist == 0) {
+                dist = -dist;
+            }
+            // Alpha is the last byte of a pixel for either byte order
+            float value = std::min(std::max(0.5f+dist*slope,0.0f),1.0f);
+            row[4*x] = row[4*x+1] = row[4*x+2] = 255;
+            row[4*x+3] = (Uint8)(value*255+0.5f);
+        }
+    }
+    if (SDL_MUSTLOCK(_surface)) { SDL_UnlockSurface(_surface); }
+}
@@ -444,6 +444,23 @@ void RenderTarget::begin() {
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
 }
 
+/**
+ * Resumes sending draw commands to this render target.
+ *
+ * This method is like {@link #begin}, except that the output textures
+ * are not cleared. Drawing adds to whatever this render target already
+ * holds, so it can accumulate over several passes.
+ *
+ * It is NOT safe to call a resume/end pair of a render target inside of
+ * another render target.  Render targets do not keep a stack.  They alway
+ * return control to the default render target (the screen) when done.
+ */
+void RenderTarget::resume() {
+    glGetIntegerv(GL_VIEWPORT, _viewport);
+    glBindFramebuffer(GL_FRAMEBUFFER, _framebo);
+    glViewport(0, 0, _width, _height);
+}
+
 /**
  * Stops sendinging draw commands to this render target.
  *
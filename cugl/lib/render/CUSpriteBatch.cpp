@@ -50,6 +50,7 @@
 #include <cugl/render/CUShader.h>
 #include <cugl/render/CUGradient.h>
 #include <cugl/render/CUScissor.h>
+#include <algorithm>
 
 /**
  * Default fragment shader
@@ -88,6 +89,8 @@ using namespace cugl;
 #define TYPE_SCISSOR    4
 /** The drawing type for a (simple) texture blur */
 #define TYPE_GAUSSBLUR  8
+/** The drawing type for a distance field texture */
+#define TYPE_DISTANCE   16
 
 /** The drawing command has changed */
 #define DIRTY_COMMAND       1
@@ -107,8 +110,10 @@ using namespace cugl;
 #define DIRTY_UNIBLOCK      128
 /** The blur step has changed */
 #define DIRTY_BLURSTEP      256
+/** The distance field edge has changed */
+#define DIRTY_DISTEDGE      512
 /** All values have changed */
-#define DIRTY_ALL_VALS      511
+#define DIRTY_ALL_VALS      1023
 
 /**
  * Creates a context of the default uniforms.
@@ -125,6 +130,7 @@ SpriteBatch::Context::Context() {
     perspective->setIdentity();
     texture  = nullptr;
     blurstep = 0;
+    distedge = 0;
     blockptr = -1;
     type = 0;
 }
@@ -147,6 +153,7 @@ SpriteBatch::Context::Context(Context* copy) {
     texture  = copy->texture;
     blockptr = copy->blockptr;
     blurstep = copy->blurstep;
+    distedge = copy->distedge;
     dirty = 0;
 }
 
@@ -167,6 +174,17 @@ SpriteBatch::Context::~Context() {
     type = 0;
 }
 
+/**
+ * Empties this frame, keeping its memory for the next one.
+ */
+void SpriteBatch::Frame::clear() {
+    vertices.clear();
+    indices.clear();
+    contexts.clear();
+    blocks.clear();
+    texture = nullptr;
+}
+
 #pragma mark -
 #pragma mark Constructors
 /**
@@ -188,7 +206,11 @@ _vertSize(0),
 _indxMax(0),
 _indxSize(0),
 _vertTotal(0),
-_callTotal(0) {
+_callTotal(0),
+_deferred(false),
+_recording(_frames),
+_submitted(_frames+1),
+_published((uintptr_t)(_frames+2)) {
     _shader = nullptr;
     _vertbuff = nullptr;
     _unifbuff = nullptr;
@@ -227,6 +249,14 @@ void SpriteBatch::dispose() {
     _vertTotal = 0;
     _callTotal = 0;
     
+    for(int ii = 0; ii < 3; ii++) {
+        _frames[ii].clear();
+    }
+    _deferred = false;
+    _recording = _frames;
+    _submitted = _frames+1;
+    _published = (uintptr_t)(_frames+2);
+    
     _initialized = false;
     _inflight = false;
     _active = false;
@@ -342,24 +372,7 @@ bool SpriteBatch::init(unsigned int capacity, const std::shared_ptr<Shader>& sha
     _unifbuff->setOffset("gdFeathr", 156);
 
     _shader->setUniformBlock("uContext",_unifbuff);
-    
-    
-    //Set all needed uniforms here
-    //TODO:
-    //Vec2 tempVec = ;
-//    _shader->setUniformVec2("uSplatPosition", Vec2(0,0));
-    _shader->setUniformVec2("uS1", Vec2(0,0));
-    _shader->setUniformVec2("uS2", Vec2(0,0));
-    _shader->setUniformVec2("uS3", Vec2(0,0));
-    _shader->setUniformVec2("uS4", Vec2(0,0));
-    _shader->setUniformVec4("uC1", Vec4(0,0,0,0));
-    _shader->setUniformVec4("uC2", Vec4(0,0,0,0));
-    _shader->setUniformVec4("uC3", Vec4(0,0,0,0));
-    _shader->setUniformVec4("uC4", Vec4(0,0,0,0));
-    
-    _shader->setUniformVec2("uViewport", Vec2(0,0));
-    
-    
+
     _context = new Context();
     _context->dirty = DIRTY_ALL_VALS;
     return true;
@@ -402,30 +415,8 @@ void SpriteBatch::setShader(const std::shared_ptr<Shader>& shader) {
     _shader = shader;
     _vertbuff->attach(_shader);
     _shader->setUniformBlock("uContext", _unifbuff);
-    
-    //Initialize vals Not needed i guess?
-    //_shader->setUniformVec2("uSplatPosition", Vec2(0,0));
-}
-
-void SpriteBatch::setViewport(const Vec2 res) {
-    _shader->setUniformVec2("uViewport", res);
-}
-
-
-void SpriteBatch::setSplats(const Vec2 s1, const Vec2 s2, const Vec2 s3, const Vec2 s4, const Vec4 c1, const Vec4 c2, const Vec4 c3, const Vec4 c4){
-//    _shader->setUniformVec2("uSplatPosition", splatPosition);
-    _shader->setUniformVec2("uS1", s1);
-    _shader->setUniformVec2("uS2", s2);
-    _shader->setUniformVec2("uS3", s3);
-    _shader->setUniformVec2("uS4", s4);
-    
-    _shader->setUniformVec4("uC1", c1);
-    _shader->setUniformVec4("uC2", c2);
-    _shader->setUniformVec4("uC3", c3);
-    _shader->setUniformVec4("uC4", c4);
 }
 
-
 /**
  * Sets the active perspective matrix of this sprite batch
  *
@@ -738,6 +729,44 @@ void SpriteBatch::setBlurStep(GLuint step) {
     _context->blurstep = step;
 }
 
+/**
+ * Sets the edge of a distance field texture (0 if not a distance field).
+ *
+ * A distance field texture stores in its alpha how far each pixel is
+ * from the edge of a shape, such as a glyph of a distance field font.
+ * When this value is positive, the alpha of the texture is compared
+ * to this edge, and the shape is cut out with an antialiased border
+ * one screen pixel wide. As this border does not depend on the size
+ * of the texture, the shape stays crisp at any scale.
+ *
+ * An edge of 0.5 draws the shape itself. Lower values grow the shape,
+ * which can be used to draw an outline or glow underneath it, while
+ * higher values shrink it.
+ *
+ * Setting this value to 0 will disable distance fields. This value
+ * is 0 by default.
+ *
+ * @param edge  The edge of a distance field texture
+ */
+void SpriteBatch::setDistanceEdge(GLfloat edge) {
+    if (_context->distedge == edge) {
+        return;
+    }
+    
+    if (_inflight) { record(); }
+    if (edge <= 0) {
+        _context->dirty = _context->dirty | DIRTY_DISTEDGE | DIRTY_DRAWTYPE;
+        _context->type = _context->type & ~TYPE_DISTANCE;
+        edge = 0;
+    } else if (_context->distedge == 0) {
+        _context->dirty = _context->dirty | DIRTY_DISTEDGE | DIRTY_DRAWTYPE;
+        _context->type = _context->type | TYPE_DISTANCE;
+    } else {
+        _context->dirty = _context->dirty | DIRTY_DISTEDGE;
+    }
+    _context->distedge = edge;
+}
+
 
 #pragma mark -
 #pragma mark Rendering
@@ -750,6 +779,12 @@ void SpriteBatch::setBlurStep(GLuint step) {
  * Calling this method will reset the vertex and OpenGL call counters to 0.
  */
 void SpriteBatch::begin() {
+    _active = true;
+    if (_deferred) {
+        // The counters belong to submit
+        return;
+    }
+    
     glDisable(GL_CULL_FACE);
     glDepthMask(true);
     glEnable(GL_BLEND);
@@ -759,7 +794,6 @@ void SpriteBatch::begin() {
     _vertbuff->bind();
     _unifbuff->bind(false);
     _unifbuff->deactivate();
-    _active = true;
     _callTotal = 0;
     _vertTotal = 0;
 }
@@ -773,7 +807,9 @@ void SpriteBatch::begin() {
 void SpriteBatch::end() {
     CUAssertLog(_active,"SpriteBatch is not active");
     flush();
-    _shader->unbind();
+    if (!_deferred) {
+        _shader->unbind();
+    }
     _active = false;
 }
 
@@ -792,6 +828,11 @@ void SpriteBatch::flush() {
         record();
     }
     
+    if (_deferred) {
+        defer();
+        return;
+    }
+    
     // Load all the vertex data at once
     _vertbuff->loadVertexData(_vertData, _vertSize);
     _vertbuff->loadIndexData(_indxData, _indxSize);
@@ -799,44 +840,12 @@ void SpriteBatch::flush() {
     _unifbuff->flush();
     
     // Chunk the uniforms
-    std::shared_ptr<Texture> previous = _context->texture;
     for(auto it = _history.begin(); it != _history.end(); ++it) {
         Context* next = *it;
-        if (next->dirty & DIRTY_EQUATION) {
-            glBlendEquation(next->blendEquation);
-        }
-        if (next->dirty & DIRTY_BLENDFACTOR) {
-            glBlendFunc(next->srcFactor, next->dstFactor);
-        }
-        if (next->dirty & DIRTY_BLENDFACTOR) {
-            glBlendFunc(next->srcFactor, next->dstFactor);
-        }
-        if (next->dirty & DIRTY_DEPTHTEST) {
-            if (next->depthFunc == GL_ALWAYS) {
-                glDisable(GL_DEPTH_TEST);
-            } else {
-                glEnable(GL_DEPTH_TEST);
-                glDepthFunc(next->depthFunc);
-            }
-        }
-        if (next->dirty & DIRTY_DRAWTYPE) {
-             _shader->setUniform1i("uType", next->type);
-        }
-        if (next->dirty & DIRTY_PERSPECTIVE) {
-            _shader->setUniformMat4("uPerspective",*(next->perspective.get()));
-        }
-        if (next->dirty & DIRTY_TEXTURE) {
-            previous = next->texture;
-            if (previous != nullptr) {
-                previous->bind();
-            }
-        }
+        apply(next);
         if (next->dirty & DIRTY_UNIBLOCK) {
             _unifbuff->setBlock(next->blockptr);
         }
-        if (next->dirty & DIRTY_BLURSTEP) {
-            blurTexture(next->texture,next->blurstep);
-        }
         GLuint amt = next->last-next->first;
         _vertbuff->draw(next->command, amt, next->first);
         _callTotal++;
@@ -855,6 +864,151 @@ void SpriteBatch::flush() {
 }
 
 
+#pragma mark -
+#pragma mark Deferred Drawing
+/**
+ * Sets whether this sprite batch defers its drawing to {@link submit}.
+ *
+ * A deferred sprite batch makes no OpenGL calls while drawing. Instead,
+ * everything drawn is recorded into a frame. A call to {@link publish}
+ * completes the frame, and {@link submit} sends the latest complete frame
+ * to OpenGL. This allows drawing to happen on a thread without an OpenGL
+ * context, while the thread with the context submits the previous frame.
+ *
+ * Drawing and publishing must happen on one thread, and submitting on
+ * one other. Publishing waits until the previous frame is submitted, so
+ * every published frame must be submitted. The frames hold on to their
+ * textures until they are submitted.
+ *
+ * This value may not be changed while drawing. It is false by default.
+ *
+ * @param deferred  Whether this sprite batch defers its drawing
+ */
+void SpriteBatch::setDeferred(bool deferred) {
+    CUAssertLog(!_active, "Cannot change deferred mode while drawing");
+    if (_deferred == deferred) {
+        return;
+    }
+    for(int ii = 0; ii < 3; ii++) {
+        _frames[ii].clear();
+    }
+    _recording = _frames;
+    _submitted = _frames+1;
+    _published = (uintptr_t)(_frames+2);
+    _deferred = deferred;
+    
+    // Neither mode knows the OpenGL state the other left behind
+    if (_context != nullptr) {
+        _context->blockptr = -1;
+        _context->dirty = DIRTY_ALL_VALS;
+    }
+}
+
+/**
+ * Completes the frame recorded since the last call.
+ *
+ * The frame becomes the one drawn by the next call to {@link submit}.
+ * If the previous frame has not been submitted yet, this method waits
+ * until it is. This method may only be called in deferred mode, and not
+ * while drawing.
+ */
+void SpriteBatch::publish() {
+    CUAssertLog(_deferred, "SpriteBatch is not deferred");
+    CUAssertLog(!_active, "Cannot publish while drawing");
+    
+    // Let the frame own the last texture, so that it is released on the
+    // submitting thread. That thread has the OpenGL context to delete it.
+    _recording->texture = _context->texture;
+    setTexture(nullptr);
+    
+    // Wait for the submitting thread to take the previous frame
+    std::unique_lock<std::mutex> lock(_publishMutex);
+    _publishCondition.wait(lock, [this] { return !(_published.load() & 1); });
+    uintptr_t frame = _published.exchange((uintptr_t)_recording | 1);
+    lock.unlock();
+    _recording = (Frame*)frame;
+    
+    // The next frame cannot rely on the OpenGL state of this one
+    _context->dirty = DIRTY_ALL_VALS;
+}
+
+/**
+ * Sends the latest published frame to OpenGL.
+ *
+ * This method must be called on the thread with the OpenGL context. It
+ * draws nothing if no frame has been published since the last call.
+ * Calling this method will reset the vertex and OpenGL call counters to
+ * those of the frame.
+ *
+ * @return true if a frame was drawn
+ */
+bool SpriteBatch::submit() {
+    CUAssertLog(_deferred, "SpriteBatch is not deferred");
+    if (!(_published.load() & 1)) {
+        return false;
+    }
+    uintptr_t frame;
+    {
+        std::lock_guard<std::mutex> lock(_publishMutex);
+        frame = _published.exchange((uintptr_t)_submitted);
+    }
+    _publishCondition.notify_one();
+    _submitted = (Frame*)(frame & ~(uintptr_t)1);
+    
+    _callTotal = 0;
+    _vertTotal = (unsigned int)_submitted->indices.size();
+    if (_vertTotal == 0) {
+        _submitted->clear();
+        return true;
+    }
+    
+    glDisable(GL_CULL_FACE);
+    glDepthMask(true);
+    glEnable(GL_BLEND);
+    _shader->bind();
+    _vertbuff->bind();
+    _unifbuff->bind(false);
+    
+    // Load all the vertex data at once
+    _vertbuff->loadVertexData(_submitted->vertices.data(),
+                              (GLsizei)_submitted->vertices.size());
+    _vertbuff->loadIndexData(_submitted->indices.data(),
+                             (GLsizei)_submitted->indices.size());
+    _unifbuff->activate();
+    
+    // The frame may have more blocks than the uniform buffer. Load them
+    // a window at a time, as the contexts need them.
+    GLsizei count  = (GLsizei)_unifbuff->getBlockCount();
+    GLsizei total  = (GLsizei)(_submitted->blocks.size()/40);
+    GLsizei window = -1;
+    for(auto it = _submitted->contexts.begin(); it != _submitted->contexts.end(); ++it) {
+        Context* next = &(*it);
+        apply(next);
+        if ((next->dirty & DIRTY_UNIBLOCK) && next->blockptr >= 0) {
+            if (window < 0 || next->blockptr < window || next->blockptr >= window+count) {
+                window = next->blockptr;
+                GLsizei amt = std::min(count, total-window);
+                for(GLsizei ii = 0; ii < amt; ii++) {
+                    _unifbuff->setUniformfv(ii, 0, 40, _submitted->blocks.data()+(window+ii)*40);
+                }
+                _unifbuff->flush();
+            }
+            _unifbuff->setBlock(next->blockptr-window);
+        }
+        GLuint amt = next->last-next->first;
+        _vertbuff->draw(next->command, amt, next->first);
+        _callTotal++;
+    }
+    
+    _unifbuff->deactivate();
+    _shader->unbind();
+    
+    // Release the textures here, where they can be deleted
+    _submitted->clear();
+    return true;
+}
+
+
 #pragma mark -
 #pragma mark Solid Shapes
 /**
@@ -2078,6 +2232,76 @@ void SpriteBatch::unwind() {
     _history.clear();
 }
 
+/**
+ * Moves the vertices and uniforms batched so far into the current frame.
+ *
+ * This method is called instead of drawing upon flushing in deferred
+ * mode.
+ */
+void SpriteBatch::defer() {
+    Frame* frame = _recording;
+    GLuint vbase = (GLuint)frame->vertices.size();
+    GLuint ibase = (GLuint)frame->indices.size();
+    frame->vertices.insert(frame->vertices.end(), _vertData, _vertData+_vertSize);
+    frame->indices.reserve(ibase+_indxSize);
+    for(unsigned int ii = 0; ii < _indxSize; ii++) {
+        frame->indices.push_back(vbase+_indxData[ii]);
+    }
+    for(auto it = _history.begin(); it != _history.end(); ++it) {
+        frame->contexts.push_back(**it);
+        frame->contexts.back().first += ibase;
+        frame->contexts.back().last  += ibase;
+    }
+    
+    _vertSize = _indxSize = 0;
+    unwind();
+    _context->first = 0;
+    _context->last  = 0;
+}
+
+/**
+ * Applies the given uniforms to the shader and OpenGL state.
+ *
+ * Only the dirty values are applied, with the exception of the uniform
+ * block. As the block depends on what is loaded in the uniform buffer,
+ * that is left to the caller.
+ *
+ * @param context   The uniforms to apply
+ */
+void SpriteBatch::apply(const Context* context) {
+    if (context->dirty & DIRTY_EQUATION) {
+        glBlendEquation(context->blendEquation);
+    }
+    if (context->dirty & DIRTY_BLENDFACTOR) {
+        glBlendFunc(context->srcFactor, context->dstFactor);
+    }
+    if (context->dirty & DIRTY_DEPTHTEST) {
+        if (context->depthFunc == GL_ALWAYS) {
+            glDisable(GL_DEPTH_TEST);
+        } else {
+            glEnable(GL_DEPTH_TEST);
+            glDepthFunc(context->depthFunc);
+        }
+    }
+    if (context->dirty & DIRTY_DRAWTYPE) {
+        _shader->setUniform1i("uType", context->type);
+    }
+    if (context->dirty & DIRTY_PERSPECTIVE) {
+        _shader->setUniformMat4("uPerspective",*(context->perspective.get()));
+    }
+    if (context->dirty & DIRTY_TEXTURE) {
+        if (context->texture != nullptr) {
+            context->texture->bind();
+        }
+    }
+    if (context->dirty & DIRTY_BLURSTEP) {
+        blurTexture(context->texture,context->blurstep);
+    }
+    if (context->dirty & DIRTY_DISTEDGE) {
+        _shader->setUniform1f("uEdge", context->distedge);
+    }
+}
+
 /**
  * Sets the active uniform block to agree with the gradient and stroke.
  *
@@ -2090,7 +2314,7 @@ void SpriteBatch::setUniformBlock(Context* context, bool tint) {
     if (!(_context->dirty & DIRTY_UNIBLOCK)) {
         return;
     }
-    if (_context->blockptr+1 >= _unifbuff->getBlockCount()) {
+    if (!_deferred && _context->blockptr+1 >= _unifbuff->getBlockCount()) {
         flush();
     }
     float data[40];
@@ -2105,8 +2329,14 @@ void SpriteBatch::setUniformBlock(Context* context, bool tint) {
     } else {
         std::memset(data+16,0,24*sizeof(float));
     }
-    _context->blockptr++;
-    _unifbuff->setUniformfv(_context->blockptr,0,40,data);
+    if (_deferred) {
+        // Blocks are numbered across the whole frame
+        _context->blockptr = (GLsizei)(_recording->blocks.size()/40);
+        _recording->blocks.insert(_recording->blocks.end(), data, data+40);
+    } else {
+        _context->blockptr++;
+        _unifbuff->setUniformfv(_context->blockptr,0,40,data);
+    }
 }
 
 /**
@@ -41,9 +41,13 @@
 
 #include <cugl/scene2/CUScene2.h>
 #include <cugl/util/CUStrings.h>
+#include <cugl/util/CUThreadPool.h>
 #include <sstream>
 #include <algorithm>
 
+/** The fewest nodes of one depth for each task of the thread pool */
+#define CU_CULL_GRAIN   256
+
 using namespace cugl;
 
 /**
@@ -55,13 +59,15 @@ using namespace cugl;
  * the heap, use one of the static constructors instead.
  */
 Scene2::Scene2() :
-_camera(nullptr),
 _name(""),
+_camera(nullptr),
 _color(Color4::WHITE),
+_dirty(true),
 _blendEquation(GL_FUNC_ADD),
 _srcFactor(GL_SRC_ALPHA),
 _dstFactor(GL_ONE_MINUS_SRC_ALPHA),
-_active(false)
+_active(false),
+_flatDirty(true)
 {}
 
 /**
@@ -75,6 +81,12 @@ void Scene2::dispose() {
     _camera = nullptr;
     _name = "";
     _color = Color4::WHITE;
+    _dirty = true;
+    _flat.clear();
+    _order.clear();
+    _levels.clear();
+    _flatDirty = true;
+    _cullPool = nullptr;
     _active = false;
 }
 
@@ -235,6 +247,8 @@ void Scene2::addChild(const std::shared_ptr<scene2::SceneNode>& child, int zval)
     CUAssertLog(child->_graph == nullptr,  "The child is already in a scene graph");
     child->_childOffset = (unsigned int)_children.size();
     child->_zOrder = zval;
+    _dirty = true;
+    _flatDirty = true;
     
     // Check to see if we need resorting (including if child is dirty)
     if (!_zDirty) {
@@ -267,6 +281,8 @@ void Scene2::addChild(const std::shared_ptr<scene2::SceneNode>& child, int zval)
  */
 void Scene2::swapChild(const std::shared_ptr<scene2::SceneNode>& child1, const std::shared_ptr<scene2::SceneNode>& child2,
                       bool inherit) {
+    _dirty = true;
+    _flatDirty = true;
     _children[child1->_childOffset] = child2;
     child2->_childOffset = child1->_childOffset;
     child2->setParent(nullptr);
@@ -297,6 +313,8 @@ void Scene2::swapChild(const std::shared_ptr<scene2::SceneNode>& child1, const s
  */
 void Scene2::removeChild(unsigned int pos) {
     CUAssertLog(pos < _children.size(), "Position index out of bounds");
+    _dirty = true;
+    _flatDirty = true;
     std::shared_ptr<scene2::SceneNode> child = _children[pos];
     child->setParent(nullptr);
     child->pushScene(nullptr);
@@ -372,6 +390,8 @@ void Scene2::removeAllChildren() {
     }
     _children.clear();
     _zDirty = false;
+    _dirty = true;
+    _flatDirty = true;
 }
 
 #pragma mark -
@@ -385,6 +405,7 @@ void Scene2::removeAllChildren() {
  */
 void Scene2::sortZOrder() {
     if (_zDirty) {
+        _flatDirty = true;
         std::sort(_children.begin(),_children.end(),scene2::SceneNode::compareNodeSibs);
         // Fix the offsets
         int ii = 0;
@@ -411,16 +432,214 @@ void Scene2::sortZOrder() {
  * That means that parents are always draw before (and behind children).
  * To override this draw order, scene nodes do support a z-axis offset.
  *
+ * Rendering the scene clears {@link isDirty()}.
+ *
  * @param batch     The SpriteBatch to draw with.
  */
 void Scene2::render(const std::shared_ptr<SpriteBatch>& batch) {
+    _dirty = false;
     batch->begin(_camera->getCombined());
     batch->setBlendFunc(_srcFactor, _dstFactor);
     batch->setBlendEquation(_blendEquation);
+    renderNodes(batch, _camera->getCombined());
+    batch->end();
+}
+
+#pragma mark -
+#pragma mark Render Passes
+/**
+ * Draws all of the children in this scene as seen by the given camera.
+ *
+ * The sprite batch must already be drawing. This flattens the scene graph
+ * if it has changed, computes the bounds of every node, and then draws
+ * the nodes that can be seen.
+ *
+ * @param batch     The SpriteBatch to draw with.
+ * @param camera    The camera matrix the batch is drawing with.
+ */
+void Scene2::renderNodes(const std::shared_ptr<SpriteBatch>& batch, const Mat4& camera) {
+    if (_flatDirty) {
+        flatten();
+    }
+    cullNodes(camera);
+    drawNodes(batch);
+}
 
+/**
+ * Rebuilds the flattened scene graph from the children of this scene.
+ */
+void Scene2::flatten() {
+    _flat.clear();
     for(auto it = _children.begin(); it != _children.end(); ++it) {
-        (*it)->render(batch, Mat4::IDENTITY, _color);
+        flattenNode(it->get(), -1, 0);
+    }
+    
+    // Counting sort of the offsets by depth
+    _levels.clear();
+    for(auto it = _flat.begin(); it != _flat.end(); ++it) {
+        if ((size_t)(it->depth+2) > _levels.size()) {
+            _levels.resize(it->depth+2, 0);
+        }
+        _levels[it->depth+1]++;
     }
+    for(size_t ii = 1; ii < _levels.size(); ii++) {
+        _levels[ii] += _levels[ii-1];
+    }
+    _order.resize(_flat.size());
+    std::vector<int> next(_levels);
+    for(size_t ii = 0; ii < _flat.size(); ii++) {
+        _order[next[_flat[ii].depth]++] = (int)ii;
+    }
+    _flatDirty = false;
+}
 
-    batch->end();
+/**
+ * Adds the given node and its descendants to the flattened scene graph.
+ *
+ * @param node      The node to add
+ * @param parent    The offset of the parent entry (-1 for none)
+ * @param depth     The depth of the node
+ */
+void Scene2::flattenNode(scene2::SceneNode* node, int parent, int depth) {
+    int index = (int)_flat.size();
+    _flat.emplace_back();
+    _flat[index].node = node;
+    _flat[index].parent = parent;
+    _flat[index].depth = depth;
+    for(auto it = node->_children.begin(); it != node->_children.end(); ++it) {
+        if (*it) {
+            flattenNode(it->get(), index, depth+1);
+        }
+    }
+    _flat[index].end = (int)_flat.size();
+}
+
+/**
+ * Computes the transforms and bounds of the flattened nodes.
+ *
+ * Transforms are computed from the top depth down, and the bounds of
+ * each subtree from the bottom depth up. Every depth depends only on
+ * the one before it, so the nodes of a depth may be split across the
+ * thread pool.
+ *
+ * @param camera    The camera matrix the batch is drawing with.
+ */
+void Scene2::cullNodes(const Mat4& camera) {
+    int depths = (int)_levels.size()-1;
+    for(int pass = 0; pass < 2*depths; pass++) {
+        bool down = pass < depths;
+        int depth = down ? pass : 2*depths-pass-1;
+        int first = _levels[depth];
+        int last  = _levels[depth+1];
+        if (_cullPool == nullptr || last-first < 2*CU_CULL_GRAIN) {
+            cullRange(first, last, down, camera);
+        } else {
+            ThreadPool::Counter counter;
+            for(int ii = first+CU_CULL_GRAIN; ii < last; ii += CU_CULL_GRAIN) {
+                int end = std::min(ii+CU_CULL_GRAIN, last);
+                _cullPool->addTask([this,ii,end,down,&camera] {
+                    cullRange(ii, end, down, camera);
+                }, counter);
+            }
+            cullRange(first, first+CU_CULL_GRAIN, down, camera);
+            _cullPool->wait(counter);
+        }
+    }
+}
+
+/**
+ * Computes the transforms or subtree bounds of part of a depth.
+ *
+ * @param first     The first offset in the depth order
+ * @param last      The offset just past the last one in the depth order
+ * @param down      Whether to compute transforms (or else subtree bounds)
+ * @param camera    The camera matrix the batch is drawing with.
+ */
+void Scene2::cullRange(int first, int last, bool down, const Mat4& camera) {
+    Rect view(-1,-1,2,2);
+    for(int ii = first; ii < last; ii++) {
+        RenderEntry& entry = _flat[_order[ii]];
+        if (!down) {
+            // The subtree reaches as far as its visible children
+            if (entry.visible) {
+                entry.reach = entry.bounds;
+                for(int jj = _order[ii]+1; jj < entry.end; jj = _flat[jj].end) {
+                    if (_flat[jj].visible) {
+                        entry.reach.merge(_flat[jj].reach);
+                    }
+                }
+            }
+            continue;
+        }
+        
+        scene2::SceneNode* node = entry.node;
+        const RenderEntry* parent = entry.parent < 0 ? nullptr : &_flat[entry.parent];
+        entry.visible = node->_isVisible && (parent == nullptr || parent->visible);
+        if (!entry.visible) {
+            continue;
+        }
+        
+        Mat4 clipspace;
+        Mat4::multiply(node->_combined, parent ? parent->transform : Mat4::IDENTITY, &entry.transform);
+        Mat4::multiply(entry.transform, camera, &clipspace);
+        entry.tint = node->_tintColor;
+        if (node->_hasParentColor) {
+            entry.tint *= parent ? parent->tint : _color;
+        }
+        entry.clip = parent ? parent->clip : view;
+        if (node->_scissor) {
+            Rect mask = clipspace.transform(node->_scissor->getBounds());
+            if (mask.doesIntersect(entry.clip)) {
+                entry.clip.intersect(mask);
+            } else {
+                entry.visible = false;
+                continue;
+            }
+        }
+        entry.bounds = clipspace.transform(node->getDrawBounds());
+    }
+}
+
+/**
+ * Draws the flattened nodes that can be seen, in order.
+ *
+ * Any subtree that is hidden or has nothing on screen is skipped.
+ *
+ * @param batch     The SpriteBatch to draw with.
+ */
+void Scene2::drawNodes(const std::shared_ptr<SpriteBatch>& batch) {
+    size_t ii = 0;
+    while (ii < _flat.size()) {
+        // Restore the scissor of every subtree we have left
+        while (!_scissors.empty() && _scissors.back().first <= ii) {
+            batch->setScissor(_scissors.back().second);
+            _scissors.pop_back();
+        }
+        
+        const RenderEntry& entry = _flat[ii];
+        if (!entry.visible || !entry.reach.doesIntersect(entry.clip)) {
+            ii = (size_t)entry.end;
+            continue;
+        }
+        
+        scene2::SceneNode* node = entry.node;
+        if (node->_scissor) {
+            std::shared_ptr<Scissor> active = batch->getScissor();
+            std::shared_ptr<Scissor> local = Scissor::alloc(node->_scissor);
+            local->setTransform(entry.transform);
+            if (active) {
+                local = active->getIntersection(local, false);
+            }
+            batch->setScissor(local);
+            _scissors.push_back(std::make_pair((size_t)entry.end, active));
+        }
+        if (entry.bounds.doesIntersect(entry.clip)) {
+            node->draw(batch, entry.transform, entry.tint);
+        }
+        ii++;
+    }
+    while (!_scissors.empty()) {
+        batch->setScissor(_scissors.back().second);
+        _scissors.pop_back();
+    }
 }
@@ -119,11 +119,7 @@ void Scene2Texture::render(const std::shared_ptr<SpriteBatch>& batch) {
     batch->begin(matrix);
     batch->setBlendFunc(_srcFactor, _dstFactor);
     batch->setBlendEquation(_blendEquation);
-
-    for(auto it = _children.begin(); it != _children.end(); ++it) {
-        (*it)->render(batch, Mat4::IDENTITY, _color);
-    }
-
+    renderNodes(batch, matrix);
     batch->end();
     _target->end();
 }
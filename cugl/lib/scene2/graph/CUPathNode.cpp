@@ -499,6 +499,34 @@ void PathNode::generateRenderData() {
     _rendered = true;
 }
 
+/**
+ * Returns the bounds of what {@link draw} draws, in node space.
+ *
+ * When the stroke is positive, this includes the extruded path, which
+ * may extend past the content size.
+ *
+ * @return the bounds of what {@link draw} draws, in node space.
+ */
+cugl::Rect PathNode::getDrawBounds() const {
+    Rect result = TexturedNode::getDrawBounds();
+    if (_stroke > 0) {
+        Size nsize = getContentSize();
+        Size bsize = _polygon.getBounds().size;
+        Vec2 scale = Vec2::ONE;
+        if (nsize != bsize) {
+            scale.x = (bsize.width > 0 ? nsize.width/bsize.width : 0);
+            scale.y = (bsize.height > 0 ? nsize.height/bsize.height : 0);
+        }
+        Vec2 origin = _extrbounds.origin;
+        if (_absolute) {
+            origin += _polygon.getBounds().origin;
+        }
+        Size size(_extrbounds.size.width*scale.x,_extrbounds.size.height*scale.y);
+        result.merge(Rect(origin*scale,size));
+    }
+    return result;
+}
+
 #pragma mark -
 #pragma mark Internal Methods
 /**
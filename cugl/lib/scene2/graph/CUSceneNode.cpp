@@ -66,6 +66,7 @@ _anchor(Vec2::ANCHOR_BOTTOM_LEFT),
 _scale(Vec2::ONE),
 _angle(0),
 _useTransform(false),
+_holes(0),
 _parent(nullptr),
 _graph(nullptr),
 _zOrder(0),
@@ -322,6 +323,7 @@ void SceneNode::setPosition(float x, float y) {
     _combined.m[12] += (x-_position.x);
     _combined.m[13] += (y-_position.y);
     _position.set(x,y);
+    markDirty();
 }
 
 /**
@@ -386,10 +388,11 @@ std::string SceneNode::toString(bool verbose) const {
     ss << (verbose ? "cugl::Node(tag:" : "(tag:");
     ss <<  cugl::strtool::to_string(_tag);
     ss << ", name:" << _name;
-    ss << ", children:" << cugl::strtool::to_string((Uint64)_children.size());
+    ss << ", children:" << cugl::strtool::to_string((Uint64)getChildCount());
     ss << ")";
     if (verbose) {
         ss << "\n";
+        compactChildren();
         for(auto it = _children.begin(); it != _children.end(); ++it) {
             ss << "  " << (*it)->toString(verbose);
         }
@@ -497,6 +500,7 @@ void SceneNode::updateTransform() {
     }
     _combined.m[12] += _position.x-offset.x;
     _combined.m[13] += _position.y-offset.y;
+    markDirty();
 }
 
 
@@ -514,6 +518,7 @@ void SceneNode::updateTransform() {
  * @return the child at the given position.
  */
 std::shared_ptr<SceneNode> SceneNode::getChild(unsigned int pos) {
+    compactChildren();
     CUAssertLog(pos < _children.size(), "Position index out of bounds");
     return _children[pos];
 }
@@ -530,6 +535,7 @@ std::shared_ptr<SceneNode> SceneNode::getChild(unsigned int pos) {
  * @return the child at the given position.
  */
 const std::shared_ptr<SceneNode>& SceneNode::getChild(unsigned int pos) const {
+    compactChildren();
     CUAssertLog(pos < _children.size(), "Position index out of bounds");
     return _children[pos];
 }
@@ -549,7 +555,7 @@ const std::shared_ptr<SceneNode>& SceneNode::getChild(unsigned int pos) const {
  */
 std::shared_ptr<SceneNode> SceneNode::getChildByTag(unsigned int tag) const {
     for(auto it = _children.begin(); it != _children.end(); ++it) {
-        if ((*it)->getTag() == tag) {
+        if (*it && (*it)->getTag() == tag) {
             return *it;
         }
     }
@@ -571,7 +577,7 @@ std::shared_ptr<SceneNode> SceneNode::getChildByTag(unsigned int tag) const {
  */
 std::shared_ptr<SceneNode> SceneNode::getChildByName(const std::string name) const {
     for(auto it = _children.begin(); it != _children.end(); ++it) {
-        if ((*it)->getName() == name) {
+        if (*it && (*it)->getName() == name) {
             return *it;
         }
     }
@@ -595,6 +601,10 @@ void SceneNode::addChild(const std::shared_ptr<SceneNode>& child, int zval) {
     CUAssertLog(child->_graph == nullptr,  "The child is already in a scene graph");
     child->_childOffset = (unsigned int)_children.size();
     child->_zOrder = zval;
+    markDirty();
+    if (_graph) {
+        _graph->setFlatDirty();
+    }
     
     // Check to see if we need resorting (including if child is dirty)
     if (!_zDirty) {
@@ -628,6 +638,10 @@ void SceneNode::addChild(const std::shared_ptr<SceneNode>& child, int zval) {
  */
 void SceneNode::swapChild(const std::shared_ptr<SceneNode>& child1,
                           const std::shared_ptr<SceneNode>& child2, bool inherit) {
+    markDirty();
+    if (_graph) {
+        _graph->setFlatDirty();
+    }
     _children[child1->_childOffset] = child2;
     child2->_childOffset = child1->_childOffset;
     child2->setParent(this);
@@ -657,31 +671,26 @@ void SceneNode::swapChild(const std::shared_ptr<SceneNode>& child1,
  * @param pos   The position of the child node which will be removed.
  */
 void SceneNode::removeChild(unsigned int pos) {
+    compactChildren();
     CUAssertLog(pos < _children.size(), "Position index out of bounds");
-    std::shared_ptr<SceneNode> child = _children[pos];
-    child->setParent(nullptr);
-    child->pushScene(nullptr);
-    child->_childOffset = -1;
-    for(int ii = pos; ii < _children.size()-1; ii++) {
-        _children[ii] = _children[ii+1];
-        _children[ii]->_childOffset = ii;
-    }
-    _children.resize(_children.size()-1);
+    eraseChild(pos);
 }
 
 /**
  * Removes a child from this Node.
  *
  * Removing a child alters the position of every child after it.  Hence
- * it is unsafe to cache child positions.
+ * it is unsafe to cache child positions. Unlike removing by position, this
+ * takes constant time, as the child only leaves a hole behind.
  *
  * If the child is not in this node, nothing happens.
  *
  * @param child The child node which will be removed.
  */
 void SceneNode::removeChild(const std::shared_ptr<SceneNode>& child) {
-    CUAssertLog(_children[child->_childOffset] == child, "The child is not in this scene graph");
-    removeChild(child->_childOffset);
+    CUAssertLog(child->_childOffset >= 0 && child->_childOffset < (int)_children.size() &&
+                _children[child->_childOffset] == child, "The child is not in this scene graph");
+    eraseChild(child->_childOffset);
 }
 
 /**
@@ -698,7 +707,7 @@ void SceneNode::removeChild(const std::shared_ptr<SceneNode>& child) {
 void SceneNode::removeChildByTag(unsigned int tag) {
     std::shared_ptr<SceneNode> child = getChildByTag(tag);
     if (child != nullptr) {
-        removeChild(child->_childOffset);
+        eraseChild(child->_childOffset);
     }
 }
 
@@ -716,7 +725,7 @@ void SceneNode::removeChildByTag(unsigned int tag) {
 void SceneNode::removeChildByName(const std::string name) {
     std::shared_ptr<SceneNode> child = getChildByName(name);
     if (child != nullptr) {
-        removeChild(child->_childOffset);
+        eraseChild(child->_childOffset);
     }
 }
 
@@ -724,12 +733,19 @@ void SceneNode::removeChildByName(const std::string name) {
  * Removes all children from this Node.
  */
 void SceneNode::removeAllChildren() {
+    markDirty();
+    if (_graph) {
+        _graph->setFlatDirty();
+    }
     for(auto it = _children.begin(); it != _children.end(); ++it) {
-        (*it)->setParent(nullptr);
-        (*it)->_childOffset = -1;
-        (*it)->pushScene(nullptr);
+        if (*it) {
+            (*it)->setParent(nullptr);
+            (*it)->_childOffset = -1;
+            (*it)->pushScene(nullptr);
+        }
     }
     _children.clear();
+    _holes = 0;
     _zDirty = false;
 }
 
@@ -744,10 +760,67 @@ void SceneNode::removeAllChildren() {
 void SceneNode::pushScene(Scene2* scene) {
     setScene(scene);
     for(auto it = _children.begin(); it != _children.end(); ++it) {
-        (*it)->pushScene(scene);
+        if (*it) {
+            (*it)->pushScene(scene);
+        }
     }
 }
 
+/**
+ * Removes the child at the given offset, leaving a hole in its place.
+ *
+ * This takes constant time, as no other child is moved. Once holes make
+ * up half of the array, the children are compacted.
+ *
+ * @param offset    The offset of the child in the array of children.
+ */
+void SceneNode::eraseChild(unsigned int offset) {
+    CUAssertLog(offset < _children.size() && _children[offset] != nullptr, "Position index out of bounds");
+    markDirty();
+    if (_graph) {
+        _graph->setFlatDirty();
+    }
+    std::shared_ptr<SceneNode> child = _children[offset];
+    child->setParent(nullptr);
+    child->pushScene(nullptr);
+    child->_childOffset = -1;
+    _children[offset] = nullptr;
+    _holes++;
+    
+    // Keep the last element a child, so addChild can compare against it
+    while (!_children.empty() && _children.back() == nullptr) {
+        _children.pop_back();
+        _holes--;
+    }
+    if (2*_holes > _children.size()) {
+        compactChildren();
+    }
+}
+
+/**
+ * Fills the holes left in the array of children by removed children.
+ *
+ * The remaining children keep their order, and their offsets are updated.
+ * This is called before anything accesses the children by position.
+ */
+void SceneNode::compactChildren() const {
+    if (_holes == 0) {
+        return;
+    }
+    size_t jj = 0;
+    for(size_t ii = 0; ii < _children.size(); ii++) {
+        if (_children[ii]) {
+            if (ii != jj) {
+                _children[jj] = std::move(_children[ii]);
+                _children[jj]->_childOffset = (int)jj;
+            }
+            jj++;
+        }
+    }
+    _children.resize(jj);
+    _holes = 0;
+}
+
 /**
  * Arranges the child of this node using the layout manager.
  *
@@ -759,6 +832,7 @@ void SceneNode::doLayout() {
     if (_layout) {
         _layout->layout(this);
     }
+    compactChildren();
     for(auto it = _children.begin(); it != _children.end(); ++it) {
         (*it)->doLayout();
     }
@@ -782,9 +856,11 @@ void SceneNode::doLayout() {
  */
 void SceneNode::setZOrder(int z) {
     _zOrder = z;
+    markDirty();
     
     // Notify the parent if we have a problem.
     if (_parent != nullptr && !_parent->_zDirty) {
+        _parent->compactChildren();
         int size = (int)_parent->_children.size();
         bool zd = (_childOffset > 0 && _parent->_children[_childOffset-1]->_zOrder > z);
         zd = zd || (_childOffset < size-1 && _parent->_children[_childOffset+1]->_zOrder < z);
@@ -826,6 +902,21 @@ void SceneNode::setZDirty(bool value) {
     }
 }
 
+/**
+ * Marks the scene graph of this node as needing to be drawn again.
+ *
+ * Every method that changes how this node looks calls this method, so
+ * that the scene knows there is something new to draw. Subclasses that
+ * draw something that changes on its own, without calling any of those
+ * methods, must call this method whenever it does. If the node is not
+ * in a scene graph, nothing happens.
+ */
+void SceneNode::markDirty() {
+    if (_graph != nullptr) {
+        _graph->setDirty(true);
+    }
+}
+
 /**
  * Returns true if sibling a is less than b in sorted z-order.
  *
@@ -861,6 +952,10 @@ bool SceneNode::compareNodeSibs(const std::shared_ptr<SceneNode>& a,
  */
 void SceneNode::sortZOrder() {
     if (_zDirty) {
+        if (_graph) {
+            _graph->setFlatDirty();
+        }
+        compactChildren();
         std::sort(_children.begin(),_children.end(),SceneNode::compareNodeSibs);
         // Fix the offsets
         int ii = 0;
@@ -914,7 +1009,9 @@ void SceneNode::render(const std::shared_ptr<SpriteBatch>& batch, const Mat4& tr
 
     draw(batch,matrix,color);
     for(auto it = _children.begin(); it != _children.end(); ++it) {
-        (*it)->render(batch, matrix, color);
+        if (*it) {
+            (*it)->render(batch, matrix, color);
+        }
     }
 
     if (_scissor) {
@@ -386,6 +386,7 @@ void TexturedNode::shiftPolygon(float dx, float dy) {
         it->texcoord.x += dx/w;
         it->texcoord.y -= dy/h;
     }
+    markDirty();
 }
 
 /**
@@ -445,6 +446,32 @@ void TexturedNode::setGradient(const std::shared_ptr<Gradient>& gradient) {
 }
 
 
+/**
+ * Returns the bounds of what {@link draw} draws, in node space.
+ *
+ * This is the polygon scaled to the content size. If the polygon is not
+ * absolute, it is shifted so that its bounding rect starts at the origin.
+ *
+ * @return the bounds of what {@link draw} draws, in node space.
+ */
+cugl::Rect TexturedNode::getDrawBounds() const {
+    // Matches the shift applied to the mesh in generateRenderData
+    Rect result(Vec2::ZERO,getContentSize());
+    Rect bounds = _polygon.getBounds();
+    Vec2 origin = bounds.origin;
+    if (bounds.size.width > 0) {
+        origin.x *= result.size.width/bounds.size.width;
+    }
+    if (bounds.size.height > 0) {
+        origin.y *= result.size.height/bounds.size.height;
+    }
+    if (!_absolute) {
+        origin -= bounds.origin;
+    }
+    result.origin = origin;
+    return result;
+}
+
 #pragma mark -
 #pragma mark Internal Helpers
 
@@ -504,6 +531,7 @@ void TexturedNode::generateRenderData() {
 void TexturedNode::clearRenderData() {
     _mesh.clear();
     _rendered = false;
+    markDirty();
     
 }
 
@@ -515,6 +543,7 @@ void TexturedNode::clearRenderData() {
  * of the texture.
  */
 void TexturedNode::updateTextureCoords() {
+    markDirty();
     if (!_rendered) {
         return;
     }
@@ -219,7 +219,7 @@ bool WireNode::initWithData(const Scene2Loader* loader, const std::shared_ptr<Js
  * @return  An autoreleased wireframe node
  */
 std::shared_ptr<WireNode> WireNode::alloc(const Rect rect) {
-    std::shared_ptr<WireNode> node = std::make_shared<WireNode>();
+    std::shared_ptr<WireNode> node = std::allocate_shared<WireNode>(SlabAllocator<WireNode>());
     if (!node->init()) {
         return nullptr;
     }
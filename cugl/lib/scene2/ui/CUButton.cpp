@@ -503,6 +503,7 @@ void Button::setColor(Color4 color) {
     _upcolor = color;
     if (!_down || _downnode) {
         _tintColor = color;
+        markDirty();
     }
 }
 
@@ -561,6 +562,7 @@ void Button::setDown(bool down) {
     }
     
     _down = down;
+    markDirty();
     if (down && _downnode && _upnode) {
         _upnode->setVisible(false);
         _downnode->setVisible(true);
@@ -64,7 +64,8 @@ _valign(VAlign::BOTTOM),
 _rendered(false),
 _blendEquation(GL_FUNC_ADD),
 _srcFactor(GL_SRC_ALPHA),
-_dstFactor(GL_ONE_MINUS_SRC_ALPHA)
+_dstFactor(GL_ONE_MINUS_SRC_ALPHA),
+_sized(false)
 {}
 
 /**
@@ -78,6 +79,7 @@ _dstFactor(GL_ONE_MINUS_SRC_ALPHA)
  */
 void Label::dispose() {
     clearRenderData();
+    clearGlyphs();
     _text.clear();
     _font = nullptr;
     _foreground = Color4::BLACK;
@@ -86,6 +88,7 @@ void Label::dispose() {
     _valign = VAlign::BOTTOM;
     _padding = Vec2::ZERO;
     _rendered = false;
+    _sized = false;
     SceneNode::dispose();
 }
 
@@ -289,6 +292,19 @@ bool Label::initWithData(const Scene2Loader* loader, const std::shared_ptr<JsonV
  * @oaram resize    Whether to resize the label to fit the new text.
  */
 void Label::setText(const std::string& text, bool resize) {
+    // Nothing to lay out if the printable text is unchanged
+    bool same = _sized && text.size() == _text.size();
+    for(size_t ii = 0; same && ii < text.size(); ii++) {
+        char c = (((Uint32)text[ii]) > 32 && text[ii] != 127) ? text[ii] : ' ';
+        same = (c == _text[ii]);
+    }
+    if (same) {
+        if (resize) {
+            setContentSize(_textbounds.size);
+        }
+        return;
+    }
+
     // Let's strip the non-printable characters first
     _text.clear();
     _text.reserve(text.size());
@@ -528,7 +544,33 @@ void Label::draw(const std::shared_ptr<SpriteBatch>& batch, const Mat4& transfor
     }
     batch->setTexture(_texture);
     batch->setColor(tint);
-    batch->fill(_mesh, transform);
+    if (_font->hasDistanceField()) {
+        batch->setDistanceEdge(0.5f);
+        batch->fill(_mesh, transform);
+        batch->setDistanceEdge(0);
+    } else {
+        batch->fill(_mesh, transform);
+    }
+}
+
+/**
+ * Returns the bounds of what {@link draw} draws, in node space.
+ *
+ * This includes the text bounds, as the text may extend past the content
+ * size of this label. Distance field glyphs extend past the text by the
+ * spread of the font.
+ *
+ * @return the bounds of what {@link draw} draws, in node space.
+ */
+cugl::Rect Label::getDrawBounds() const {
+    Rect result(Vec2::ZERO,getContentSize());
+    Rect text = _textbounds;
+    text.merge(getTrueBounds());
+    if (_font != nullptr && _font->hasDistanceField()) {
+        text.expand((float)_font->getDistanceSpread());
+    }
+    result.merge(text);
+    return result;
 }
 
 
@@ -547,6 +589,7 @@ void Label::draw(const std::shared_ptr<SpriteBatch>& batch, const Mat4& transfor
 void Label::computeSize() {
     _textbounds.size = _font->getSize(_text);
     _truebounds = _font->getInternalBounds(_text);
+    _sized = true;
     
     // This will fix the offsets
     setHorizontalAlignment(_halign);
@@ -555,27 +598,107 @@ void Label::computeSize() {
 
 /**
  * Allocate the render data necessary to render this node.
+ *
+ * If the font has an atlas and the text is ASCII, the glyphs of the
+ * previous text are kept up to the first character that changed, and
+ * only the rest of the text is laid out again. Hence a score counter
+ * only pays for the digits that actually changed. Text that moves with
+ * its alignment keeps its glyphs too, as they are only shifted.
  */
 void Label::generateRenderData() {
     // Make the backdrop
     _bounds = Rect(Vec2::ZERO,getContentSize());
 
+    bool ascii = _font->hasAtlas();
+    for(auto it = _text.begin(); ascii && it != _text.end(); ++it) {
+        ascii = ((Uint32)*it) < 128;
+    }
+
     // Glyphs are defined by _textbounds, regardless of alignment
-    _texture = _font->getMesh(_text, _textbounds.origin, _mesh);
-    for(auto it = _mesh.vertices.begin(); it != _mesh.vertices.end(); ++it) {
-        it->color = _foreground;
+    if (!ascii) {
+        clearGlyphs();
+        _texture = _font->getMesh(_text, _textbounds.origin, _mesh);
+        for(auto it = _mesh.vertices.begin(); it != _mesh.vertices.end(); ++it) {
+            it->color = _foreground;
+        }
+        _rendered = true;
+        return;
+    }
+
+    // Keep the glyphs before the first changed character
+    const std::shared_ptr<Texture>& atlas = _font->getAtlas();
+    size_t start = 0;
+    if (_texture == atlas && !_meshGlyphs.empty()) {
+        size_t limit = std::min(_text.size(),_meshText.size());
+        while (start < limit && _text[start] == _meshText[start]) {
+            start++;
+        }
+        
+        // Alignment may move the text, but not change its glyphs
+        Vec2 delta = _textbounds.origin-_meshOrigin;
+        if (delta != Vec2::ZERO) {
+            for(Uint32 ii = 0; ii < _meshGlyphs[start].vertex; ii++) {
+                _mesh.vertices[ii].position += delta;
+            }
+            for(size_t ii = 0; ii <= start; ii++) {
+                _meshGlyphs[ii].pen += delta.x;
+            }
+            _meshOrigin = _textbounds.origin;
+        }
+    } else {
+        clearGlyphs();
+        _texture = atlas;
+        _meshOrigin = _textbounds.origin;
+        _meshGlyphs.push_back({0,0,_meshOrigin.x});
+    }
+
+    GlyphStart first = _meshGlyphs[start];
+    _mesh.vertices.resize(first.vertex);
+    _mesh.indices.resize(first.index);
+    Vec2 offset(first.pen,_meshOrigin.y);
+    _meshGlyphs.resize(start);
+    _meshText = _text;
+
+    // Lay out the rest, exactly as Font::getMesh would
+    for(size_t ii = start; ii < _text.size(); ii++) {
+        Uint32 thechar = (Uint32)_text[ii];
+        _meshGlyphs.push_back({(Uint32)_mesh.vertices.size(),(Uint32)_mesh.indices.size(),offset.x});
+        if (_font->hasGlyph(thechar)) {
+            if (ii > 0 && _font->hasGlyph((Uint32)_text[ii-1])) {
+                offset.x -= _font->getKerning((Uint32)_text[ii-1],thechar);
+            }
+            _font->getQuad(thechar, offset, _mesh);
+        }
+    }
+    _meshGlyphs.push_back({(Uint32)_mesh.vertices.size(),(Uint32)_mesh.indices.size(),offset.x});
+
+    for(size_t ii = first.vertex; ii < _mesh.vertices.size(); ii++) {
+        _mesh.vertices[ii].color = _foreground;
     }
 
     _rendered = true;
 }
 
 /**
- * Clears the render data, releasing all vertices and indices.
+ * Clears the render data, so that it is regenerated on the next draw.
+ *
+ * The vertices and indices are kept, so that {@link generateRenderData}
+ * can reuse the glyphs that did not change.  Call {@link clearGlyphs}
+ * to release them.
  */
 void Label::clearRenderData() {
+    _rendered = false;
+    markDirty();
+}
+
+/**
+ * Releases all vertices and indices, and the layout of their text.
+ */
+void Label::clearGlyphs() {
     _mesh.clear();
     _mesh.command = GL_TRIANGLES;
-    _rendered = false;
+    _meshText.clear();
+    _meshGlyphs.clear();
 }
 
 /**
@@ -585,10 +708,9 @@ void Label::clearRenderData() {
  * colors.
  */
 void Label::updateColor() {
-    if (!_rendered) {
-        return;
-    }
+    markDirty();
     
+    // Kept glyphs must match, even if they are not rendered
     for(auto it = _mesh.vertices.begin(); it != _mesh.vertices.end(); ++it) {
         it->color = _foreground;
     }
@@ -345,7 +345,9 @@ std::string NinePatch::toString(bool verbose) const {
     if (verbose) {
         ss << "\n";
         for(auto it = _children.begin(); it != _children.end(); ++it) {
-            ss << "  " << (*it)->toString(verbose);
+            if (*it) {
+                ss << "  " << (*it)->toString(verbose);
+            }
         }
     }
     
@@ -361,6 +363,7 @@ void NinePatch::clearRenderData() {
     _mesh.clear();
     _indices.clear();
     _rendered = false;
+    markDirty();
 }
 
 /**
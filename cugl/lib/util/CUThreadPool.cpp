@@ -10,6 +10,11 @@
 //  the code for asynchronous asset loading. We generalized that class added
 //  some notable safety changes.
 //
+//  Tasks are scheduled by work stealing. Each worker has its own deques of
+//  tasks (one per priority), which other workers steal from when they run
+//  out. Tasks are stored inline in pooled task objects, so adding a small
+//  task does not allocate.
+//
 //  CUGL MIT License:
 //      This software is provided 'as-is', without any express or implied
 //      warranty.  In no event will the authors be held liable for any damages
@@ -36,6 +41,83 @@
 
 using namespace cugl;
 
+/** The index of no task in the task pool */
+#define NO_TASK 0xFFFFFFFF
+
+/** The worker state of the current thread, if it is a worker */
+static thread_local void* current_worker = nullptr;
+
+#pragma mark -
+#pragma mark Deque
+/**
+ * Pushes a task at the bottom. Only the owner may call this.
+ *
+ * @param task  The task to push
+ *
+ * @return false if the deque is full
+ */
+bool ThreadPool::Deque::push(Task* task) {
+    Sint64 bottom = _bottom.load(std::memory_order_relaxed);
+    Sint64 top = _top.load(std::memory_order_acquire);
+    if (bottom-top >= CU_TASK_DEQUE) {
+        return false;
+    }
+    _items[bottom & (CU_TASK_DEQUE-1)].store(task, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    _bottom.store(bottom+1, std::memory_order_relaxed);
+    return true;
+}
+
+/**
+ * Pops the newest task. Only the owner may call this.
+ *
+ * @return the task, or nullptr if there is none
+ */
+ThreadPool::Task* ThreadPool::Deque::pop() {
+    Sint64 bottom = _bottom.load(std::memory_order_relaxed)-1;
+    _bottom.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    Sint64 top = _top.load(std::memory_order_relaxed);
+    if (top > bottom) {
+        // Empty
+        _bottom.store(bottom+1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    
+    Task* task = _items[bottom & (CU_TASK_DEQUE-1)].load(std::memory_order_relaxed);
+    if (top == bottom) {
+        // Last one, so race the thieves for it
+        if (!_top.compare_exchange_strong(top, top+1, std::memory_order_seq_cst,
+                                          std::memory_order_relaxed)) {
+            task = nullptr;
+        }
+        _bottom.store(bottom+1, std::memory_order_relaxed);
+    }
+    return task;
+}
+
+/**
+ * Steals the oldest task. Any thread may call this.
+ *
+ * @return the task, or nullptr if there is none or the steal lost a race
+ */
+ThreadPool::Task* ThreadPool::Deque::steal() {
+    Sint64 top = _top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    Sint64 bottom = _bottom.load(std::memory_order_acquire);
+    if (top >= bottom) {
+        return nullptr;
+    }
+    
+    Task* task = _items[top & (CU_TASK_DEQUE-1)].load(std::memory_order_relaxed);
+    if (!_top.compare_exchange_strong(top, top+1, std::memory_order_seq_cst,
+                                      std::memory_order_relaxed)) {
+        return nullptr;
+    }
+    return task;
+}
+
+
 #pragma mark -
 #pragma mark Constructors
 /**
@@ -45,10 +127,40 @@ using namespace cugl;
  * idea to destroy the thread pool if the pool is not yet shut down. The
  * task queue is shared by the child threads, so we cannot delete it until
  * all the threads complete.  This destructor will block unti showndown.
+ *
+ * Tasks that have not started are destroyed without being run.
  */
 void ThreadPool::dispose() {
     stop();
     while (!isShutdown());
+    
+    for(int lane = 0; lane < 2; lane++) {
+        for(auto it = _shared[lane].begin(); it != _shared[lane].end(); ++it) {
+            (*it)->destroy((*it)->storage);
+            release(*it);
+        }
+        _shared[lane].clear();
+        for(auto it = _states.begin(); it != _states.end(); ++it) {
+            Task* task;
+            while ((task = (*it)->deques[lane].pop()) != nullptr) {
+                task->destroy(task->storage);
+                release(task);
+            }
+        }
+    }
+    for(auto it = _states.begin(); it != _states.end(); ++it) {
+        delete *it;
+    }
+    _states.clear();
+    
+    if (_tasks != nullptr) {
+        delete[] _tasks;
+        _tasks = nullptr;
+    }
+    _capacity = 0;
+    _free = NO_TASK;
+    _pending = 0;
+    _sleeping = 0;
 }
 
 /**
@@ -63,11 +175,30 @@ void ThreadPool::dispose() {
  * @return true if the threed pool is initialized properly, false otherwise.
  */
 bool ThreadPool::init(int threads) {
+    _stop = false;
+    _complete = 0;
+    
+    // Chain the pooled tasks into the free list
+    _capacity = CU_TASK_POOL*threads;
+    _tasks = new Task[_capacity];
+    for(Uint32 index = 0; index < _capacity; index++) {
+        _tasks[index].index = index;
+        _tasks[index].next = index+1 < _capacity ? index+1 : NO_TASK;
+    }
+    _free = _capacity > 0 ? 0 : NO_TASK;
+    
+    // All states must exist before any thread starts stealing
+    for (int index = 0; index < threads; ++index) {
+        Worker* worker = new Worker();
+        worker->pool = this;
+        worker->index = index;
+        _states.push_back(worker);
+    }
     for (int index = 0; index < threads; ++index) {
 #ifdef CU_SDL_THREADS
-        _workers.emplace_back(SDL_CreateThread(ThreadPool::sdlThreadFunc,"Pool Dispatch",(void*)this));
+        _workers.emplace_back(SDL_CreateThread(ThreadPool::sdlThreadFunc,"Pool Dispatch",(void*)_states[index]));
 #else
-        _workers.emplace_back(std::thread(std::bind(&ThreadPool::threadFunc, this)));
+        _workers.emplace_back(std::thread(std::bind(&ThreadPool::run, this, _states[index])));
 #endif
     }
     return true;
@@ -80,84 +211,205 @@ bool ThreadPool::init(int threads) {
 /**
  * The body function of a single thread.
  *
- * This function pulls tasks from the task queue.
+ * This function runs tasks until the pool is stopped.
  *
- * This implementation is safe to use with std::thread.
+ * @param worker    The state of the thread
  */
-void ThreadPool::threadFunc() {
+void ThreadPool::run(Worker* worker) {
+    current_worker = worker;
     while (!_stop) {
-        std::function<void()> task = nullptr;
-        {   // Lock for save queue access
-            std::unique_lock<std::mutex> lk(_queueMutex);
-            if (_stop) {
-                break;
-            }
-            // Pull the next task off the queue
-            if (!_taskQueue.empty()) {
-                task = std::move(_taskQueue.front());
-                _taskQueue.pop();
-            } else {
-                _taskCondition.wait(lk);
-                continue;
-            }
+        Task* task = find(worker, Priority::FRAME);
+        if (task == nullptr) {
+            task = find(worker, Priority::LOADING);
+        }
+        if (task != nullptr) {
+            execute(task);
+            continue;
         }
-        // Perform the current task
-        task();
+        
+        // Sleep until there is something to take
+        std::unique_lock<std::mutex> lk(_queueMutex);
+        _sleeping++;
+        _taskCondition.wait(lk, [this] { return _stop || _pending > 0; });
+        _sleeping--;
     }
+    current_worker = nullptr;
     _complete++;
 }
 
 /**
  * The body function of a single thread.
  *
- * This function pulls tasks from the task queue.
+ * This function runs tasks until the pool is stopped.
  *
  * This static implementation uses the SDL thread API.  It should be used
  * on Android and Windows, which have special thread requirements.
  */
 int ThreadPool::sdlThreadFunc(void* ptr) {
-    ThreadPool* self = (ThreadPool*)ptr;
-    while (!self->_stop) {
-        std::function<void()> task = nullptr;
-        {   // Lock for save queue access
-            std::unique_lock<std::mutex> lk(self->_queueMutex);
-            if (self->_stop) {
-                break;
-            }
-            // Pull the next task off the queue
-            if (!self->_taskQueue.empty()) {
-                task = std::move(self->_taskQueue.front());
-                self->_taskQueue.pop();
-            } else {
-                self->_taskCondition.wait(lk);
-                continue;
+    Worker* worker = (Worker*)ptr;
+    worker->pool->run(worker);
+    return 0;
+}
+
+/**
+ * Returns the worker state of the calling thread in this pool.
+ *
+ * @return the worker state, or nullptr if the caller is not a worker
+ */
+ThreadPool::Worker* ThreadPool::current() const {
+    Worker* worker = (Worker*)current_worker;
+    return worker != nullptr && worker->pool == this ? worker : nullptr;
+}
+
+/**
+ * Finds a task of the given priority for the given worker.
+ *
+ * The worker tries its own deque first, then the shared queue, and then
+ * steals from the other workers.
+ *
+ * @param worker    The worker, or nullptr if the caller is not a worker
+ * @param priority  The task priority
+ *
+ * @return the task, or nullptr if there is none
+ */
+ThreadPool::Task* ThreadPool::find(Worker* worker, Priority priority) {
+    if (_pending.load() <= 0) {
+        return nullptr;
+    }
+    
+    int lane = (int)priority;
+    Task* task = nullptr;
+    if (worker != nullptr) {
+        task = worker->deques[lane].pop();
+    }
+    if (task == nullptr) {
+        std::unique_lock<std::mutex> lk(_queueMutex);
+        if (!_shared[lane].empty()) {
+            task = _shared[lane].front();
+            _shared[lane].pop_front();
+        }
+    }
+    if (task == nullptr) {
+        size_t size = _states.size();
+        size_t start = worker != nullptr ? worker->index+1 : 0;
+        for(size_t ii = 0; ii < size && task == nullptr; ii++) {
+            Worker* victim = _states[(start+ii) % size];
+            if (victim != worker) {
+                task = victim->deques[lane].steal();
             }
         }
-        // Perform the current task
-        task();
     }
-    self->_complete++;
-    return 0;
+    if (task != nullptr) {
+        _pending--;
+    }
+    return task;
 }
 
+/**
+ * Runs a task and releases it.
+ *
+ * @param task  The task to run
+ */
+void ThreadPool::execute(Task* task) {
+    task->invoke(task->storage);
+    task->destroy(task->storage);
+    Counter* counter = task->counter;
+    release(task);
+    if (counter != nullptr) {
+        counter->_count.fetch_sub(1, std::memory_order_release);
+    }
+}
 
 
 #pragma mark -
 #pragma mark Task Management
 /**
- * Adds a task to the thread pool.
+ * Returns a task object, from the pool if one is free.
  *
- * A task is a void returning function with no parameters.  If you need
- * state in the task, you should use a method call for the state.  The task
- * will not be executed immediately, but must wait for the first available
- * worker.
+ * @return a task object
+ */
+ThreadPool::Task* ThreadPool::acquire() {
+    Uint64 head = _free.load(std::memory_order_acquire);
+    while ((Uint32)head != NO_TASK) {
+        Uint32 index = (Uint32)head;
+        Uint64 next = _tasks[index].next.load(std::memory_order_relaxed);
+        // The tag in the high bits changes on every swap, against ABA
+        Uint64 swap = (((head >> 32)+1) << 32) | next;
+        if (_free.compare_exchange_weak(head, swap, std::memory_order_acquire,
+                                        std::memory_order_acquire)) {
+            return _tasks+index;
+        }
+    }
+    
+    // The pool is exhausted
+    Task* task = new Task();
+    task->index = NO_TASK;
+    return task;
+}
+
+/**
+ * Returns a task object after its task has been run.
  *
- * @param  task     the task function to add to the thread pool
+ * @param task  The task object
  */
-void ThreadPool::addTask(const std::function<void()> &task){
-    std::unique_lock<std::mutex> lk(_queueMutex);
-    _taskQueue.emplace(task);
-    _taskCondition.notify_one();
+void ThreadPool::release(Task* task) {
+    if (task->index == NO_TASK) {
+        delete task;
+        return;
+    }
+    Uint64 head = _free.load(std::memory_order_relaxed);
+    Uint64 swap;
+    do {
+        task->next.store((Uint32)head, std::memory_order_relaxed);
+        swap = (((head >> 32)+1) << 32) | task->index;
+    } while (!_free.compare_exchange_weak(head, swap, std::memory_order_release,
+                                          std::memory_order_relaxed));
+}
+
+/**
+ * Schedules a task with the given priority.
+ *
+ * @param task      The task to schedule
+ * @param priority  The task priority
+ */
+void ThreadPool::schedule(Task* task, Priority priority) {
+    int lane = (int)priority;
+    
+    // Count the task first, so that the count never goes negative
+    _pending++;
+    Worker* worker = current();
+    if (worker == nullptr || !worker->deques[lane].push(task)) {
+        std::unique_lock<std::mutex> lk(_queueMutex);
+        _shared[lane].push_back(task);
+    }
+    if (_sleeping > 0) {
+        std::unique_lock<std::mutex> lk(_queueMutex);
+        _taskCondition.notify_one();
+    }
+}
+
+/**
+ * Waits until every task of the given counter is done.
+ *
+ * The calling thread runs tasks itself while it waits, so it is safe
+ * for a task to wait on the tasks that it added. Threads outside of the
+ * pool only run frame tasks, so that they are never held up by loading.
+ *
+ * @param  counter  the counter of the batch
+ */
+void ThreadPool::wait(const Counter& counter) {
+    Worker* worker = current();
+    while (!counter.isDone()) {
+        Task* task = find(worker, Priority::FRAME);
+        if (task == nullptr && worker != nullptr) {
+            task = find(worker, Priority::LOADING);
+        }
+        if (task != nullptr) {
+            execute(task);
+        } else {
+            std::this_thread::yield();
+        }
+    }
 }
 
 /**
@@ -182,4 +434,7 @@ void ThreadPool::stop() {
         worker.join();
 #endif
     }
+    // Every thread is joined, so stopping again is safe
+    _workers.clear();
+    _complete = 0;
 }
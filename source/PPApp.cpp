@@ -1,8 +1,25 @@
 ﻿#include "PPApp.h"
 
+/**
+ * The time jobs may take each frame, in milliseconds. This leaves most of a
+ * 16 ms frame to the scene that is showing.
+ */
+#define JOB_BUDGET 4
+/** The asset group with everything the menu does not need. */
+#define WARMUP_GROUP "game"
+/** The asset directory of that group. */
+#define WARMUP_DIRECTORY "config/groups/game.json"
+
 void PanicPainterApp::onStartup() {
+    StartupTimeline::start();
     _assets = AssetManager::alloc();
     _batch = SpriteBatch::alloc();
+#ifdef PIPELINED_DRAW
+    // Scenes are drawn on their own thread while the last frame is shown.
+    _batch->setDeferred(true);
+    setPipelined(true);
+#endif
+    _jobs = JobQueue::alloc(JOB_BUDGET);
 
     InputController::getInstance().init();
 
@@ -13,9 +30,11 @@ void PanicPainterApp::onStartup() {
     _assets->attach<SceneNode>(Scene2Loader::alloc()->getHook());
     _assets->attach<WidgetValue>(WidgetLoader::alloc()->getHook());
     _assets->attach<JsonValue>(JsonLoader::alloc()->getHook());
+    _assets->attach<Level>(GenericLoader<Level>::alloc()->getHook());
+    _assets->addCategory<Level>("levels");
 
     // Initialize the first scene: loading manager
-    _loading.init(_assets);
+    _loading.init(_assets, _jobs);
 
     // Call save controller to load.
     SaveController::getInstance();
@@ -23,9 +42,11 @@ void PanicPainterApp::onStartup() {
     // Start audio engine.
     AudioEngine::start();
     SoundController::getInstance()->init(_assets);
+    AssetGroupController::getInstance().init(_assets);
 
-    // Start loading assets.
+    // Start loading the boot assets. These are only what the menu needs.
     _assets->loadDirectoryAsync("config/assets.json", nullptr);
+    StartupTimeline::mark("loading");
 
 //    SDL_SetHint(SDL_HINT_ANDROID_TRAP_BACK_BUTTON, "1");
 
@@ -34,15 +55,26 @@ void PanicPainterApp::onStartup() {
 }
 
 void PanicPainterApp::onShutdown() {
+    SaveController::getInstance()->flush();
+    _jobs->clear();
     _loading.dispose();
     if (_currentScene != LOADING_SCENE) {
-        _gameplay.dispose();
         _menu.dispose();
+    }
+    if (_warm) {
+        _gameplay->dispose();
+        _standby->dispose();
         _world.dispose();
         _level.dispose();
         _settings.dispose();
         _credits.dispose();
     }
+    AssetGroupController::getInstance().dispose();
+#ifdef AUDIO_DEBUG
+    _monitor = nullptr;
+    _monitorScene = nullptr;
+#endif
+    _jobs = nullptr;
     _assets = nullptr;
     _batch = nullptr;
 
@@ -53,6 +85,8 @@ void PanicPainterApp::onShutdown() {
 }
 
 void PanicPainterApp::onSuspend() {
+    // The app may be killed from here on without another word.
+    SaveController::getInstance()->flush();
     AudioEngine::get()->pause();
 }
 
@@ -63,70 +97,95 @@ void PanicPainterApp::onResume() {
 void PanicPainterApp::onLoaded() {
     GlobalConfigController::getInstance().load(_assets);
     InputController::getInstance().loadConfig();
+
+#ifdef AUDIO_DEBUG
+    Size screenSize = Application::get()->getDisplaySize();
+    _monitorScene = Scene2::alloc(screenSize);
+    _monitor = AudioMonitor::alloc(_assets,
+                                   Rect(0, 0, screenSize.width * .5f,
+                                        screenSize.height * .2f));
+    _monitorScene->addChild(_monitor);
+#endif
+}
+
+void PanicPainterApp::onWarmedUp() {
+#ifdef BENCHMARK
+    Benchmark::parseLevels(WARMUP_DIRECTORY, 100);
+    Benchmark::loadLevels(WARMUP_DIRECTORY, _assets);
+    Benchmark::threadPool(1024);
+#endif
 }
 
 void PanicPainterApp::update(float timestep) {
+#ifdef ALLOC_DEBUG
+    Benchmark::countFrame();
+#endif
+    // Temporaries of the last frame are all gone.
+    FrameArena::reset();
+
     // Update global controllers.
     Animation::updateGlobal(timestep);
+    Filmstrip::updateGlobal(timestep);
     InputController::getInstance().update(timestep);
+#ifdef AUDIO_DEBUG
+    if (_monitor != nullptr) _monitor->update();
+#endif
 
     switch (_currentScene) {
         case LOADING_SCENE: {
+            // Only the menu is built before it shows. The rest warms up after.
+            if (!_booted && _assets->progress() >= 1) {
+                _booted = true;
+                StartupTimeline::mark("boot");
+                _jobs->addOnce([=]() { onLoaded(); });
+                _jobs->addOnce([=]() { _menu.init(_assets); });
+            }
+
             if (_loading.isActive()) {
                 // If loading scene is still active, the loading is not done
                 // yet. Update loading scene.
                 _loading.update(0.01f);
 
             } else {
-                onLoaded();
-
-                // Initializing game scene.
-                _gameplay.init(_assets);
-
-                // Initialize world select screen
-                _world.init(_assets);
-
-                // Initialize level select screen
-                _level.init(_assets);
-
-                // Initialize pause screen
-                _pause.init(_assets);
-
-                // Initialize settings screen
-                _settings.init(_assets);
-                _credits.init(_assets);
-
-                // Initialize Menu_Scene and set scene to menu
-                _menu.init(_assets);
                 _loading.dispose();
                 _currentScene = MENU_SCENE;
                 _menu.activate();
+                _menu.setWaiting(true);
+                StartupTimeline::mark("interactive");
+                _warmUp();
             }
             break;
         }
         case GAME_SCENE: {
-            if (_gameplay.getPauseRequest()) {
+            if (_gameplay->getPauseRequest()) {
                 // switch to pause screen and let pause screen know what level it is
                 _currentScene = PAUSE_SCENE;
                 _pause.resetState();
                 _pause.activate();
-            } else if (_gameplay.isComplete()) {
-                if (_gameplay.getLevel() == "space-5") {
+                // Get a fresh copy of the level ready in case of a retry.
+                _prepareLevel(_gameplay->getLevel());
+            } else if (_gameplay->isComplete()) {
+                if (_gameplay->getLevel() == "space-5") {
                     _currentScene = CREDITS_SCENE;
                     _credits.resetState();
                     _credits.activate(false);
+                    _gameplay->unload();
                 } else {
                     _currentScene = WORLD_SCENE;
                     _world.resetState();
                     _world.activate();
+                    // The player will likely go on in the same world.
+                    _prepareLevel(_level.getLikelyLevel());
+                    _gameplay->unload();
                 }
             } else {
-                _gameplay.update(timestep);
+                _gameplay->update(timestep);
             }
             break;
         }
         case MENU_SCENE: {
-            if (_menu.getState() == LEVELS) {
+            // The buttons only lead anywhere once the scenes are built.
+            if (_warm && _menu.getState() == LEVELS) {
                 //_menu.dispose();
                 _currentScene = WORLD_SCENE;
                 _menu.resetState();
@@ -134,7 +193,7 @@ void PanicPainterApp::update(float timestep) {
                 _world.resetState();
                 _menu.deactivate();
                 _world.activate();
-            } else if (_menu.getState() == SETTINGS) {
+            } else if (_warm && _menu.getState() == SETTINGS) {
                 _currentScene = SETTINGS_SCENE;
                 _menu.resetState();
                 _settings.activate();
@@ -152,13 +211,16 @@ void PanicPainterApp::update(float timestep) {
                 _menu.resetState();
                 _world.deactivate();
                 _menu.activate();
-            } else if (_world.getState() == SELECTED) {
+            } else if (_world.getState() == SELECTED &&
+                       _level.prefetchWorld(_world.getWorld())) {
+                // The world only opens once its assets are in.
                 _menu.resetState();
                 _world.resetState();
                 _level.loadWorld(
                     _world.getWorld().c_str()); // fetch the specific world
                 _world.deactivate();
                 _currentScene = LEVEL_SCENE;
+                _prepareLevel(_level.getLikelyLevel());
             }
             break;
         }
@@ -172,12 +234,13 @@ void PanicPainterApp::update(float timestep) {
                 _currentScene = WORLD_SCENE;
             }
             else if (_level.getState() == L_SELECTED) {
-                _gameplay.loadLevel(
-                    _level.getLevel()); // fetch the specific level
-                _currentScene = GAME_SCENE;
-                _menu.resetState();
-                _level.resetState();
-                _level.deactivate();
+                // fetch the specific level
+                if (_playLevel(_level.getLevel())) {
+                    _currentScene = GAME_SCENE;
+                    _menu.resetState();
+                    _level.resetState();
+                    _level.deactivate();
+                }
             } else {
                 _level.update(timestep);
             }
@@ -193,14 +256,14 @@ void PanicPainterApp::update(float timestep) {
             }
             else if (_pause.getState() == RETRY) {
                 // return to game scene after re-loading level
-                _gameplay.loadLevel(
-                    _gameplay.getLevel());
-                // re-fetch the current level
-                _currentScene = GAME_SCENE;
-                _pause.resetState();
-                _pause.deactivate();
+                if (_playLevel(_gameplay->getLevel())) {
+                    _currentScene = GAME_SCENE;
+                    _pause.resetState();
+                    _pause.deactivate();
+                }
             }
             else if (_pause.getState() == MENU) {
+                _gameplay->unload();
                 _currentScene = WORLD_SCENE;
                 _world.resetState();
                 _pause.resetState();
@@ -259,6 +322,85 @@ void PanicPainterApp::update(float timestep) {
     }
 }
 
+void PanicPainterApp::_warmUp() {
+    // This is held for as long as the app runs.
+    AssetGroupController::getInstance().acquire(WARMUP_GROUP, [=]() {
+        StartupTimeline::mark("warm");
+        _gameplay = make_shared<GameScene>();
+        _standby = make_shared<GameScene>();
+
+        // One job per scene, so each frame only builds what fits the budget.
+        _jobs->addOnce([=]() { _gameplay->init(_assets); });
+        _jobs->addOnce([=]() { _standby->init(_assets); });
+        _jobs->addOnce([=]() { _world.init(_assets); });
+        _jobs->addOnce([=]() { _level.init(_assets); });
+        _jobs->addOnce([=]() { _pause.init(_assets); });
+        _jobs->addOnce([=]() { _settings.init(_assets); });
+        _jobs->addOnce([=]() { _credits.init(_assets); });
+        _jobs->addOnce([=]() {
+            _warm = true;
+            _menu.setWaiting(false);
+            onWarmedUp();
+            StartupTimeline::mark("built");
+            StartupTimeline::report();
+        });
+    });
+}
+
+void PanicPainterApp::_prepareLevel(const string &levelName) {
+    if (_standby->isPreparing(levelName)) return;
+    // Hold on to this scene, as the standby may be swapped by then.
+    auto scene = _standby;
+    scene->prepareLevel(levelName, [=]() {
+        // Once the scene is prepared again, this job is dropped.
+        uint preparation = scene->getPreparation();
+        _jobs->add([=]() {
+            if (scene->getPreparation() != preparation) return true;
+            if (scene->isWaiting()) {
+                _jobs->wait();
+                return false;
+            }
+            return scene->loadStep();
+        });
+    });
+}
+
+bool PanicPainterApp::_playLevel(const string &levelName) {
+    _prepareLevel(levelName);
+    if (!_standby->isLoaded()) return false;
+    swap(_gameplay, _standby);
+    _standby->unload();
+    return true;
+}
+
+bool PanicPainterApp::needsRedraw() {
+    bool changed = _currentScene != _shownScene;
+    _shownScene = _currentScene;
+#ifdef AUDIO_DEBUG
+    if (_monitorScene != nullptr) return true;
+#endif
+    switch (_currentScene) {
+        case LOADING_SCENE:
+            return changed || _loading.isDirty();
+        case GAME_SCENE:
+            return changed || _gameplay->isDirty();
+        case MENU_SCENE:
+            return changed || _menu.isDirty();
+        case WORLD_SCENE:
+            return changed || _world.isDirty();
+        case LEVEL_SCENE:
+            return changed || _level.isDirty();
+        case PAUSE_SCENE:
+            return changed || _gameplay->isDirty() || _pause.isDirty();
+        case SETTINGS_SCENE:
+            return changed || _settings.isDirty();
+        case CREDITS_SCENE:
+            return changed || _credits.isDirty();
+        default:
+            return true;
+    }
+}
+
 void PanicPainterApp::draw() {
     switch (_currentScene) {
         case LOADING_SCENE: {
@@ -267,7 +409,7 @@ void PanicPainterApp::draw() {
         }
 
         case GAME_SCENE: {
-            _gameplay.render(_batch);
+            _gameplay->render(_batch);
             break;
         }
 
@@ -287,7 +429,7 @@ void PanicPainterApp::draw() {
         }
 
         case PAUSE_SCENE: {
-            _gameplay.render(_batch);
+            _gameplay->render(_batch);
             _pause.render(_batch);
             break;
         }
@@ -309,4 +451,14 @@ void PanicPainterApp::draw() {
             break;
         }
     }
+#ifdef AUDIO_DEBUG
+    if (_monitorScene != nullptr) _monitorScene->render(_batch);
+#endif
+#ifdef PIPELINED_DRAW
+    _batch->publish();
+#endif
+}
+
+void PanicPainterApp::submit() {
+    _batch->submit();
 }
@@ -3,6 +3,12 @@
 
 #include "utils/PPHeader.h"
 #include "utils/PPAnimation.h"
+#include "utils/PPFilmstrip.h"
+#include "utils/PPAudioMonitor.h"
+#include "utils/PPBenchmark.h"
+#include "utils/PPFrameArena.h"
+#include "utils/PPJobQueue.h"
+#include "utils/PPStartupTimeline.h"
 #include "scenes/loading/PPLoadingScene.h"
 #include "scenes/gameplay/PPGameScene.h"
 #include "scenes/pause/PPPauseScene.h"
@@ -16,6 +22,7 @@
 #include "controllers/PPSaveController.h"
 #include "controllers/PPInputController.h"
 #include "controllers/PPSoundController.h"
+#include "controllers/PPAssetGroupController.h"
 
 /** An enum for the list of scenes. */
 enum Scene {
@@ -39,13 +46,26 @@ protected:
     ptr<SpriteBatch> _batch;
     /** Asset manager. */
     asset_t _assets;
+    /** Work spread over several frames, such as building scenes. */
+    ptr<JobQueue> _jobs;
+    /** Whether the boot assets are loaded and the menu is being built. */
+    bool _booted;
+    /** Whether the other assets are loaded and every scene is built. */
+    bool _warm;
     /** The current scene. */
     Scene _currentScene;
+    /** The scene that the last frame showed. */
+    Scene _shownScene;
 
     /** Loading scene. */
     LoadingScene _loading;
     /** Gameplay scene. */
-    GameScene _gameplay;
+    ptr<GameScene> _gameplay;
+    /**
+     * A second gameplay scene, built a little every frame for the level the
+     * player will likely play next. It is swapped in if they do.
+     */
+    ptr<GameScene> _standby;
     /** Menu scene. */
     MenuScene _menu;
     /** World select scene. */
@@ -58,9 +78,37 @@ protected:
     SettingsScene _settings;
     CreditsScene _credits;
 
+#ifdef AUDIO_DEBUG
+    /** Overlay scene for the audio thread timing graph. */
+    ptr<Scene2> _monitorScene;
+    /** The audio thread timing graph. */
+    ptr<AudioMonitor> _monitor;
+#endif
+
+    /**
+     * Load the assets that are not needed by the menu, then build every
+     * other scene. This starts once the menu is showing.
+     */
+    void _warmUp();
+
+    /**
+     * Start preparing a level in the standby scene, a step per job, unless
+     * it is already being prepared.
+     */
+    void _prepareLevel(const string &levelName);
+
+    /**
+     * Show the gameplay scene with a level once the standby scene has it
+     * ready. Call this every frame until it returns true.
+     * @return Whether the level is now in the gameplay scene.
+     */
+    bool _playLevel(const string &levelName);
+
 public:
     /** Constructor. */
-    PanicPainterApp() : Application(), _currentScene(LOADING_SCENE) {}
+    PanicPainterApp() : Application(), _booted(false), _warm(false),
+                        _currentScene(LOADING_SCENE),
+                        _shownScene(LOADING_SCENE) {}
 
     /** Destructor. */
     ~PanicPainterApp() = default;
@@ -73,11 +121,23 @@ public:
 
     void onResume() override;
 
+    /** Called once the boot assets are loaded, before the menu shows. */
     void onLoaded();
 
+    /** Called once every asset is loaded and every scene is built. */
+    void onWarmedUp();
+
     void update(float timestep) override;
 
+    /**
+     * Whether the scenes that are showing changed since the last frame.
+     * Static screens stop drawing, and idle, until they change again.
+     */
+    bool needsRedraw() override;
+
     void draw() override;
+
+    void submit() override;
 };
 
 #endif // PANICPAINTER_PPAPP_H
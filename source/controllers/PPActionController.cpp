@@ -1,157 +1,131 @@
 #include "PPActionController.h"
 #define LEVEL_MULTIPLIER_INCREMENT 0.1
 
-void ActionController::update(const set<pair<uint, uint>> &activeCanvases,
+void ActionController::update(const frame_set<pair<uint, uint>> &activeCanvases,
                               uint selectedColor) {
     auto &input = InputController::getInstance();
+    auto &pointers = input.pointers();
 
-    // This saves the position of the canvas where dragging starts.
-    // If {-1, -1} that means we are not dragging.
-    int dragStart[2] = {-1, -1};
+    _active.clear();
+    _drags.clear();
 
-    // First passthrough of the canvas.
-    for (uint i = 0, j = _state.numQueues(); i < j; i++) {
-        for (uint i2 = 0, j2 = _state.numCanvases(i); i2 < j2; i2++) {
-            int prevColors = (int) _state.getColorsOfCanvas(i, i2).size();
-            // At the beginning of a frame, set canvas hover to false.
-//            _canvases[i][i2]->setHover(false);
+    // First passthrough of the canvas. Only active canvases take input, and
+    // only canvases in view have a node, so the set is walked directly.
+    for (auto &active : activeCanvases) {
+        uint i = active.first, i2 = active.second;
+        int prevColors = (int) _state.getColorsOfCanvas(i, i2).size();
 
-            // This whole block is for processing inputs.
-            // Only process input on active canvases.
-            if (activeCanvases.find(pair<uint, uint>(i, i2)) !=
-                activeCanvases.end()) {
-                // Cache two useful input values.
-                bool startingPointIn =
-                    InputController::inScene(input.startingPoint(),
-                                             _canvases[i][i2]->getInteractionNode());
-                bool currentPointIn =
-                    InputController::inScene(input.currentPoint(),
-                                             _canvases[i][i2]->getInteractionNode());
-                // SCRIBBLING
-                if (input.didDoubleTap() && !_state.getIsHealthPotion(i, i2) && input.justReleased() &&
-                    startingPointIn && currentPointIn) {
-                    _state.addSplat(i, i2);
-                    auto n = _state.clearColor(i, i2, selectedColor);
-                    if (n == GameStateController::ALL_CLEAR) {
-                        SoundController::getInstance()->playSfx(
-//                            Random::getInstance()->getBool() ? "correct1" :
-                            "correct2");
-                    } else if (n == GameStateController::NO_MATCH) {
-                        SoundController::getInstance()->playSfx("incorrect");
-                    }
-                    SoundController::getInstance()->playSfx("scribble");
-                    int newColors = (int) _state.getColorsOfCanvas(i, i2).size();
-                    if (newColors >= prevColors) {
-                        _state.setLevelMultiplier(1);
-                    } else {
-                        _state.incrementScoreForSwipe(1);
-                    }
-                    input.clearPreviousTaps();
-                }
-
-                if (input.isPressing() && startingPointIn && currentPointIn) {
-//                    _canvases[i][i2]->setHover(true);
-                }
-                //Vertical swipe
-                if (_state.getIsHealthPotion(i, i2) && input.justReleased()) {
-                    ptr<SceneNode> lastCanvas = _canvases[i][i2]->getInteractionNode();
-                    Mat4 in_start_mat = lastCanvas->getNodeToWorldTransform();
-                    Rect in_start_box = in_start_mat.transform(
-                        Rect(Vec2::ZERO, lastCanvas->getContentSize()));
-                    if (startingPointIn &&
-                        (input.currentPoint().y > in_start_box.getMaxY() &&
-                            input.currentPoint().x < in_start_box.getMaxX() &&
-                            input.currentPoint().x > in_start_box.getMinX())) {
-                        _state.clearHealthPotion(i, i2);
-                    }
-                }
-                // DRAGGING
-                if (!_state.getIsHealthPotion(i, i2) && startingPointIn && input.hasMoved() &&
-                    (input.justReleased() || input.isPressing())) {
-                    dragStart[0] = i;
-                    dragStart[1] = i2;
-                    // Save the starting canvas index.
-                    // The actual processing of dragging will be done in the second passthrough.
-                }
+        // This whole block is for processing inputs.
+        // The interaction bounds are computed once per frame and shared
+        // by every pointer and by the drag pass below.
+        ptr<SceneNode> node = _queues[i]->get(i2)->getInteractionNode();
+        Rect box = node->getNodeToWorldTransform().transform(
+            Rect(Vec2::ZERO, node->getContentSize()));
+        _active.push_back({i, i2, box});
 
+        // Cache two useful input values.
+        bool startingPointIn =
+            InputController::inScene(input.startingPoint(), box);
+        bool currentPointIn =
+            InputController::inScene(input.currentPoint(), box);
+        // SCRIBBLING
+        if (input.didDoubleTap() && !_state.getIsHealthPotion(i, i2) && input.justReleased() &&
+            startingPointIn && currentPointIn) {
+            // The sound of the result comes with the event of clearing.
+            _state.clearColor(i, i2, selectedColor);
+            SoundController::getInstance()->playSfx("scribble");
+            int newColors = (int) _state.getColorsOfCanvas(i, i2).size();
+            if (newColors >= prevColors) {
+                _state.setLevelMultiplier(1);
+            } else {
+                _state.incrementScoreForSwipe(1);
             }
+            input.clearPreviousTaps();
         }
-    }
 
-    // Handle drag here.
-    if (dragStart[0] >= 0) {
-        // This is the list of canvases that are covered by the drag.
-        vec<pair<int, int>> toClear;
+        if (input.isPressing() && startingPointIn && currentPointIn) {
+//                _queues[i]->get(i2)->setHover(true);
+        }
 
-        // The second passthrough the canvas matrix.
-        for (uint i = 0, j = _state.numQueues(); i < j; i++) {
-            for (uint i2 = 0, j2 = _state.numCanvases(i); i2 < j2; i2++) {
-                // Again we don't deal with anything that is not active.
-                if (activeCanvases.find(pair<uint, uint>(i, i2)) ==
-                    activeCanvases.end()) {
-                    continue;
+        for (auto &pointer : pointers) {
+            if (!InputController::inScene(pointer.startingPoint, box))
+                continue;
+            //Vertical swipe
+            if (_state.getIsHealthPotion(i, i2)) {
+                if (pointer.released &&
+                    pointer.currentPoint.y > box.getMaxY() &&
+                    pointer.currentPoint.x < box.getMaxX() &&
+                    pointer.currentPoint.x > box.getMinX()) {
+                    _state.clearHealthPotion(i, i2);
+                    break;
                 }
-                // This whole block basically checks if this dragging session covers this canvas.
-                ptr<SceneNode> in_start =
-                    _canvases[dragStart[0]][dragStart[1]]->getInteractionNode();
-                ptr<SceneNode> in_end = _canvases[i][i2]->getInteractionNode();
-                Mat4 in_start_mat = in_start->getNodeToWorldTransform();
-                Mat4 in_end_mat = in_end->getNodeToWorldTransform();
-                Rect in_start_box = in_start_mat.transform(
-                    Rect(Vec2::ZERO, in_start->getContentSize()));
-                Rect in_end_box = in_end_mat.transform(
-                    Rect(Vec2::ZERO, in_end->getContentSize()));
+            }
+            // DRAGGING
+            else if (pointer.moved &&
+                     (pointer.released || pointer.pressing)) {
+                // Save the starting canvas index.
+                // The actual processing of dragging will be done in the second passthrough.
+                _drags.push_back({&pointer, _active.size() - 1, {}});
+            }
+        }
+    }
 
-                if (
-                    (i == dragStart[0] && i2 == dragStart[1]) ||
-                    (in_start_box.getMinX() > in_end_box.getMinX() ?
-                     input.currentPoint().x <= in_end_box.getMaxX() :
-                     input.currentPoint().x >= in_end_box.getMinX())
-                    ) {
-                    _state.addSplat(i, i2);
-//                    _canvases[i][i2]->setHover(input.isPressing());
-                    toClear.push_back({i, i2});
-                }
+    if (_drags.empty()) return;
+
+    // The second passthrough, over the active canvases only. Each canvas is
+    // checked against every drag at once.
+    for (size_t k = 0; k < _active.size(); k++) {
+        const ActiveCanvas &end = _active[k];
+        for (auto &drag : _drags) {
+            // This basically checks if this dragging session covers this canvas.
+            const Rect &start = _active[drag.start].bounds;
+            float x = drag.pointer->currentPoint.x;
+            if (k == drag.start ||
+                (start.getMinX() > end.bounds.getMinX() ?
+                 x <= end.bounds.getMaxX() :
+                 x >= end.bounds.getMinX())) {
+//                _queues[end.queue]->get(end.pos)->setHover(drag.pointer->pressing);
+                drag.toClear.push_back({end.queue, end.pos});
             }
         }
+    }
 
+    frame_set<pair<uint, uint>> cleared;
+    for (auto &drag : _drags) {
         // When dragging is done, make sure more than 1 canvas is covered.
         // If there is only one, that means the user started dragging but went back to the original canvas.
         // This suggests that he/she/they gave up on dragging.
-        if (input.justReleased() && toClear.size() > 1) {
-            int numCorrect = 0;
-            uint z = 0; // 0 is no canvas cleared or lost, 1 is at least
-            // one canvas cleared and no lost, 2 is at least one canvas lost
-            // (clear doesn't matter)
-            for (auto &p : toClear) {
-                int prevColors = (int) _state.getColorsOfCanvas(p.first, p.second).size();
-                auto i = _state.clearColor(p.first, p.second, selectedColor);
-                if (i == GameStateController::ALL_CLEAR && i == 0) z = 1;
-                else if (i == GameStateController::NO_MATCH) z = 2;
-                int newColors = (int) _state.getColorsOfCanvas(p.first, p.second).size();
-                if (newColors < prevColors) { 
-                    numCorrect += 1;
-                    
-                }
-            }
-            if (z == 1) {
-                SoundController::getInstance()->playSfx(
-//                    Random::getInstance()->getBool() ? "correct1" :
-                    "correct2");
-            } else if (z == 2) {
-                SoundController::getInstance()->playSfx("incorrect");
-            }
-            _state.incrementScoreForSwipe(1 + numCorrect * 1.5);
-            if (toClear.size() == numCorrect) {
-                CULog("Previous multiplier after swipe: %f", _state.getLevelMultiplier());
-                _state.setLevelMultiplier(min(3.0f,
-                                              (float)(_state.getLevelMultiplier() +
-                                                      LEVEL_MULTIPLIER_INCREMENT * numCorrect)));
-                CULog("New multiplier after swipe %f", _state.getLevelMultiplier());
-            } else {
-                _state.setLevelMultiplier(1);
-            }
-            
+        if (drag.pointer->released && drag.toClear.size() > 1)
+            _finishDrag(drag, selectedColor, cleared);
+    }
+}
+
+void ActionController::_finishDrag(const Drag &drag, uint selectedColor,
+                                   frame_set<pair<uint, uint>> &cleared) {
+    size_t numCorrect = 0;
+    size_t numSkipped = 0;
+    for (auto &p : drag.toClear) {
+        // Two fingers may cover the same canvas; only clear it once.
+        if (!cleared.insert(p).second) {
+            numSkipped += 1;
+            continue;
         }
+        int prevColors = (int) _state.getColorsOfCanvas(p.first, p.second).size();
+        _state.clearColor(p.first, p.second, selectedColor);
+        int newColors = (int) _state.getColorsOfCanvas(p.first, p.second).size();
+        if (newColors < prevColors) {
+            numCorrect += 1;
+
+        }
+    }
+    _state.incrementScoreForSwipe(1 + numCorrect * 1.5);
+    if (drag.toClear.size() - numSkipped == numCorrect) {
+        CULog("Previous multiplier after swipe: %f", _state.getLevelMultiplier());
+        _state.setLevelMultiplier(min(3.0f,
+                                      (float)(_state.getLevelMultiplier() +
+                                              LEVEL_MULTIPLIER_INCREMENT * numCorrect)));
+        CULog("New multiplier after swipe %f", _state.getLevelMultiplier());
+    } else {
+        _state.setLevelMultiplier(1);
     }
 }
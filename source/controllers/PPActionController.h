@@ -3,30 +3,66 @@
 
 #include "utils/PPHeader.h"
 #include "utils/PPRandom.h"
+#include "utils/PPFrameArena.h"
 #include "PPInputController.h"
 #include "PPSoundController.h"
 #include "PPGameStateController.h"
-#include "scenes/gameplay/PPCanvas.h"
+#include "scenes/gameplay/PPQueueView.h"
 
 /**
  * ActionController takes raw input and interpret it to actions. It then
- * applies those actions directly.
+ * applies those actions directly. Every pointer can drag at the same time,
+ * so two queues can be cleared with two fingers.
  * @author Dragonglass Studios
  */
 class ActionController {
+    /** An active canvas and its interaction bounds in world coordinates. */
+    struct ActiveCanvas {
+        uint queue;
+        uint pos;
+        Rect bounds;
+    };
+
+    /** A drag of a single pointer across the active canvases. */
+    struct Drag {
+        /** The pointer doing the drag. */
+        const InputController::Pointer *pointer;
+        /** Index into _active of the canvas where the drag started. */
+        size_t start;
+        /**
+         * The canvases covered by the drag. This only lives for the frame,
+         * and holds nothing to destroy, so it is fine that its memory is
+         * taken back before _drags is cleared the next frame.
+         */
+        frame_vec<pair<uint, uint>> toClear;
+    };
+
+    /** Active canvases of this frame. Kept to reuse its storage. */
+    vec<ActiveCanvas> _active;
+
+    /** Drags of this frame. Kept to reuse its storage. */
+    vec<Drag> _drags;
+
+    /**
+     * Clear the canvases covered by a finished drag. Canvases already
+     * cleared by another drag this frame are skipped.
+     */
+    void _finishDrag(const Drag &drag, uint selectedColor,
+                     frame_set<pair<uint, uint>> &cleared);
+
 public:
-    vec<vec<ptr<Canvas>>> &_canvases;
+    vec<ptr<QueueView>> &_queues;
     GameStateController &_state;
 
     /** Constructor. */
     ActionController(
         GameStateController &state,
-        vec<vec<ptr<Canvas>>> &canvases) :
+        vec<ptr<QueueView>> &queues) :
         _state(state),
-        _canvases(canvases) {}
+        _queues(queues) {}
 
     void update(
-        const set<pair<uint, uint>> &activeCanvases,
+        const frame_set<pair<uint, uint>> &activeCanvases,
         uint selectedColor);
 
 };
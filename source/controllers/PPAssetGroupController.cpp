@@ -0,0 +1,145 @@
+#include "PPAssetGroupController.h"
+
+/** Where the asset directories of groups are, relative to the assets. */
+#define GROUP_DIRECTORY "config/groups/"
+
+AssetGroupController AssetGroupController::_instance;
+
+void AssetGroupController::init(const asset_t &assets) {
+    _assets = assets;
+}
+
+void AssetGroupController::dispose() {
+    for (auto &it : _groups) {
+        if (it.second.loaded) _assets->unloadDirectory(it.second.directory);
+    }
+    _groups.clear();
+    _assets = nullptr;
+}
+
+void AssetGroupController::acquire(const string &name,
+                                   const function<void()> &ready) {
+    Group &group = _groups[name];
+    group.refs++;
+    if (group.loaded) {
+        if (ready) ready();
+        return;
+    }
+    if (ready) group.waiting.push_back(ready);
+    // If it is still loading from an earlier acquire(), just wait for it.
+    if (group.pending == 0) _load(name, group);
+}
+
+void AssetGroupController::release(const string &name) {
+    auto it = _groups.find(name);
+    CUAssertLog(it != _groups.end() && it->second.refs > 0,
+                "Asset group %s was not acquired.", name.c_str());
+    if (it == _groups.end() || it->second.refs == 0) return;
+
+    Group &group = it->second;
+    group.refs--;
+    // A group still loading is unloaded once it is done instead.
+    if (group.refs > 0 || !group.loaded) return;
+    _assets->unloadDirectory(group.directory);
+    group.loaded = false;
+#ifdef BENCHMARK
+    CULog("Unloaded asset group %s.", name.c_str());
+    report();
+#endif
+}
+
+bool AssetGroupController::isLoaded(const string &name) const {
+    auto it = _groups.find(name);
+    return it != _groups.end() && it->second.loaded;
+}
+
+void AssetGroupController::_load(const string &name, Group &group) {
+    if (group.directory == nullptr) {
+        auto reader =
+            JsonReader::allocWithAsset(GROUP_DIRECTORY + name + ".json");
+        if (reader != nullptr) group.directory = reader->readJson();
+        if (group.directory == nullptr) {
+            CULogError("Cannot find asset group %s.", name.c_str());
+            group.directory = JsonValue::allocObject();
+        }
+    }
+
+    // One callback comes back for every asset in every category.
+    for (size_t i = 0; i < group.directory->size(); i++) {
+        group.pending += (uint) group.directory->get((int) i)->size();
+    }
+    if (group.pending == 0) {
+        group.pending = 1;
+        _loadedOne(name);
+        return;
+    }
+    _assets->loadDirectoryAsync(group.directory,
+        [this, name](const string &key, bool success) {
+            if (!success) {
+                CULogError("Cannot load %s of asset group %s.",
+                           key.c_str(), name.c_str());
+            }
+            _loadedOne(name);
+        });
+}
+
+void AssetGroupController::_loadedOne(const string &name) {
+    auto it = _groups.find(name);
+    // The controller may have been disposed while this was loading.
+    if (it == _groups.end() || it->second.pending == 0) return;
+    Group &group = it->second;
+    if (--group.pending > 0) return;
+
+    group.loaded = true;
+    if (group.refs == 0) {
+        // Everybody let go while it was loading.
+        group.waiting.clear();
+        _assets->unloadDirectory(group.directory);
+        group.loaded = false;
+        return;
+    }
+#ifdef BENCHMARK
+    CULog("Loaded asset group %s.", name.c_str());
+    report();
+#endif
+    // The callbacks may acquire other groups, so do not hold on to this one.
+    auto waiting = move(group.waiting);
+    group.waiting.clear();
+    for (auto &ready : waiting) ready();
+}
+
+void AssetGroupController::_measure(const Group &group, size_t &textures,
+                                    size_t &sounds) const {
+    textures = sounds = 0;
+    // Textures are RGBA with 8 bits per channel. Mipmaps are not counted.
+    json_t list = group.directory->get("textures");
+    for (size_t i = 0; list != nullptr && i < list->size(); i++) {
+        auto texture = _assets->get<Texture>(list->get((int) i)->key());
+        if (texture == nullptr) continue;
+        textures += (size_t) texture->getWidth() * texture->getHeight() * 4;
+    }
+    // Only samples decoded into memory take space. Streams do not.
+    list = group.directory->get("sounds");
+    for (size_t i = 0; list != nullptr && i < list->size(); i++) {
+        auto sample = dynamic_pointer_cast<AudioSample>(
+            _assets->get<Sound>(list->get((int) i)->key()));
+        if (sample == nullptr || sample->isStreamed()) continue;
+        sounds += (size_t) sample->getLength() * sample->getChannels() *
+                  sizeof(float);
+    }
+}
+
+void AssetGroupController::report() const {
+    size_t total = 0;
+    for (auto &it : _groups) {
+        size_t textures = 0, sounds = 0;
+        if (it.second.loaded) _measure(it.second, textures, sounds);
+        total += textures + sounds;
+        CULog("Asset group %s: %u refs, %s, textures %zu KB, sounds %zu KB",
+              it.first.c_str(), it.second.refs,
+              it.second.loaded ? "loaded" :
+              it.second.pending > 0 ? "loading" : "unloaded",
+              textures / 1024, sounds / 1024);
+    }
+    CULog("Asset groups: %zu KB resident.", total / 1024);
+}
@@ -0,0 +1,78 @@
+#ifndef PANICPAINTER_PPASSETGROUPCONTROLLER_H
+#define PANICPAINTER_PPASSETGROUPCONTROLLER_H
+
+#include <unordered_map>
+#include "utils/PPHeader.h"
+
+/**
+ * Asset group controller keeps the assets that only some scenes need, like
+ * the background and music of each world, loaded only while a scene holds
+ * on to them.
+ *
+ * A group is an asset directory file in config/groups, in the same format as
+ * config/assets.json. The first acquire() loads it in the background, and
+ * the last release() unloads it. Scenes that hold on to a group before they
+ * need it get it prefetched.
+ * @author Dragonglass Studios
+ */
+class AssetGroupController {
+private:
+    /** A group and who is using it. */
+    struct Group {
+        /** The asset directory of the group. */
+        json_t directory;
+        /** The number of acquire() calls not yet released. */
+        uint refs;
+        /** The number of assets still loading. */
+        uint pending;
+        /** Whether the assets are in the asset manager. */
+        bool loaded;
+        /** Called once the group is loaded. */
+        vec<function<void()>> waiting;
+    };
+
+    /** Asset manager. */
+    asset_t _assets;
+
+    /** Every group that was ever acquired. */
+    unordered_map<string, Group> _groups;
+
+    static AssetGroupController _instance;
+
+    /** Start loading a group. */
+    void _load(const string &name, Group &group);
+
+    /** Called when an asset of a group has loaded. */
+    void _loadedOne(const string &name);
+
+    /** Get the bytes taken by the textures and the sounds of a group. */
+    void _measure(const Group &group, size_t &textures, size_t &sounds) const;
+
+public:
+    /** Set up with the asset manager. */
+    void init(const asset_t &assets);
+
+    /** Unload every group. */
+    void dispose();
+
+    /**
+     * Hold on to a group, loading it if it is not loaded yet.
+     * @param name The name of the group.
+     * @param ready Called on the main thread once the group is loaded. If
+     * it is already loaded, this is called right away.
+     */
+    void acquire(const string &name, const function<void()> &ready = nullptr);
+
+    /** Let go of a group. It is unloaded once nobody holds on to it. */
+    void release(const string &name);
+
+    /** Whether a group is loaded. */
+    bool isLoaded(const string &name) const;
+
+    /** Log the references and the memory of every group. */
+    void report() const;
+
+    static AssetGroupController &getInstance() { return _instance; }
+};
+
+#endif //PANICPAINTER_PPASSETGROUPCONTROLLER_H
@@ -1,16 +1,6 @@
 #include "PPGameStateController.h"
 
-void GameStateController::_jsonv1_loadColors(const json_t &colors) {
-    _state.colors.clear();
-    string shapes[] = {"color-circle", "color-heart", "color-square", "color-diamond", "color-triangle"};
-    auto colorsArray = colors->asArray();
-    for (uint i = 0; i < colorsArray.size(); i++) {
-        const vec<int> c = colorsArray[i]->asIntArray();
-        _state.colorShapeMapping[i] = shapes[i];
-        CUAssertLog(c.size() == 3, "A color must have three elements.");
-        _state.colors.emplace_back(c[0], c[1], c[2]);
-    }
-    
+void GameStateController::_loadScores() {
     _state.scoreTracker["wrongAction"] = 0;
     _state.scoreTracker["timedOut"] = 0;
     _state.scoreTracker["correct"] = 0;
@@ -18,250 +8,247 @@ void GameStateController::_jsonv1_loadColors(const json_t &colors) {
     _state.levelMultiplier = 1;
 }
 
-void GameStateController::_jsonv1_loadQueues(const json_t &queues) {
-    _state.nCanvasInLevel = 0;
+void GameStateController::_loadQueues(const Level &level) {
+    _state.nCanvasInLevel = level.numCanvases();
     _state.queues.clear();
-    _state.wrongActions.clear();
-    _state.recorded.clear();
-    _state.obstacles.clear();
-    _state.splats.clear();
+    _state.first.clear();
+    _state.active.clear();
     _state.healthBack = 0; 
     _state.tutorialTexture.clear();
-    // Build each queue.
-    for (const auto &queue : queues->asArray()) {
-        vec<vec<uint>> queue_s;
-        vec<bool> wa_queue_s;
-        vec<bool> r_queue_s;
-        vec<int> obs_queue_s;
-        vec<int> splts_queue_s;
-        // Build canvas of each queue.
-        for (const auto &canvas : queue->asArray()) {
-            _state.nCanvasInLevel++;
-            const auto r = canvas->asIntArray();
-            // This is to cast vec<int> to vec<uint>.
-            vec<uint> colors(r.begin(), r.end());
-            //Bomb obstacle
-            if (colors[colors.size() - 1] == ((uint)10)) {
-                obs_queue_s.push_back(1);
-                colors.pop_back();
-            }
-            //Health Potion
-           else if (colors[colors.size() - 1] == ((uint)12)) {
-                obs_queue_s.push_back(2);
-                
-            }
-            else {
-                obs_queue_s.push_back(0);
-            }
-            queue_s.push_back(colors);
-            wa_queue_s.push_back(false);
-            r_queue_s.push_back(false);
-            splts_queue_s.push_back(0);
-
-
-        }
-        _state.wrongActions.push_back(wa_queue_s);
-        _state.recorded.push_back(r_queue_s);
-        _state.queues.push_back(queue_s);
-        _state.obstacles.push_back(obs_queue_s);
-        _state.splats.push_back(splts_queue_s);
+    // Only the front of each queue is built. The rest comes up as it plays.
+    for (uint q = 0, nq = level.numQueues(); q < nq; q++) {
+        _state.queues.emplace_back();
+        _state.first.push_back(0);
+        _state.active.push_back(level.numCanvases(q) > 0 ? 0 : -1);
+        _slide(q);
     }
 }
 
-void GameStateController::_jsonv1_loadTimer(const json_t &timer) {
-    _state.canvasTimers.clear();
-
+void GameStateController::_loadTimer(const Level &level) {
     auto &gc = GlobalConfigController::getInstance();
 
     // For time, use global if not level-defined.
-    float
-        levelTime = timer == nullptr ? gc.getLevelTime() :
-                    timer->getFloat("levelTime", gc.getLevelTime()),
-        canvasBaseTime = timer == nullptr ? gc.getCanvasBaseTime() :
-                         timer->getFloat("canvasBaseTime",
-                                         gc.getCanvasBaseTime()),
-        canvasPerColorTime = timer == nullptr ? gc.getCanvasPerColorTime() :
-                             timer->getFloat("canvasPerColorTime",
-                                             gc.getCanvasPerColorTime());
-
-    for (uint queueInd = 0, queueLen = _state.queues.size();
-        queueInd < queueLen;
-        queueInd++) {
-        vec<ptr<Timer>> queueTimers;
-        vec<vec<uint>>& currentQueue = _state.queues[queueInd];
-        for (uint canvasInd = 0, canvasLen = currentQueue.size();
-            canvasInd < canvasLen;
-            canvasInd++) {
-            vec<uint>& canvasColors = currentQueue[canvasInd];
-            bool isHealthPotion = _state.obstacles[queueInd][canvasInd] == 2;
- 
-            float d = isHealthPotion ? canvasBaseTime / 3 :
-                canvasColors.size() * canvasPerColorTime + canvasBaseTime + 2;
-            ptr<Timer> t = Timer::alloc(d);
-            queueTimers.push_back(t);
+    _canvasBaseTime = level.getCanvasBaseTime(gc.getCanvasBaseTime());
+    _canvasPerColorTime =
+        level.getCanvasPerColorTime(gc.getCanvasPerColorTime());
+}
+
+void GameStateController::_slide(uint q) {
+    auto &window = _state.queues[q];
+    int active = _state.active[q];
+
+    // Take canvases up to the standby one.
+    const Level &level = *_context->getLevel();
+    uint last = active < 0 ? 0 : min((uint) active + 2, numCanvases(q));
+    for (uint c = _state.first[q] + (uint) window.size(); c < last; c++) {
+        CanvasProgress canvas;
+        canvas.colors.reserve(level.numColors(q, c) + 1);
+        for (uint i = 0, n = level.numColors(q, c); i < n; i++) {
+            canvas.colors.push_back(level.getColor(q, c, i));
+        }
+        canvas.wrongAction = false;
+        if (_context->isHealthPotion(q, c)) {
+            canvas.timer = Timer::alloc(_canvasBaseTime / 3);
+            //Health Potion. It keeps its marker until it is swiped away.
+            canvas.colors.push_back(LEVEL_HEALTH_POTION_MARKER);
+        } else {
+            canvas.timer = Timer::alloc(
+                canvas.colors.size() * _canvasPerColorTime +
+                _canvasBaseTime + 2);
         }
-        _state.canvasTimers.push_back(queueTimers);
+        window.push_back(move(canvas));
     }
-}
 
-void GameStateController::_jsonv1_loadTutorialTextureArray(const json_t &tutorialTextures) {
-    if (tutorialTextures != nullptr) {
-        _state.tutorialTexture = tutorialTextures->asStringArray();
+    // Drop the canvases that finished long enough ago.
+    uint finished = active < 0 ? (uint) window.size() :
+                    (uint) active - _state.first[q];
+    for (; finished > CANVAS_HISTORY; finished--) {
+        window.pop_front();
+        _state.first[q]++;
     }
 }
 
-void GameStateController::_jsonv1_load(const json_t &json) {
-    _jsonv1_loadColors(json->get("colors"));
-    _jsonv1_loadQueues(json->get("queues"));
-    _jsonv1_loadTimer(json->get("timer"));
-    _jsonv1_loadTutorialTextureArray(json->get("tutorialTextures"));
-    auto &gc = GlobalConfigController::getInstance();
-    _state.maxScore = json->getFloat("scoreThreshold", gc.getScoreThreshold());
+CanvasProgress &GameStateController::_progress(uint q, uint c) {
+    CUAssertLog(c >= _state.first[q] &&
+                c - _state.first[q] < _state.queues[q].size(),
+                "Canvas %d of queue %d is not in play.", c, q);
+    return _state.queues[q][c - _state.first[q]];
 }
 
-void GameStateController::loadJson(const json_t &json) {
-    int version = json->getInt("version");
+const CanvasProgress &GameStateController::_progress(uint q, uint c) const {
+    CUAssertLog(c >= _state.first[q] &&
+                c - _state.first[q] < _state.queues[q].size(),
+                "Canvas %d of queue %d is not in play.", c, q);
+    return _state.queues[q][c - _state.first[q]];
+}
 
-    // Load state by version of level JSON.
-    // This ensures backward compatibility.
-    if (version == 1)
-        _jsonv1_load(json);
-    else
-        CUAssertLog(false, "Unknown level version %d.", version);
+void GameStateController::loadLevel(const ptr<Level> &level) {
+    _context = LevelContext::alloc(level);
+    // Events and listeners of the last level mean nothing to this one.
+    _events.clear();
+    _listeners.clear();
+    _loadScores();
+    _loadTimer(*level);
+    _loadQueues(*level);
+    _state.tutorialTexture = level->getTutorialTextures();
+    auto &gc = GlobalConfigController::getInstance();
+    _state.maxScore = level->getScoreThreshold(gc.getScoreThreshold());
 }
 
 void GameStateController::update(float timestep) {
     for (uint i = 0, j = _state.queues.size(); i < j; i++) {
         // For each queue, update the timer of the active canvas only.
-        int ind = _getActiveIndexOfQueue(i);
         // Do not update any timer if no active canvas exists.
         // This means The queue is empty.
+        int ind = _state.active[i];
         if (ind < 0) continue;
-        _state.canvasTimers[i][ind]->update(timestep);
-        
-        if (ind > 0) {
-            CanvasState cs = this->getCanvasState(i, ind - 1);
-            if (!_state.recorded[i][ind - 1] &&
-                (cs == LOST_DUE_TO_TIME || cs == LOST_DUE_TO_WRONG_ACTION || cs == DONE)) {
-                _state.recorded[i][ind - 1] = true;
-                //Health potions never count towards or against point total
-                if (_state.obstacles[i][ind - 1] != 2) {
-                    if (cs == LOST_DUE_TO_TIME) {
-                        _state.scoreTracker["timedOut"]++;
-                        _state.scoreTracker["aggregateScore"] -= 5;
-                    }
-                    else if (cs == LOST_DUE_TO_WRONG_ACTION) {
-                        _state.scoreTracker["wrongAction"]++;
-                        _state.scoreTracker["aggregateScore"] -= 10;
-                    }
-                    else {
-                        _state.scoreTracker["correct"]++;
-                    }
-                }
-                else {
-                    if (cs == DONE) {
-                        _state.healthBack += 1; 
-                    }
-                }
-                _state.scoreTracker["aggregateScore"] = max(0, (int) _state.scoreTracker["aggregateScore"]);
-                if (_state.obstacles[i][ind - 1] == 1&& 
-                    (cs == LOST_DUE_TO_TIME || cs == LOST_DUE_TO_WRONG_ACTION)) {
-                    for (int x = 0; x < _state.queues.size(); x++) {
-                        int ind2 = _getActiveIndexOfQueue(x);
-
-                        if (x != i && ind2 >= 0) {
-                            _state.wrongActions[x][ind2] = true;
-                        }
-                    }
-                    
-                }
+        _progress(i, ind).timer->update(timestep);
+        _advance(i);
+    }
+}
+
+void GameStateController::subscribe(
+    const function<void(const GameEvent &)> &listener) {
+    _listeners.push_back(listener);
+}
+
+void GameStateController::dispatchEvents() {
+    GameEvent event;
+    while (_events.pop(event)) {
+        for (auto &listener : _listeners) listener(event);
+    }
+}
+
+void GameStateController::_emit(GameEvent::Type type, uint q, uint c,
+                                uint color) {
+    if (!_events.push({type, q, c, color})) {
+        CULogError("Game event buffer is full. The oldest event is dropped.");
+    }
+}
+
+void GameStateController::_advance(uint q) {
+    int ind = _state.active[q];
+    while (ind >= 0) {
+        CanvasState cs = getCanvasState(q, ind);
+        if (cs == ACTIVE) return;
+        _finish(q, ind, cs);
+        ind = ind + 1 < (int) numCanvases(q) ? ind + 1 : -1;
+        _state.active[q] = ind;
+        _slide(q);
+        if (ind >= 0) _emit(GameEvent::CANVAS_ACTIVATED, q, ind);
+    }
+}
+
+void GameStateController::_finish(uint q, uint c, CanvasState cs) {
+    //Health potions never count towards or against point total
+    if (!_context->isHealthPotion(q, c)) {
+        if (cs == LOST_DUE_TO_TIME) {
+            _state.scoreTracker["timedOut"]++;
+            _state.scoreTracker["aggregateScore"] -= 5;
+        }
+        else if (cs == LOST_DUE_TO_WRONG_ACTION) {
+            _state.scoreTracker["wrongAction"]++;
+            _state.scoreTracker["aggregateScore"] -= 10;
+        }
+        else {
+            _state.scoreTracker["correct"]++;
+        }
+    }
+    else {
+        if (cs == DONE) {
+            _state.healthBack += 1;
+        }
+    }
+    _state.scoreTracker["aggregateScore"] = max(0, (int) _state.scoreTracker["aggregateScore"]);
+    if (cs == LOST_DUE_TO_TIME) _state.levelMultiplier = 1;
+
+    if (cs == DONE) {
+        _emit(_context->isHealthPotion(q, c) ? GameEvent::POTION_USED :
+              GameEvent::CANVAS_DONE, q, c);
+    } else if (_context->isObstacle(q, c)) {
+        // The active canvases of the other queues go down with it. They are
+        // scored when their queue is next advanced.
+        for (uint x = 0; x < _state.queues.size(); x++) {
+            int ind2 = _state.active[x];
+            if (x != q && ind2 >= 0) {
+                _progress(x, ind2).wrongAction = true;
             }
         }
+        _emit(GameEvent::BOMB_EXPLODED, q, c);
+    } else {
+        _emit(GameEvent::CANVAS_LOST, q, c);
     }
 }
 
 CanvasState GameStateController::getCanvasState(uint q, uint c) const {
     // The state of a canvas is derived from its timer, remaining colors, and
-    // the state of the canvas in front of it.
+    // where the front of its queue is.
+
+    // Canvases behind the window have not come up yet.
+    if (c >= _state.first[q] + _state.queues[q].size()) return HIDDEN;
 
-    if (_state.wrongActions[q][c]) return LOST_DUE_TO_WRONG_ACTION;
+    const CanvasProgress &canvas = _progress(q, c);
+    if (canvas.wrongAction) return LOST_DUE_TO_WRONG_ACTION;
 
         // If the timer is done, then the canvas is lost.
-    else if (_state.canvasTimers[q][c]->finished() || (_state.obstacles[q][c] == 1 &&
-        _state.canvasTimers[q][c]->timeLeft() < 2.0)) return LOST_DUE_TO_TIME;
+    else if (canvas.timer->finished() || (_context->isObstacle(q, c) &&
+        canvas.timer->timeLeft() < 2.0)) return LOST_DUE_TO_TIME;
 
         // If no color is left, then it is completed.
-    else if (getColorsOfCanvas(q, c).empty()) return DONE;
-
-        // If it is neither done nor lost but it is the first one, it must be
-        // active.
-    else if (c == 0) return ACTIVE;
-
-    // Now we need the state of the one in front of it.
-    auto previous = getCanvasState(q, c - 1);
-
-    // If the previous one is active, then this one is on standby.
-    if (previous == ACTIVE) return STANDBY;
-
-        // If the previous one is done or lost, then this one is the frontmost.
-        // In other words, it must be active.
-    else if (previous == DONE || previous == LOST_DUE_TO_TIME ||
-             previous == LOST_DUE_TO_WRONG_ACTION)
-        return ACTIVE;
+    else if (canvas.colors.empty()) return DONE;
 
-        // In all other scenarios, the canvas is hidden.
+    // Canvases in front of the active one are all done or lost, so this is
+    // the active one, the one behind it, or further back.
+    int active = _state.active[q];
+    if ((int) c == active) return ACTIVE;
+    else if ((int) c == active + 1) return STANDBY;
     else return HIDDEN;
 }
 
 vec<uint> GameStateController::getColorsOfCanvas(uint q, uint c) const {
-    return _state.queues[q][c];
+    return _progress(q, c).colors;
 }
 
-vec<Color4> GameStateController::getColors() const {
-    return _state.colors;
-}
-
-int GameStateController::_getActiveIndexOfQueue(uint q) const {
-    for (uint i = 0, j = numCanvases(q); i < j; i++) {
-        if (getCanvasState(q, i) == ACTIVE) return i;
-    }
-    return -1;
+const vec<Color4> &GameStateController::getColors() const {
+    return _context->getColors();
 }
 
 ptr<Timer> GameStateController::getTimer(uint q, uint c) const {
-    return _state.canvasTimers[q][c];
+    return _progress(q, c).timer;
 }
 
 bool GameStateController::getIsObstacle(uint q, uint c) const {
-    return _state.obstacles[q][c] == 1;
+    return _context->isObstacle(q, c);
 }
 bool GameStateController::getIsHealthPotion(uint q, uint c) const {
-    return _state.obstacles[q][c] == 2;
+    return _context->isHealthPotion(q, c);
 }
 float GameStateController::getHealthBack() const {
     return _state.healthBack; 
 }
 
 GameStateController::ClearResult GameStateController::clearColor(uint q, uint c, uint colorInd) {
-    vec<uint> &colors = _state.queues[q][c];
+    CanvasProgress &canvas = _progress(q, c);
+    vec<uint> &colors = canvas.colors;
     auto it = begin(colors);
     while (it != end(colors)) {
         if (*it == colorInd) {
             bool rc = colors.size() == 1;
             colors.erase(it);
+            _emit(GameEvent::COLOR_CLEARED, q, c, colorInd);
             return rc ? ALL_CLEAR : CLEAR;
         } else ++it;
     }
-    _state.wrongActions[q][c] = true;
+    canvas.wrongAction = true;
+    _emit(GameEvent::WRONG_COLOR, q, c, colorInd);
     return NO_MATCH;
 }
 void GameStateController::clearHealthPotion(uint q, uint c) {
-    vec<uint>& colors = _state.queues[q][c];
-    colors.clear(); 
+    _progress(q, c).colors.clear();
     return; 
 }
 uint GameStateController::numCanvases(uint q) const {
-    return _state.queues[q].size();
+    return _context->numCanvases(q);
 }
 
 uint GameStateController::numQueues() const {
@@ -272,11 +259,8 @@ GameState GameStateController::getState() const {
     return _state;
 }
 
-string GameStateController::getShapeForColorIndex(uint i) const {
-    CUAssertLog(_state.colorShapeMapping.find(i) != _state.colorShapeMapping.end(),
-                "Could not find the shape for this index.");
-    
-    return _state.colorShapeMapping.find(i)->second;
+const string &GameStateController::getShapeForColorIndex(uint i) const {
+    return _context->getShapeForColorIndex(i);
 }
 
 uint GameStateController::getScoreMetric(string type) const {
@@ -305,12 +289,3 @@ float GameStateController::getMaxScore() {
 vec<string> GameStateController::getTutorialTextures() {
     return _state.tutorialTexture;
 }
-void GameStateController::addSplat(uint q, uint c) {
-    _state.splats[q][c] = _state.splats[q][c] + 1;
-}
-int GameStateController::getNumSplats(uint q, uint c) {
-    return _state.splats[q][c];
-}
-void GameStateController::removeSplats(uint q, uint c) {
-    _state.splats[q][c] = 0; 
-}
\ No newline at end of file
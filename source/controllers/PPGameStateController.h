@@ -3,11 +3,20 @@
 
 #include "utils/PPHeader.h"
 #include "utils/PPTimer.h"
+#include "utils/PPRingBuffer.h"
 #include "models/PPGameState.h"
+#include "models/PPLevel.h"
+#include "models/PPLevelContext.h"
 #include "PPGlobalConfigController.h"
 #include "PPSaveController.h"
 #include "PPSoundController.h"
 
+/** The most events that can wait to be dispatched. */
+#define EVENT_CAPACITY 64
+
+/** The most canvases that are done or lost each queue keeps in its window. */
+#define CANVAS_HISTORY 4
+
 /**
  * GameStateController initializes and modifies game state.
  * @author Dragonglass Studios
@@ -16,26 +25,57 @@ class GameStateController {
 private:
 
     GameState _state;
+
+    /** The read-only part of the level, shared with the views. */
+    ptr<LevelContext> _context;
     
     unordered_map<string, uint> _scoreTracker;
-    
-    /** Get the index of the active canvas in a queue. */
-    int _getActiveIndexOfQueue(uint q) const;
 
-    /** Load colors in a v1 level file. */
-    void _jsonv1_loadColors(const json_t &colors);
+    /** The time every canvas of this level gets. */
+    float _canvasBaseTime;
 
-    /** Load queues in a v1 level file. */
-    void _jsonv1_loadQueues(const json_t &queues);
+    /** The extra time a canvas of this level gets for each color. */
+    float _canvasPerColorTime;
 
-    /** Load timers in a v1 level file. */
-    void _jsonv1_loadTimer(const json_t &timer);
-    
-    /** Load tutorial textures. */
-    void _jsonv1_loadTutorialTextureArray(const json_t &tutorialTextures);
+    /** Events not dispatched yet. */
+    RingBuffer<GameEvent, EVENT_CAPACITY> _events;
+
+    /** Called with every event by dispatchEvents(). */
+    vec<function<void(const GameEvent &)>> _listeners;
+
+    /** Add an event to be dispatched. */
+    void _emit(GameEvent::Type type, uint q, uint c, uint color = 0);
+
+    /**
+     * Move a queue past its active canvas if it is done or lost, scoring it
+     * and activating the one behind it.
+     */
+    void _advance(uint q);
+
+    /** Score a canvas that is done or lost and emit what happened. */
+    void _finish(uint q, uint c, CanvasState state);
+
+    /** Reset the scores for a new level. */
+    void _loadScores();
 
-    /** Load a v1 level file. */
-    void _jsonv1_load(const json_t &json);
+    /** Load queues of a level. */
+    void _loadQueues(const Level &level);
+
+    /** Load the canvas times of a level. */
+    void _loadTimer(const Level &level);
+
+    /**
+     * Move the window of a queue along with its active canvas. Canvases that
+     * came up are read from the level and get their timer here, and the ones
+     * more than CANVAS_HISTORY behind are dropped.
+     */
+    void _slide(uint q);
+
+    /** Get the mutable part of a canvas in the window of its queue. */
+    CanvasProgress &_progress(uint q, uint c);
+
+    /** Get the mutable part of a canvas in the window of its queue. */
+    const CanvasProgress &_progress(uint q, uint c) const;
 
 public:
     enum ClearResult {
@@ -45,14 +85,26 @@ public:
     };
 
     /**
-     * Load a level file. This resets the game state.
-     * @param json The JSON object of the level file.
+     * Load a level. This resets the game state.
+     * @param level The level asset.
      */
-    void loadJson(const json_t &json);
+    void loadLevel(const ptr<Level> &level);
 
-    /** Update the state (all the timers). */
+    /**
+     * Update the state (all the timers). Canvases that are done or lost are
+     * scored here and the next canvas of their queue is activated.
+     */
     void update(float timestep);
 
+    /**
+     * Call a function with every event from now on. Listeners are removed
+     * when another level is loaded.
+     */
+    void subscribe(const function<void(const GameEvent &)> &listener);
+
+    /** Send the events since the last call to every listener, in order. */
+    void dispatchEvents();
+
     /** Get the number of queues. */
     uint numQueues() const;
 
@@ -60,15 +112,26 @@ public:
     uint numCanvases(uint q) const;
 
     /**
-     * Get the current state of a canvas.
+     * Get the index of the first canvas of a queue that still has a state.
+     * Canvases in front of it are done or lost, and were reported so.
+     */
+    uint firstCanvas(uint q) const { return _state.first[q]; }
+
+    /**
+     * Get the current state of a canvas. It must not be in front of
+     * firstCanvas(). Canvases behind the standby one are hidden.
      * @param q The queue index.
      * @param c The canvas index.
      * @see CanvasState
      */
     CanvasState getCanvasState(uint q, uint c) const;
 
+    /** Get the index of the active canvas of a queue, or -1 if none. */
+    int getActiveCanvas(uint q) const { return _state.active[q]; }
+
     /**
-     * Get the remaining colors of a canvas.
+     * Get the remaining colors of a canvas. It must be in the window of its
+     * queue, from firstCanvas() up to the standby one.
      * @param q The queue index.
      * @param c The canvas index.
      * @see CanvasState
@@ -76,9 +139,15 @@ public:
     vec<uint> getColorsOfCanvas(uint q, uint c) const;
 
     /** Get the colors of this level. */
-    vec<Color4> getColors() const;
+    const vec<Color4> &getColors() const;
 
-    /** Get the timer of a canvas. */
+    /** Get the read-only part of the level, to share with views. */
+    const ptr<LevelContext> &getContext() const { return _context; }
+
+    /** Get the number of canvases in the whole level. */
+    uint numCanvasesInLevel() const { return _state.nCanvasInLevel; }
+
+    /** Get the timer of a canvas. It must be in the window of its queue. */
     ptr<Timer> getTimer(uint q, uint c) const;
 
     /** Get if the shape is an obstacle or not*/
@@ -96,7 +165,7 @@ public:
     GameState getState() const;
     
     /** Get the shape string for a given color index. For coloblindness mode. */
-    string getShapeForColorIndex(uint i) const;
+    const string &getShapeForColorIndex(uint i) const;
     
     /** Get the number of canvases that fulfill one of the score metrics. */
     uint getScoreMetric(string type) const;
@@ -110,10 +179,6 @@ public:
 
     float getMaxScore();
 
-    void addSplat(uint q, uint c);
-    int getNumSplats(uint q, uint c);
-    void removeSplats(uint q, uint c);
-    
     /** Get the string list of all the textures for the tutorial for this level, if any. */
     vec<string> getTutorialTextures();
 };
@@ -8,47 +8,39 @@ float InputController::_moveThreshold;
 float InputController::_holdThreshold;
 float InputController::_consecutiveTapThreshold;
 
-InputController::InputInstance::InputInstance(float timeSinceLastInstance) {
+/**
+ * Seconds between two timestamps. Event times come from SDL's millisecond
+ * clock, so they may run slightly ahead of the frame clock; clamp at zero.
+ */
+static float secondsBetween(const Timestamp &start, const Timestamp &end) {
+    auto micros = (Sint64) Timestamp::ellapsedMicros(start, end);
+    return micros > 0 ? micros / 1000000.0f : 0;
+}
+
+InputController::InputInstance::InputInstance(const InputEvent &event,
+                                              float timeSinceLastInstance) {
     totalMovement = 0;
     currentlyDown = true;
     this->timeSinceLastInstance = timeSinceLastInstance;
     holdTime = 0;
-#ifdef CU_TOUCH_SCREEN
-    auto *touchscreen = Input::get<Touchscreen>();
-    auto touches = touchscreen->touchSet();
-    touchId = touches[0];
-    startingPoint = lastPoint = touchscreen->touchPosition(touchId);
-#else
-    auto *mouse = Input::get<Mouse>();
-    touchId = -1;
-    startingPoint = lastPoint = mouse->pointerPosition();
-#endif
+    touchId = event.touchId;
+    startTime = event.stamp;
+    startingPoint = lastPoint = event.point;
+    path.push_back(event.point);
 }
 
-bool InputController::InputInstance::update(float timestep) {
-#ifdef CU_TOUCH_SCREEN
-    auto *touchscreen = Input::get<Touchscreen>();
-    auto touches = touchscreen->touchSet();
-    bool hasInput =
-        find(touches.begin(), touches.end(), touchId) != touches.end();
-#else
-    auto *mouse = Input::get<Mouse>();
-    bool hasInput = mouse->buttonDown().hasLeft();
-#endif
-    if (!hasInput) {
-        currentlyDown = false;
-        return false;
-    } else if (!currentlyDown) return true;
-    Vec2 oldLastPoint = lastPoint;
-    lastPoint =
-#ifdef CU_TOUCH_SCREEN
-        touchscreen->touchPosition(touchId);
-#else
-        mouse->pointerPosition();
-#endif
-    holdTime += timestep;
-    totalMovement += (lastPoint - oldLastPoint).length();
-    return true;
+void InputController::InputInstance::moveTo(Vec2 point,
+                                            const Timestamp &stamp) {
+    if (!currentlyDown) return;
+    totalMovement += (point - lastPoint).length();
+    lastPoint = point;
+    path.push_back(point);
+    holdUntil(stamp);
+}
+
+void InputController::InputInstance::holdUntil(const Timestamp &stamp) {
+    if (!currentlyDown) return;
+    holdTime = max(holdTime, secondsBetween(startTime, stamp));
 }
 
 Vec2 InputController::InputInstance::_inputToScreen(Vec2 pt) {
@@ -62,6 +54,8 @@ void InputController::init() {
     Input::activate<Mouse>();
     Input::get<Mouse>()->setPointerAwareness(Mouse::PointerAwareness::DRAG);
 #endif
+    _lastRelease.mark();
+    _lastEvent.mark();
 }
 
 void InputController::loadConfig() {
@@ -79,38 +73,132 @@ void InputController::dispose() {
 #endif
 }
 
-void InputController::update(float timestep) {
+void InputController::_collectEvents() {
+    _events.clear();
 #ifdef CU_TOUCH_SCREEN
     auto *touchscreen = Input::get<Touchscreen>();
-    bool hasInput = touchscreen->touchCount() > 0;
+    for (auto &record : touchscreen->eventHistory()) {
+        InputEvent::Type type =
+            record.type == TouchRecord::Type::BEGIN ? InputEvent::Type::BEGIN :
+            record.type == TouchRecord::Type::END ? InputEvent::Type::END :
+            InputEvent::Type::MOTION;
+        _events.emplace_back(type, record.event.touch, record.event.position,
+                             record.event.timestamp);
+    }
 #else
     auto *mouse = Input::get<Mouse>();
-    bool hasInput = mouse->buttonDown().hasLeft();
+    for (auto &record : mouse->eventHistory()) {
+        if (!record.event.buttons.hasLeft()) continue;
+        InputEvent::Type type =
+            record.type == MouseRecord::Type::PRESS ? InputEvent::Type::BEGIN :
+            record.type == MouseRecord::Type::RELEASE ? InputEvent::Type::END :
+            InputEvent::Type::MOTION;
+        _events.emplace_back(type, -1, record.event.position,
+                             record.event.timestamp);
+    }
 #endif
-    if (_currentInput == nullptr) {
-        if (hasInput) {
+}
+
+vec<ptr<InputController::InputInstance>>::iterator
+InputController::_findContact(TouchID touchId) {
+    return find_if(_contacts.begin(), _contacts.end(),
+                   [=](const ptr<InputInstance> &input) {
+                       return input->touchId == touchId;
+                   });
+}
+
+InputController::Pointer
+InputController::_makePointer(const InputInstance &input, bool released) {
+    return {input.touchId, input.getStartingPoint(), input.getLastPoint(),
+            input.currentlyDown && !released, released, input.hasMoved(),
+            input.isJustTap()};
+}
+
+void InputController::_processEvent(const InputEvent &event) {
+    _lastEvent = event.stamp;
+    if (event.type == InputEvent::Type::BEGIN) {
+        if (_findContact(event.touchId) != _contacts.end()) return;
+        auto input = make_shared<InputInstance>(
+            event, secondsBetween(_lastRelease, event.stamp));
+        _contacts.push_back(input);
+        // The first touch down becomes the primary input.
+        if (_currentInput == nullptr) {
             if (_inputs.size() > MAX_INPUT_INSTANCES_SAVED)
                 _inputs.pop_back();
-            _currentInput = make_shared<InputInstance>(_timeWithoutInput);
+            _currentInput = input;
             _inputs.push_front(_currentInput);
-            _timeWithoutInput = 0;
-        } else {
-            _timeWithoutInput += timestep;
         }
-    } else {
-        if (!_currentInput->currentlyDown)
-            _timeWithoutInput += timestep;
-        if (!_currentInput->update(timestep))
+        return;
+    }
+    auto it = _findContact(event.touchId);
+    if (it == _contacts.end()) return;
+    auto input = *it;
+    input->moveTo(event.point, event.stamp);
+    if (event.type == InputEvent::Type::END) {
+        if (input->currentlyDown) {
+            _released.push_back(input);
+            if (input == _currentInput) {
+                _lastRelease = event.stamp;
+                _justReleased = true;
+            }
+        }
+        input->currentlyDown = false;
+        _contacts.erase(it);
+        if (input == _currentInput)
             _currentInput = nullptr;
     }
 }
 
+void InputController::update(float timestep) {
+    _justReleased = false;
+    _released.clear();
+    _collectEvents();
+    for (auto &event : _events)
+        _processEvent(event);
+
+    // Recover from events lost to focus changes or device activation.
+#ifdef CU_TOUCH_SCREEN
+    auto *touchscreen = Input::get<Touchscreen>();
+    for (size_t i = _contacts.size(); i-- > 0;) {
+        auto &input = _contacts[i];
+        if (!touchscreen->touchDown(input->touchId))
+            _processEvent(InputEvent(InputEvent::Type::END, input->touchId,
+                                     input->lastPoint, Timestamp()));
+    }
+    if (_contacts.size() < touchscreen->touchCount()) {
+        for (TouchID touch : touchscreen->touchSet())
+            _processEvent(InputEvent(InputEvent::Type::BEGIN, touch,
+                                     touchscreen->touchPosition(touch),
+                                     Timestamp()));
+    }
+#else
+    auto *mouse = Input::get<Mouse>();
+    bool hasInput = mouse->buttonDown().hasLeft();
+    if (_currentInput != nullptr && !hasInput) {
+        _processEvent(InputEvent(InputEvent::Type::END, -1,
+                                 _currentInput->lastPoint, Timestamp()));
+    } else if (_currentInput == nullptr && hasInput) {
+        _processEvent(InputEvent(InputEvent::Type::BEGIN, -1,
+                                 mouse->pointerPosition(), Timestamp()));
+    }
+#endif
+
+    Timestamp now;
+    _pointers.clear();
+    for (auto &input : _contacts) {
+        input->holdUntil(now);
+        _pointers.push_back(_makePointer(*input, false));
+    }
+    for (auto &input : _released)
+        _pointers.push_back(_makePointer(*input, true));
+}
+
 bool InputController::isPressing() const {
     return _currentInput != nullptr && _currentInput->currentlyDown;
 }
 
 bool InputController::justReleased() const {
-    return !isPressing() && _timeWithoutInput == 0;
+    return !isPressing() && _justReleased;
 }
 
 Vec2 InputController::startingPoint() const {
@@ -121,6 +209,15 @@ bool InputController::hasMoved() const {
     return !_inputs.empty() && _inputs.front()->hasMoved();
 }
 
+vec<Vec2> InputController::currentPath() const {
+    vec<Vec2> result;
+    if (_inputs.empty()) return result;
+    result.reserve(_inputs.front()->path.size());
+    for (auto &pt : _inputs.front()->path)
+        result.push_back(InputInstance::_inputToScreen(pt));
+    return result;
+}
+
 Vec2 InputController::currentPoint() const {
     return !_inputs.empty() ? _inputs.front()->getLastPoint() : Vec2(0, 0);
 }
@@ -143,8 +240,10 @@ bool InputController::inScene(const Vec2 &point,
 }
 
 void InputController::ignoreThisTouch() {
-    if (_currentInput != nullptr)
+    if (_currentInput != nullptr && _currentInput->currentlyDown) {
         _currentInput->ignore();
+        _lastRelease.mark();
+    }
 }
 
 bool InputController::isJustTap() const {
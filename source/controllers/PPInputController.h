@@ -5,11 +5,41 @@
 #include "PPGlobalConfigController.h"
 
 /**
- * InputController deals with raw input of either mouse of touch. It supports
- * only one touch at a time.
+ * InputController deals with raw input of either mouse of touch. The first
+ * touch is the primary input, which drives taps and the single-touch queries.
+ * Every concurrent touch is also reported as a pointer for multi-touch
+ * gestures. Input is read from the device event history, so taps and swipes
+ * are timed by their events rather than by the frame.
  * @author Dragonglass Studios
  */
 class InputController {
+public:
+    /**
+     * Frame snapshot of a single contact (one finger, or the mouse).
+     */
+    struct Pointer {
+        /** Touch ID for touch screen. */
+        TouchID touchId;
+
+        /** Starting point in screen coordinates. */
+        Vec2 startingPoint;
+
+        /** Current point in screen coordinates. */
+        Vec2 currentPoint;
+
+        /** Whether this contact is down and not ignored. */
+        bool pressing;
+
+        /** Whether this contact was released this frame. */
+        bool released;
+
+        /** Whether this contact has moved (farther than move threshold). */
+        bool moved;
+
+        /** Whether this contact is just a tap. */
+        bool tap;
+    };
+
 private:
     /** Move threshold. */
     static float _moveThreshold;
@@ -20,6 +50,29 @@ private:
     /** Max between consecutive touches for double-, triple-tap, etc. */
     static float _consecutiveTapThreshold;
 
+    /**
+     * A single raw input event, taken from the device event history.
+     */
+    struct InputEvent {
+        enum class Type { BEGIN, MOTION, END };
+
+        /** Type of this event. */
+        Type type;
+
+        /** Touch ID for touch screen. */
+        TouchID touchId;
+
+        /** Point of this event in input coordinate not screen. */
+        Vec2 point;
+
+        /** Time this event was received by the device. */
+        Timestamp stamp;
+
+        InputEvent(Type type, TouchID touchId, Vec2 point,
+                   const Timestamp &stamp) :
+            type(type), touchId(touchId), point(point), stamp(stamp) {}
+    };
+
     /**
      * Record of a single touch/click.
      */
@@ -33,6 +86,9 @@ private:
         /** Last point of this input in input coordinate not screen. */
         Vec2 lastPoint;
 
+        /** Every point of this input in input coordinate not screen. */
+        vec<Vec2> path;
+
         /** Total movement of this input instance. */
         float totalMovement;
 
@@ -45,11 +101,14 @@ private:
         /** Time since last input instance. */
         float timeSinceLastInstance;
 
+        /** Time this input started. */
+        Timestamp startTime;
+
         /** Convert an input coordinate to screen. */
         static Vec2 _inputToScreen(Vec2 pt);
 
         /** Constructor. */
-        explicit InputInstance(float timeSinceLastInstance);
+        InputInstance(const InputEvent &event, float timeSinceLastInstance);
 
         /** Starting point in screen coordinates. */
         Vec2 getStartingPoint() const { return _inputToScreen(startingPoint); }
@@ -65,11 +124,11 @@ private:
         /** Whether this input has moved (farther than move threshold). */
         bool hasMoved() const { return totalMovement >= _moveThreshold; }
 
-        /**
-         * Update.
-         * @return False if **physical input** is no longer active.
-         */
-        bool update(float timestep);
+        /** Move this input to the given point at the given time. */
+        void moveTo(Vec2 point, const Timestamp &stamp);
+
+        /** Extend the hold time of this input to the given time. */
+        void holdUntil(const Timestamp &stamp);
 
         /** Ignore this input. */
         void ignore() { currentlyDown = false; }
@@ -85,16 +144,44 @@ private:
      */
     ptr<InputInstance> _currentInput;
 
-    /**
-     * Counter for time since last input release.
-     */
-    float _timeWithoutInput;
+    /** Every contact currently down, including the current input. */
+    vec<ptr<InputInstance>> _contacts;
+
+    /** Contacts (not ignored) released this frame. */
+    vec<ptr<InputInstance>> _released;
+
+    /** Snapshot of all contacts for this frame. */
+    vec<Pointer> _pointers;
+
+    /** Raw events of this frame. Kept as a member to reuse its storage. */
+    vec<InputEvent> _events;
+
+    /** Time of the last input release (or ignore). */
+    Timestamp _lastRelease;
+
+    /** Time of the newest input event seen. */
+    Timestamp _lastEvent;
+
+    /** Whether an input (not ignored) was released this frame. */
+    bool _justReleased;
 
     static InputController _instance;
 
     InputController() :
         _currentInput(nullptr),
-        _timeWithoutInput(0) {}
+        _justReleased(false) {}
+
+    /** Collect the raw events of this frame from the device history. */
+    void _collectEvents();
+
+    /** Apply a single raw event. */
+    void _processEvent(const InputEvent &event);
+
+    /** Find the contact with the given touch ID. */
+    vec<ptr<InputInstance>>::iterator _findContact(TouchID touchId);
+
+    /** Snapshot a contact for this frame. */
+    static Pointer _makePointer(const InputInstance &input, bool released);
 
 public:
     /** Initialize. */
@@ -138,6 +225,24 @@ public:
 
     void clearPreviousTaps();
 
+    /**
+     * The full path of the ongoing touch or last touch in screen
+     * coordinates, including every motion event between frames.
+     */
+    vec<Vec2> currentPath() const;
+
+    /**
+     * Time of the newest input event. Compare against the time a frame is
+     * presented to measure input-to-photon latency.
+     */
+    const Timestamp &lastEventTime() const { return _lastEvent; }
+
+    /**
+     * All contacts that are down, in the order they were pressed, followed
+     * by the contacts released this frame. Built once per update.
+     */
+    const vec<Pointer> &pointers() const { return _pointers; }
+
     /** Utility function to check if a point is in a scene node. */
     static bool inScene(const Vec2 &point, const ptr<SceneNode> &scene);
 
@@ -1,6 +1,41 @@
 #include "PPSaveController.h"
+#if defined(__WINDOWS__)
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
-#define SAVE_PATH (Application::get()->getSaveDirectory() + "save")
+/** Extension of the new save while it is being written. */
+#define TEMP_EXT ".tmp"
+/** Extension of the previous save while the new one replaces it. */
+#define BACKUP_EXT ".bak"
+
+/** Write data to a file and make sure it reaches the disk. */
+static bool writeDurably(const string &path, const string &data) {
+    FILE *file = fopen(path.c_str(), "wb");
+    if (file == nullptr) return false;
+    bool ok = fwrite(data.data(), 1, data.size(), file) == data.size();
+    ok = fflush(file) == 0 && ok;
+#if defined(__WINDOWS__)
+    ok = ok && _commit(_fileno(file)) == 0;
+#else
+    ok = ok && fsync(fileno(file)) == 0;
+#endif
+    return fclose(file) == 0 && ok;
+}
+
+/** Make the renames in a directory durable. Windows does this itself. */
+static void syncDirectory(const string &path) {
+#if !defined(__WINDOWS__)
+    size_t slash = path.find_last_of('/');
+    string dir = slash == string::npos ? "." : path.substr(0, slash + 1);
+    int fd = open(dir.c_str(), O_RDONLY);
+    if (fd < 0) return;
+    fsync(fd);
+    close(fd);
+#endif
+}
 
 SaveController::LevelMetadata SaveController::_getLevel(
     const string &level) const {
@@ -15,9 +50,17 @@ SaveController::LevelMetadata &SaveController::_ensureLevel(
 }
 
 void SaveController::_load() {
-    auto r = JsonReader::alloc(SAVE_PATH);
-    if (r == nullptr) return;
+    // A crash while replacing the save leaves it in one of the others.
+    if (_read(_path)) return;
+    if (_read(_path + TEMP_EXT)) return;
+    _read(_path + BACKUP_EXT);
+}
+
+bool SaveController::_read(const string &path) {
+    auto r = JsonReader::alloc(path);
+    if (r == nullptr || !r->ready()) return false;
     json_t v = r->readJson();
+    if (v == nullptr) return false;
     if (v->getInt("version", 2) == 2) {
         _colorblind = v->getBool("colorblind", false);
         _paletteLeft = v->getBool("paletteLeft", true);
@@ -38,19 +81,52 @@ void SaveController::_load() {
             }
         }
     }
+    return true;
+}
+
+void SaveController::_markDirty() {
+    if (_dirty) return;
+    _dirty = true;
+    _callback = Application::get()->schedule([this]() {
+        _post();
+        return false;
+    }, SAVE_DELAY);
+}
+
+void SaveController::_post() {
+    _dirty = false;
+    auto snapshot = make_unique<Snapshot>(Snapshot{
+        _levels, _colorblind, _paletteLeft, _bgm, _sfx, _vfx,
+        _sfxVolume, _bgmVolume
+    });
+    unique_lock<mutex> lock(_mutex);
+    // A snapshot still pending has a write coming for it, which will take
+    // this one instead.
+    bool queued = _pending != nullptr;
+    _pending = move(snapshot);
+    if (!queued) {
+        _writes++;
+        _writer->addTask([this]() { _write(); });
+    }
 }
 
-void SaveController::_flush() {
+void SaveController::_write() {
+    unique_ptr<Snapshot> s;
+    {
+        unique_lock<mutex> lock(_mutex);
+        s = move(_pending);
+    }
+
     json_t v = JsonValue::alloc(JsonValue::Type::ObjectType);
-    v->appendValue("colorblind", _colorblind);
-    v->appendValue("paletteLeft", _paletteLeft);
-    v->appendValue("sfxVolume", _sfxVolume);
-    v->appendValue("bgmVolume", _bgmVolume);
-    v->appendValue("bgm", _bgm);
-    v->appendValue("sfx", _sfx);
-    v->appendValue("vfx", _vfx);
+    v->appendValue("colorblind", s->colorblind);
+    v->appendValue("paletteLeft", s->paletteLeft);
+    v->appendValue("sfxVolume", s->sfxVolume);
+    v->appendValue("bgmVolume", s->bgmVolume);
+    v->appendValue("bgm", s->bgm);
+    v->appendValue("sfx", s->sfx);
+    v->appendValue("vfx", s->vfx);
     json_t l = JsonValue::alloc(JsonValue::Type::ObjectType);
-    for (const auto &p : _levels) {
+    for (const auto &p : s->levels) {
         json_t lv = JsonValue::alloc(JsonValue::Type::ObjectType);
         lv->appendValue("locked", p.second.locked);
         lv->appendValue("score", (long)p.second.score);
@@ -58,11 +134,37 @@ void SaveController::_flush() {
         l->appendChild(p.first, lv);
     }
     v->appendChild("levels", l);
-    auto w = JsonWriter::alloc(SAVE_PATH);
-    w->writeJson(v, true);
-    w->flush();
-    w->close();
-    CULog("Finished flushing settings and save data.");
+    string data = v->toString(true);
+
+    // Write the new save next to the old one, then swap them. The old save
+    // stays as a backup until the new one is in place. The new save is on
+    // disk before the swap, so losing power never leaves a truncated save.
+    string temp = _path + TEMP_EXT, backup = _path + BACKUP_EXT;
+    bool ok = writeDurably(temp, data);
+    if (ok) {
+        remove(backup.c_str());
+        rename(_path.c_str(), backup.c_str());
+        ok = rename(temp.c_str(), _path.c_str()) == 0;
+        syncDirectory(_path);
+    }
+    if (ok) {
+        CULog("Finished flushing settings and save data.");
+    } else {
+        CULogError("Failed to write save data: %s", strerror(errno));
+    }
+
+    unique_lock<mutex> lock(_mutex);
+    _writes--;
+    _written.notify_all();
+}
+
+void SaveController::flush() {
+    if (_dirty) {
+        Application::get()->unschedule(_callback);
+        _post();
+    }
+    unique_lock<mutex> lock(_mutex);
+    _written.wait(lock, [this]() { return _writes == 0; });
 }
 
 bool SaveController::isLocked(const string &level) const {
@@ -70,6 +172,10 @@ bool SaveController::isLocked(const string &level) const {
     return _getLevel(level).locked;
 }
 
+bool SaveController::isCleared(const string &level) const {
+    return !_getLevel(level).locked;
+}
+
 unsigned long SaveController::getScore(const string &level) const {
     return _getLevel(level).score;
 }
@@ -114,60 +220,60 @@ bool SaveController::getVfx() const {
 
 void SaveController::unlock(const string &level) {
     _ensureLevel(level).locked = false;
-    _flush();
+    _markDirty();
 }
 
 void SaveController::lock(const string &level) {
     _ensureLevel(level).locked = true;
-    _flush();
+    _markDirty();
 }
 
 void SaveController::setScore(const string &level, unsigned long score) {
     _ensureLevel(level).score = score;
-    _flush();
+    _markDirty();
 }
 
 void SaveController::setStars(const string &level, uint stars) {
     _ensureLevel(level).stars = stars;
-    _flush();
+    _markDirty();
 }
 
 void SaveController::setSfxVolume(float value) {
     _sfxVolume = value;
-    _flush();
+    _markDirty();
 }
 
 void SaveController::setBgmVolume(float value) {
     _bgmVolume = value;
-    _flush();
+    _markDirty();
 }
 
 void SaveController::setColorblind(bool value) {
     _colorblind = value;
-    _flush();
+    _markDirty();
 }
 
 void SaveController::setPaletteLeft(bool value) {
     _paletteLeft = value;
-    _flush();
+    _markDirty();
 }
 
 void SaveController::setBgm(bool on) {
     _bgm = on;
-    _flush();
+    _markDirty();
 }
 
 void SaveController::setSfx(bool on) {
     _sfx = on;
-    _flush();
+    _markDirty();
 }
 
 void SaveController::setVfx(bool on) {
     _vfx = on;
-    _flush();
+    _markDirty();
 }
 
 void SaveController::resetAll() {
     _levels.clear();
-    _flush();
+    _markDirty();
 }
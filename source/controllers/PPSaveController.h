@@ -1,10 +1,22 @@
 #ifndef PANICPAINTER_PPSAVECONTROLLER_H
 #define PANICPAINTER_PPSAVECONTROLLER_H
 
+#include <mutex>
+#include <condition_variable>
 #include "utils/PPHeader.h"
 
+/** Milliseconds to wait for more changes before writing them. */
+#define SAVE_DELAY 500
+
 /**
  * SaveController deals with persistent data.
+ *
+ * Setters only change memory and mark the data dirty. Changes made within
+ * SAVE_DELAY of each other are written together, by a thread of its own,
+ * so the main thread never waits on the file system. A write goes to a
+ * temporary file first, and the previous save is kept as a backup until the
+ * new one is in place, so a crash at any point leaves a whole save behind.
+ *
  * @author Dragonglass Studios
  */
 class SaveController {
@@ -21,6 +33,13 @@ private:
         }
     };
 
+    /** A copy of everything saved, for the writer thread to write. */
+    struct Snapshot {
+        unordered_map<string, LevelMetadata> levels;
+        bool colorblind, paletteLeft, bgm, sfx, vfx;
+        float sfxVolume, bgmVolume;
+    };
+
     unordered_map<string, LevelMetadata> _levels;
 
     bool _colorblind;
@@ -41,16 +60,53 @@ private:
 
     float _bgmVolume;
 
+    /** The save file. Backups are next to it with a different extension. */
+    string _path;
+
+    /** Writes the save files. One thread, so writes never overlap. */
+    ptr<ThreadPool> _writer;
+
+    /** Guards _pending and _writes, which the writer thread shares. */
+    mutex _mutex;
+
+    /** Signals that a write has finished. */
+    condition_variable _written;
+
+    /** The latest snapshot not taken by the writer yet, or null. */
+    unique_ptr<Snapshot> _pending;
+
+    /** Writes handed to the writer and not finished yet. */
+    uint _writes;
+
+    /** The delayed write, if the data is dirty. */
+    Uint32 _callback;
+
+    /** Whether the data is dirty and the delayed write is scheduled. */
+    bool _dirty;
+
     static inline SaveController *_instance;
 
     SaveController() : _colorblind(false), _paletteLeft(true), _sfxVolume(1),
-    _bgmVolume(1), _bgm(true), _sfx(true), _vfx(true) {
+    _bgmVolume(1), _bgm(true), _sfx(true), _vfx(true), _writes(0),
+    _callback(0), _dirty(false) {
+        _path = Application::get()->getSaveDirectory() + "save";
+        _writer = ThreadPool::alloc(1);
         _load();
     }
 
     void _load();
 
-    void _flush();
+    /** Read one save file. Returns whether it was there and whole. */
+    bool _read(const string &path);
+
+    /** Schedule a write, unless one is scheduled already. */
+    void _markDirty();
+
+    /** Hand the current data to the writer. */
+    void _post();
+
+    /** Write the latest snapshot. Runs on the writer thread. */
+    void _write();
 
     LevelMetadata _getLevel(const string &level) const;
 
@@ -61,6 +117,9 @@ public:
 
     bool isUnlocked(const string &level) const { return !isLocked(level); }
 
+    /** Whether the level was completed, even while every level is open. */
+    bool isCleared(const string &level) const;
+
     unsigned long getScore(const string &level) const;
 
     uint getStars(const string &level) const;
@@ -107,6 +166,12 @@ public:
 
     void resetAll();
 
+    /**
+     * Write any changes now and wait until they are on disk. Call this when
+     * the app may be killed, like when it is suspended or shut down.
+     */
+    void flush();
+
     static SaveController *getInstance() {
         if (!_instance) _instance = new SaveController;
         return _instance;
@@ -72,3 +72,11 @@ void SoundController::stopSfx(const string &name) {
     if (!AudioEngine::get()->isActive(name)) return;
     AudioEngine::get()->clear(name);
 }
+
+void SoundController::onGameEvent(const GameEvent &event) {
+    if (event.type == GameEvent::CANVAS_DONE) {
+        playSfx("correct2");
+    } else if (event.type == GameEvent::WRONG_COLOR) {
+        playSfx("incorrect");
+    }
+}
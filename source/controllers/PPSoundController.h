@@ -3,6 +3,7 @@
 
 #include "utils/PPHeader.h"
 #include "PPSaveController.h"
+#include "models/PPGameState.h"
 
 class SoundController {
 private:
@@ -30,6 +31,9 @@ public:
     void playSfx(const string &name, bool loop = false);
     void stopSfx(const string &name);
 
+    /** Play the sound effect for something that happened in the game. */
+    void onGameEvent(const GameEvent &event);
+
     static SoundController *getInstance() {
         if (_instance == nullptr) _instance = new SoundController;
         return _instance;
@@ -1,6 +1,7 @@
 #ifndef PANICPAINTER_PPGAMESTATE_H
 #define PANICPAINTER_PPGAMESTATE_H
 
+#include <deque>
 #include "utils/PPHeader.h"
 #include "utils/PPTimer.h"
 
@@ -24,13 +25,66 @@ enum CanvasState {
     DONE,
 };
 
+/**
+ * Something that happened to a canvas. GameStateController emits these as
+ * they happen, so views only do work when something changes.
+ */
+struct GameEvent {
+    enum Type {
+        /** The canvas reached the front of its queue. */
+        CANVAS_ACTIVATED,
+        /** A color the canvas wanted was painted on it. */
+        COLOR_CLEARED,
+        /** A color the canvas did not want was painted on it. */
+        WRONG_COLOR,
+        /** All colors of the canvas are cleared. */
+        CANVAS_DONE,
+        /** The canvas is lost, due to time or a wrong color. */
+        CANVAS_LOST,
+        /** The health potion was swiped away. */
+        POTION_USED,
+        /** The obstacle was lost and took out the other queues. */
+        BOMB_EXPLODED,
+    };
+
+    Type type;
+
+    /** The queue index. */
+    uint queue;
+
+    /** The canvas index. */
+    uint canvas;
+
+    /** The color index, for COLOR_CLEARED and WRONG_COLOR. */
+    uint color;
+};
+
+/**
+ * The mutable part of a canvas. Only the canvases near the front of a queue
+ * have one; the rest are read from the level when they come up.
+ */
+struct CanvasProgress {
+    /**
+     * The color indexes not cleared yet. When the user clears a color, its
+     * index is removed. An empty canvas is done.
+     */
+    vec<uint> colors;
+
+    /** Whether the canvas is lost due to a wrong action. */
+    bool wrongAction;
+
+    /**
+     * The canvas timer. It is stored as a smart pointer so views can hold on
+     * to it after the canvas leaves the window.
+     */
+    ptr<Timer> timer;
+};
+
+/**
+ * The mutable state of a level being played. The parts of a level that never
+ * change while playing are in LevelContext instead.
+ */
 struct GameState {
-    /** The list of colors for this level. */
-    vec<Color4> colors;
-    
-    /** A map from the color index to the string that represents the texture that will be loaded in. Should only be used for color-blindness mode. */
-    unordered_map<uint, string> colorShapeMapping;
-    
     unordered_map<string, uint> scoreTracker;
 
     uint nCanvasInLevel;
@@ -38,48 +92,21 @@ struct GameState {
     float healthBack;
 
     /**
-     * The representation of the queue. This is a bit tricky so let me explain.
-     *
-     * The first (outermost) vector is the overall container holding the queues.
-     * The second vector is the queue vector holding the canvases.
-     * The innermost vector is per canvas holding the color indexes.
-     *
-     * Only the innermost vector should be mutated. This means that when the
-     * user clears a color, the index is removed from the innermost vector
-     * representing that canvas. However, when the canvas is empty (meaning it
-     * has 0 indexes), do not remove that vector from the second vector. Just
-     * leave the empty canvas as-is.
-     */
-    vec<vec<vec<uint>>> queues;
-
-    /*This records which canvases are obstacles vs health potions. This will be found in canvasBlock as well but this 
-    makes it easier to cause the "blow up" action to occur. The logic is as follows: 
-    0: normal
-    1: obstacle
-    2: health potion
-    3: beach ball (if implemented)*/
-    vec<vec<int>> obstacles; 
-
-    //This keeps track as to how many splats each canvas has
-    vec<vec<int>> splats;
-    /**
-     * This records which canvases are lost due to wrong actions.
+     * The window of each queue. It holds the last few canvases that are done
+     * or lost, the active canvas and the standby one, so its size does not
+     * depend on how long the queue is. Canvases join at the back when they
+     * come up and are dropped from the front.
      */
-    vec<vec<bool>> wrongActions;
-    
-    /**
-     * This records which canvases are lost due to wrong actions, are correctly finished, or are timed out.
-     */
-    vec<vec<bool>> recorded;
+    vec<deque<CanvasProgress>> queues;
+
+    /** The index of the first canvas in the window of each queue. */
+    vec<uint> first;
 
     /**
-     * The canvas timers. The outer vector is the one holding queues. The inner
-     * one is the queue vector holding timers each representing a canvas in it.
-     *
-     * This should not be mutated outside of loading phase. The timer is stored
-     * as smart pointers so the timer itself can be updated freely.
+     * The index of the active canvas of each queue, or -1 once every canvas
+     * of the queue is done or lost.
      */
-    vec<vec<ptr<Timer>>> canvasTimers;
+    vec<int> active;
 
     /** The level multiplier */
     float levelMultiplier;
@@ -0,0 +1,342 @@
+#include <cstring>
+#include "PPLevel.h"
+
+typedef JsonParser::Event Event;
+
+/** The magic number at the start of every compiled level. */
+#define LEVEL_MAGIC "PPLV"
+/** The version of compiled levels. JSON levels are version 1. */
+#define LEVEL_VERSION 2
+
+/**
+ * The header of a compiled level. It is followed by the colors (4 bytes
+ * each), the queue offsets, the canvases, and the strings: the background
+ * and then each tutorial texture, all null-terminated. Every value is
+ * little-endian.
+ */
+struct LevelHeader {
+    char magic[4];
+    Uint32 version;
+    Uint32 numColors;
+    Uint32 numQueues;
+    Uint32 numCanvases;
+    float levelTime;
+    float canvasBaseTime;
+    float canvasPerColorTime;
+    float scoreThreshold;
+    Uint32 numTutorialTextures;
+    Uint32 stringBytes;
+};
+
+static_assert(sizeof(LevelHeader) == 44, "LevelHeader must be packed.");
+static_assert(sizeof(LevelCanvas) == 8, "LevelCanvas must be packed.");
+
+bool Level::preload(const string &file) {
+    _file = file;
+    auto contents =
+        MappedFile::alloc(Application::get()->getAssetDirectory() + file);
+    if (contents == nullptr) {
+        CULogError("Could not open level %s.", file.c_str());
+        return false;
+    }
+
+    if (contents->size() >= 4 &&
+        memcmp(contents->data(), LEVEL_MAGIC, 4) == 0) {
+        if (!_readCompiled(contents)) {
+            CULogError("Invalid compiled level %s.", file.c_str());
+            return false;
+        }
+        return true;
+    }
+
+    // Anything else should be a v1 JSON level.
+    auto parser = JsonParser::alloc(
+        string((const char *) contents->data(), contents->size()));
+    if (!parse(*parser)) {
+        CULogError("Invalid level %s: %s", file.c_str(),
+                   parser->getError().c_str());
+        return false;
+    }
+    return true;
+}
+
+bool Level::parse(const string &text) {
+    auto parser = JsonParser::alloc(text);
+    return parser != nullptr && parse(*parser);
+}
+
+bool Level::_validCanvases(const LevelCanvas *canvases, uint n,
+                           size_t numColors) {
+    for (uint c = 0; c < n; c++) {
+        const LevelCanvas &canvas = canvases[c];
+        if (canvas.numColors > LEVEL_MAX_CANVAS_COLORS ||
+            (Uint8) canvas.kind > (Uint8) CanvasKind::HEALTH_POTION)
+            return false;
+        for (uint i = 0; i < canvas.numColors; i++) {
+            if (((canvas.colors >> (4 * i)) & 0xF) >= numColors) return false;
+        }
+    }
+    return true;
+}
+
+bool Level::_parseColors(JsonParser &parser) {
+    _colors.clear();
+    if (parser.next() != Event::BEGIN_ARRAY) return false;
+    while (parser.next() == Event::BEGIN_ARRAY) {
+        float rgb[3];
+        int n = 0;
+        while (parser.next() == Event::NUMBER) {
+            if (n < 3) rgb[n] = parser.getFloat();
+            n++;
+        }
+        CUAssertLog(n == 3, "A color must have three elements.");
+        if (n != 3 || parser.getEvent() != Event::END_ARRAY) return false;
+        _colors.emplace_back((Uint8) rgb[0], (Uint8) rgb[1], (Uint8) rgb[2]);
+    }
+    return parser.getEvent() == Event::END_ARRAY;
+}
+
+bool Level::_parseQueues(JsonParser &parser) {
+    _parsedCanvases.clear();
+    _parsedQueueStart.assign(1, 0);
+    if (parser.next() != Event::BEGIN_ARRAY) return false;
+    // Build each queue.
+    while (parser.next() == Event::BEGIN_ARRAY) {
+        // Build canvas of each queue.
+        while (parser.next() == Event::BEGIN_ARRAY) {
+            uint raw[LEVEL_MAX_CANVAS_COLORS + 1];
+            uint n = 0;
+            while (parser.next() == Event::NUMBER) {
+                if (n > LEVEL_MAX_CANVAS_COLORS) return false;
+                raw[n++] = (uint) parser.getInt();
+            }
+            if (parser.getEvent() != Event::END_ARRAY) return false;
+
+            // The kind of a canvas is marked by its last color index.
+            LevelCanvas canvas = {0, 0, CanvasKind::NORMAL, 0};
+            if (n > 0 && raw[n - 1] == LEVEL_OBSTACLE_MARKER) {
+                canvas.kind = CanvasKind::OBSTACLE;
+                n--;
+            } else if (n > 0 && raw[n - 1] == LEVEL_HEALTH_POTION_MARKER) {
+                canvas.kind = CanvasKind::HEALTH_POTION;
+                n--;
+            }
+            if (n > LEVEL_MAX_CANVAS_COLORS) return false;
+            for (uint i = 0; i < n; i++) {
+                if (raw[i] > 0xF) return false;
+                canvas.colors |= raw[i] << (4 * i);
+            }
+            canvas.numColors = (Uint8) n;
+            _parsedCanvases.push_back(canvas);
+        }
+        if (parser.getEvent() != Event::END_ARRAY) return false;
+        _parsedQueueStart.push_back((Uint32) _parsedCanvases.size());
+    }
+    return parser.getEvent() == Event::END_ARRAY;
+}
+
+bool Level::_parseTimer(JsonParser &parser) {
+    if (parser.next() != Event::BEGIN_OBJECT) return false;
+    while (parser.next() == Event::KEY) {
+        const string &key = parser.getString();
+        float *target =
+            key == "levelTime" ? &_levelTime :
+            key == "canvasBaseTime" ? &_canvasBaseTime :
+            key == "canvasPerColorTime" ? &_canvasPerColorTime : nullptr;
+        if (target == nullptr) {
+            parser.skip();
+        } else if (parser.next() == Event::NUMBER) {
+            *target = parser.getFloat();
+        } else {
+            return false;
+        }
+    }
+    return parser.getEvent() == Event::END_OBJECT;
+}
+
+bool Level::_parseTutorialTextures(JsonParser &parser) {
+    _tutorialTextures.clear();
+    if (parser.next() != Event::BEGIN_ARRAY) return false;
+    while (parser.next() == Event::STRING)
+        _tutorialTextures.push_back(parser.getString());
+    return parser.getEvent() == Event::END_ARRAY;
+}
+
+bool Level::parse(JsonParser &parser) {
+    int version = -1;
+    bool hasColors = false, hasQueues = false;
+    if (parser.next() != Event::BEGIN_OBJECT) return false;
+    while (parser.next() == Event::KEY) {
+        const string key = parser.getString();
+        bool ok = true;
+        if (key == "version") {
+            ok = parser.next() == Event::NUMBER;
+            version = parser.getInt();
+        } else if (key == "colors") {
+            ok = hasColors = _parseColors(parser);
+        } else if (key == "queues") {
+            ok = hasQueues = _parseQueues(parser);
+        } else if (key == "timer") {
+            ok = _parseTimer(parser);
+        } else if (key == "tutorialTextures") {
+            ok = _parseTutorialTextures(parser);
+        } else if (key == "background") {
+            ok = parser.next() == Event::STRING;
+            _background = parser.getString();
+        } else if (key == "scoreThreshold") {
+            ok = parser.next() == Event::NUMBER;
+            _scoreThreshold = parser.getFloat();
+        } else {
+            ok = parser.skip();
+        }
+        if (!ok) return false;
+    }
+    if (parser.getEvent() != Event::END_OBJECT ||
+        parser.next() != Event::END)
+        return false;
+
+    // Compiled levels are never JSON, so this must be v1.
+    CUAssertLog(version == 1, "Unknown level version %d.", version);
+    if (version != 1 || !hasColors || !hasQueues) return false;
+    if (!_validCanvases(_parsedCanvases.data(),
+                        (uint) _parsedCanvases.size(), _colors.size()))
+        return false;
+
+    _contents = nullptr;
+    _canvases = _parsedCanvases.data();
+    _queueStart = _parsedQueueStart.data();
+    _numQueues = (uint) _parsedQueueStart.size() - 1;
+    return true;
+}
+
+bool Level::_readCompiled(const ptr<MappedFile> &contents) {
+#if SDL_BYTEORDER == SDL_BIG_ENDIAN
+    // Canvases are used in place, so they must match the host byte order.
+    CULogError("Compiled levels are not supported on big-endian hosts.");
+    return false;
+#endif
+    const Uint8 *data = contents->data();
+    size_t size = contents->size();
+    LevelHeader header;
+    if (size < sizeof(LevelHeader)) return false;
+    memcpy(&header, data, sizeof(LevelHeader));
+    if (header.version != LEVEL_VERSION) return false;
+
+    // Every section is a multiple of 4 bytes long, so all stay aligned.
+    size_t colorsAt = sizeof(LevelHeader);
+    size_t queuesAt = colorsAt + (size_t) header.numColors * 4;
+    size_t canvasesAt = queuesAt + ((size_t) header.numQueues + 1) * 4;
+    size_t stringsAt =
+        canvasesAt + (size_t) header.numCanvases * sizeof(LevelCanvas);
+    if (stringsAt + header.stringBytes > size) return false;
+
+    auto queueStart = (const Uint32 *) (data + queuesAt);
+    auto canvases = (const LevelCanvas *) (data + canvasesAt);
+    if (queueStart[0] != 0 ||
+        queueStart[header.numQueues] != header.numCanvases)
+        return false;
+    for (uint q = 0; q < header.numQueues; q++) {
+        if (queueStart[q + 1] < queueStart[q]) return false;
+    }
+    if (!_validCanvases(canvases, header.numCanvases, header.numColors))
+        return false;
+
+    _colors.clear();
+    for (uint i = 0; i < header.numColors; i++) {
+        const Uint8 *rgba = data + colorsAt + i * 4;
+        _colors.emplace_back(rgba[0], rgba[1], rgba[2], rgba[3]);
+    }
+
+    const char *str = (const char *) data + stringsAt;
+    const char *end = str + header.stringBytes;
+    if (header.stringBytes == 0 || end[-1] != '\0') return false;
+    _background = str;
+    str += _background.size() + 1;
+    _tutorialTextures.clear();
+    for (uint i = 0; i < header.numTutorialTextures; i++) {
+        if (str >= end) return false;
+        _tutorialTextures.emplace_back(str);
+        str += _tutorialTextures.back().size() + 1;
+    }
+
+    _levelTime = header.levelTime;
+    _canvasBaseTime = header.canvasBaseTime;
+    _canvasPerColorTime = header.canvasPerColorTime;
+    _scoreThreshold = header.scoreThreshold;
+
+    _parsedCanvases.clear();
+    _parsedQueueStart.clear();
+    _contents = contents;
+    _canvases = canvases;
+    _queueStart = queueStart;
+    _numQueues = header.numQueues;
+    return true;
+}
+
+/** Write a float as its little-endian bits. */
+static void writeFloat(SDL_RWops *out, float value) {
+    Uint32 bits;
+    memcpy(&bits, &value, sizeof(Uint32));
+    SDL_WriteLE32(out, bits);
+}
+
+bool Level::_writeCompiled(const string &dest) const {
+    SDL_RWops *out = SDL_RWFromFile(dest.c_str(), "wb");
+    if (out == nullptr) {
+        CULogError("Could not create level %s: %s", dest.c_str(),
+                   SDL_GetError());
+        return false;
+    }
+
+    string strings = _background;
+    strings.push_back('\0');
+    for (const string &t : _tutorialTextures) {
+        strings += t;
+        strings.push_back('\0');
+    }
+
+    SDL_RWwrite(out, LEVEL_MAGIC, 1, 4);
+    SDL_WriteLE32(out, LEVEL_VERSION);
+    SDL_WriteLE32(out, (Uint32) _colors.size());
+    SDL_WriteLE32(out, _numQueues);
+    SDL_WriteLE32(out, numCanvases());
+    writeFloat(out, _levelTime);
+    writeFloat(out, _canvasBaseTime);
+    writeFloat(out, _canvasPerColorTime);
+    writeFloat(out, _scoreThreshold);
+    SDL_WriteLE32(out, (Uint32) _tutorialTextures.size());
+    SDL_WriteLE32(out, (Uint32) strings.size());
+
+    for (const Color4 &color : _colors) {
+        SDL_WriteU8(out, color.r);
+        SDL_WriteU8(out, color.g);
+        SDL_WriteU8(out, color.b);
+        SDL_WriteU8(out, color.a);
+    }
+    for (uint q = 0; q <= _numQueues; q++) {
+        SDL_WriteLE32(out, _queueStart[q]);
+    }
+    for (uint c = 0, n = numCanvases(); c < n; c++) {
+        SDL_WriteLE32(out, _canvases[c].colors);
+        SDL_WriteU8(out, _canvases[c].numColors);
+        SDL_WriteU8(out, (Uint8) _canvases[c].kind);
+        SDL_WriteLE16(out, 0);
+    }
+    SDL_RWwrite(out, strings.data(), 1, strings.size());
+    SDL_RWclose(out);
+    return true;
+}
+
+bool Level::compile(const string &source, const string &dest) {
+    auto reader = TextReader::alloc(source);
+    if (reader == nullptr) {
+        CULogError("Could not open level %s.", source.c_str());
+        return false;
+    }
+    Level level;
+    if (!level.parse(reader->readAll())) {
+        CULogError("Invalid level %s.", source.c_str());
+        return false;
+    }
+    return level._writeCompiled(dest);
+}
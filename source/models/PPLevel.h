@@ -0,0 +1,239 @@
+#ifndef PANICPAINTER_PPLEVEL_H
+#define PANICPAINTER_PPLEVEL_H
+
+#include "utils/PPHeader.h"
+
+/** In v1 level files, a last color index of 10 marks an obstacle. */
+#define LEVEL_OBSTACLE_MARKER 10
+/** In v1 level files, a last color index of 12 marks a health potion. */
+#define LEVEL_HEALTH_POTION_MARKER 12
+/** The most colors a single canvas can ask for. */
+#define LEVEL_MAX_CANVAS_COLORS 8
+
+/** What a canvas is, apart from its colors. */
+enum class CanvasKind : Uint8 {
+    /** A character asking for colors. */
+    NORMAL,
+
+    /** A bomb. Losing it loses the active canvas of every other queue. */
+    OBSTACLE,
+
+    /** A health potion, cleared by swiping up. */
+    HEALTH_POTION,
+};
+
+/**
+ * One canvas of a level. This is exactly how a canvas is stored in a
+ * compiled (v2) level file, so those are used in place without copying.
+ */
+struct LevelCanvas {
+    /** The color indexes, 4 bits each. The first color is the lowest. */
+    Uint32 colors;
+    /** The number of color indexes. */
+    Uint8 numColors;
+    /** The kind of the canvas. */
+    CanvasKind kind;
+    /** Unused, keeps the record 4-byte aligned. */
+    Uint16 reserved;
+};
+
+/**
+ * Level is the immutable description of a level file. It is an asset loaded
+ * through GenericLoader from the "levels" category of the asset directory.
+ *
+ * A level file is either v1 JSON or a compiled v2 binary made by compile().
+ * JSON is read with the streaming JsonParser, so no JsonValue tree is ever
+ * built. A compiled level is memory mapped and its canvases are used in
+ * place, so loading one allocates nothing per canvas.
+ *
+ * Either way, canvases are stored flat: all canvases of all queues in one
+ * array, indexed by per-queue offsets.
+ * @author Dragonglass Studios
+ */
+class Level : public Asset {
+private:
+    /** The file this level was loaded from. */
+    string _file;
+
+    /** The contents of a compiled level file. Null for JSON levels. */
+    ptr<MappedFile> _contents;
+
+    /** The list of colors for this level. */
+    vec<Color4> _colors;
+
+    /** The canvases of a JSON level. Empty for compiled levels. */
+    vec<LevelCanvas> _parsedCanvases;
+
+    /** The queue offsets of a JSON level. Empty for compiled levels. */
+    vec<Uint32> _parsedQueueStart;
+
+    /** The canvases of every queue, back to back. */
+    const LevelCanvas *_canvases;
+
+    /** Index of the first canvas of each queue, plus a final end index. */
+    const Uint32 *_queueStart;
+
+    /** The number of queues. */
+    uint _numQueues;
+
+    /** The background texture name. Empty if not specified. */
+    string _background;
+
+    /** The tutorial texture names. */
+    vec<string> _tutorialTextures;
+
+    /** Level-defined timer values, or negative if not specified. */
+    float _levelTime, _canvasBaseTime, _canvasPerColorTime;
+
+    /** Level-defined score threshold, or negative if not specified. */
+    float _scoreThreshold;
+
+    /**
+     * Check that every canvas has a known kind and only asks for colors
+     * of this level, so a bad file cannot index past getColors().
+     */
+    static bool _validCanvases(const LevelCanvas *canvases, uint n,
+                               size_t numColors);
+
+    /** Parse the colors array. */
+    bool _parseColors(JsonParser &parser);
+
+    /** Parse the queues array. */
+    bool _parseQueues(JsonParser &parser);
+
+    /** Parse the timer object. */
+    bool _parseTimer(JsonParser &parser);
+
+    /** Parse the tutorial textures array. */
+    bool _parseTutorialTextures(JsonParser &parser);
+
+    /**
+     * Read a compiled level from mapped contents. The canvases and queue
+     * offsets point into the contents, which this level keeps alive.
+     */
+    bool _readCompiled(const ptr<MappedFile> &contents);
+
+    /** Write this level in the compiled format. */
+    bool _writeCompiled(const string &dest) const;
+
+public:
+    /** Constructor. Use GenericLoader or alloc instead. */
+    Level() :
+        _canvases(nullptr),
+        _queueStart(nullptr),
+        _numQueues(0),
+        _levelTime(-1),
+        _canvasBaseTime(-1),
+        _canvasPerColorTime(-1),
+        _scoreThreshold(-1) {}
+
+    /** Levels point into their own storage, so they cannot be copied. */
+    Level(const Level &) = delete;
+    Level &operator=(const Level &) = delete;
+
+    /** Load a level file relative to the asset directory. */
+    static ptr<Level> alloc(const string &file) {
+        auto result = make_shared<Level>();
+        return result->init(file) ? result : nullptr;
+    }
+
+    /**
+     * Read a level file relative to the asset directory. The format is
+     * detected from the contents, so compiled and JSON levels can be
+     * listed the same way in the asset directory.
+     */
+    bool preload(const string &file) override;
+
+    /** Read and parse the level file named by a directory entry. */
+    bool preload(const json_t &json) override {
+        return preload(json->asString());
+    }
+
+    /**
+     * Parse a level from JSON text.
+     * @return False if the text is not a valid v1 level.
+     */
+    bool parse(const string &text);
+
+    /** Parse a level with the given parser. */
+    bool parse(JsonParser &parser);
+
+    /**
+     * Compile a v1 JSON level into a v2 binary level. Both are ordinary
+     * paths, not relative to the asset directory. The shipped levels are
+     * built by tools/levelc.py, which writes the same format.
+     * @return False if the source is not a valid level or the destination
+     * could not be written.
+     */
+    static bool compile(const string &source, const string &dest);
+
+    /** Get the file this level was loaded from. */
+    const string &getFile() const { return _file; }
+
+    /** Get whether this level was loaded from a compiled file. */
+    bool isCompiled() const { return _contents != nullptr; }
+
+    /** Get the list of colors. */
+    const vec<Color4> &getColors() const { return _colors; }
+
+    /** Get the number of queues. */
+    uint numQueues() const { return _numQueues; }
+
+    /** Get the number of canvases in a queue. */
+    uint numCanvases(uint q) const {
+        return _queueStart[q + 1] - _queueStart[q];
+    }
+
+    /** Get the number of canvases in the whole level. */
+    uint numCanvases() const {
+        return _numQueues == 0 ? 0 : _queueStart[_numQueues];
+    }
+
+    /** Get a canvas. */
+    const LevelCanvas &getCanvas(uint q, uint c) const {
+        return _canvases[_queueStart[q] + c];
+    }
+
+    /** Get the kind of a canvas. */
+    CanvasKind getKind(uint q, uint c) const { return getCanvas(q, c).kind; }
+
+    /** Get the number of colors a canvas asks for. */
+    uint numColors(uint q, uint c) const { return getCanvas(q, c).numColors; }
+
+    /** Get a color index of a canvas. */
+    uint getColor(uint q, uint c, uint i) const {
+        return (getCanvas(q, c).colors >> (4 * i)) & 0xF;
+    }
+
+    /** Get the background texture name, or the default if not specified. */
+    const string &getBackground(const string &def) const {
+        return _background.empty() ? def : _background;
+    }
+
+    /** Get the tutorial texture names. */
+    const vec<string> &getTutorialTextures() const {
+        return _tutorialTextures;
+    }
+
+    /** Get the level time, or the default if not specified. */
+    float getLevelTime(float def) const {
+        return _levelTime < 0 ? def : _levelTime;
+    }
+
+    /** Get the canvas base time, or the default if not specified. */
+    float getCanvasBaseTime(float def) const {
+        return _canvasBaseTime < 0 ? def : _canvasBaseTime;
+    }
+
+    /** Get the per-color canvas time, or the default if not specified. */
+    float getCanvasPerColorTime(float def) const {
+        return _canvasPerColorTime < 0 ? def : _canvasPerColorTime;
+    }
+
+    /** Get the score threshold, or the default if not specified. */
+    float getScoreThreshold(float def) const {
+        return _scoreThreshold < 0 ? def : _scoreThreshold;
+    }
+};
+
+#endif //PANICPAINTER_PPLEVEL_H
@@ -0,0 +1,18 @@
+#include "PPLevelContext.h"
+
+ptr<LevelContext> LevelContext::alloc(const ptr<Level> &level) {
+    auto result = make_shared<LevelContext>();
+    result->_setup(level);
+    return result;
+}
+
+void LevelContext::_setup(const ptr<Level> &level) {
+    _level = level;
+
+    string shapes[] = {"color-circle", "color-heart", "color-square",
+                       "color-diamond", "color-triangle"};
+    _shapes.clear();
+    for (uint i = 0; i < level->getColors().size(); i++) {
+        _shapes.push_back(shapes[i]);
+    }
+}
@@ -0,0 +1,65 @@
+#ifndef PANICPAINTER_PPLEVELCONTEXT_H
+#define PANICPAINTER_PPLEVELCONTEXT_H
+
+#include "utils/PPHeader.h"
+#include "PPLevel.h"
+
+/**
+ * LevelContext is the read-only part of a loaded level: the level itself
+ * and the shapes used for its colors in colorblind mode.
+ *
+ * It is built once per level by GameStateController and shared by pointer
+ * with every view, so no view needs its own copy of the game state. Views
+ * that need the mutable state are handed the controller by reference when
+ * they are updated.
+ * @author Dragonglass Studios
+ */
+class LevelContext {
+private:
+    /** The level this context was built from. */
+    ptr<Level> _level;
+
+    /** The shape texture name of each color. */
+    vec<string> _shapes;
+
+    /** Set up from a level. */
+    void _setup(const ptr<Level> &level);
+
+public:
+    /** Allocate the context of a level. */
+    static ptr<LevelContext> alloc(const ptr<Level> &level);
+
+    /** Get the level this context was built from. */
+    const ptr<Level> &getLevel() const { return _level; }
+
+    /** Get the list of colors. */
+    const vec<Color4> &getColors() const { return _level->getColors(); }
+
+    /** Get the shape string for a given color index. For colorblind mode. */
+    const string &getShapeForColorIndex(uint i) const {
+        CUAssertLog(i < _shapes.size(),
+                    "Could not find the shape for this index.");
+        return _shapes[i];
+    }
+
+    /** Get the number of queues. */
+    uint numQueues() const { return _level->numQueues(); }
+
+    /** Get the number of canvases in a queue. */
+    uint numCanvases(uint q) const { return _level->numCanvases(q); }
+
+    /** Get the kind of a canvas. */
+    CanvasKind getKind(uint q, uint c) const { return _level->getKind(q, c); }
+
+    /** Get if a canvas is an obstacle. */
+    bool isObstacle(uint q, uint c) const {
+        return getKind(q, c) == CanvasKind::OBSTACLE;
+    }
+
+    /** Get if a canvas is a health potion. */
+    bool isHealthPotion(uint q, uint c) const {
+        return getKind(q, c) == CanvasKind::HEALTH_POTION;
+    }
+};
+
+#endif //PANICPAINTER_PPLEVELCONTEXT_H
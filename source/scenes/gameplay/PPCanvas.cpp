@@ -15,20 +15,38 @@ ptr<Canvas> Canvas::alloc(const asset_t &assets,
                   const GameStateController &state, 
                   bool isObstacle, 
                   bool isHealthPotion, uint rowNum) {
-    auto result = make_shared<Canvas>();
+    auto result = allocate_shared<Canvas>(SlabAllocator<Canvas>());
     if (result->initWithBounds(bound))
-        result->_setup(assets, state.getColors(), state.getTimer(queueInd,
-                                                                 canvasInd),
+        result->_setup(assets, state.getContext(), state.getTimer(queueInd,
+                                                                  canvasInd),
                        queueInd, numOfQueues, (uint) state.getColorsOfCanvas
-                       (queueInd, canvasInd).size(), state, isObstacle, isHealthPotion, rowNum);
+                       (queueInd, canvasInd).size(), isObstacle, isHealthPotion, rowNum);
     else
         return nullptr;
+    result->setColors(state.getColorsOfCanvas(queueInd, canvasInd));
     return result;
 };
 
-void Canvas::_setup(const asset_t &assets, const vec<Color4> &colors,
+void Canvas::_setup(const asset_t &assets, const ptr<LevelContext> &context,
                     const ptr<Timer> &timer, uint queueInd, uint numOfQueues, const int numCanvasColors,
-                    const GameStateController &state, bool isObstacle, bool isHealthPotion, uint rowNum) {
+                    bool isObstacle, bool isHealthPotion, uint rowNum) {
+    float laneWidth = getWidth() / MAX_QUEUE;
+    float canvasSize = laneWidth - PADDING * 2;
+    _block = CanvasBlock::alloc(assets, canvasSize, context, numCanvasColors, isObstacle, isHealthPotion);
+    _place(timer, queueInd, numOfQueues, rowNum);
+}
+
+void Canvas::reset(uint queueInd, uint canvasInd, uint numOfQueues,
+                   const GameStateController &state,
+                   bool isObstacle, bool isHealthPotion, uint rowNum) {
+    _block->reset((uint) state.getColorsOfCanvas(queueInd, canvasInd).size(),
+                  isObstacle, isHealthPotion);
+    _place(state.getTimer(queueInd, canvasInd), queueInd, numOfQueues, rowNum);
+    setColors(state.getColorsOfCanvas(queueInd, canvasInd));
+}
+
+void Canvas::_place(const ptr<Timer> &timer, uint queueInd, uint numOfQueues,
+                    uint rowNum) {
     _timer = timer;
 
     float containerWidth = getWidth();
@@ -38,12 +56,10 @@ void Canvas::_setup(const asset_t &assets, const vec<Color4> &colors,
     float laneX = _normalX +
         ((numOfQueues + 1) / 2.0f - 1 - (float)queueInd) * containerWidth *
         VANISHING_POINT_EFFECT;
-    float canvasSize = laneWidth - PADDING * 2;
     _yForActive = getHeight() * .05f;
     _yForStandBy = _yForActive + getHeight() * .45f;
     _startingY = _yForStandBy + getHeight() * .1f;
 
-    _block = CanvasBlock::alloc(assets, canvasSize, colors, numCanvasColors, state, isObstacle, isHealthPotion);
     _block->setScale(MINI_SCALE, MINI_SCALE);
     _block->setAnchor(Vec2::ANCHOR_BOTTOM_CENTER);
     _block->setPosition(laneX, _startingY);
@@ -59,8 +75,11 @@ void Canvas::_setup(const asset_t &assets, const vec<Color4> &colors,
 
     _yAfterLeaving = -_block->getHeight() * 2.5;
 
-    addChild(_block);
+    if (_block->getParent() == nullptr) {
+        addChild(_block);
+    }
     _previousState = rowNum == 0 ? ACTIVE : rowNum == 1 ? STANDBY : HIDDEN;
+    _left = false;
 }
 
 ptr<SceneNode> Canvas::getInteractionNode() const {
@@ -73,7 +92,8 @@ Vec2 Canvas::getFeedbackStartPointInGlobalCoordinates() {
     );
 }
 
-void Canvas::update(CanvasState state, int numSplats, const vec<uint>& canvasColors, Color4 currentColor) {
+void Canvas::setState(CanvasState state) {
+    if (state == _previousState) return;
     // If this canvas should be visible:
     if (state == ACTIVE || state == STANDBY) {
         // Add the block if necessary.
@@ -82,29 +102,39 @@ void Canvas::update(CanvasState state, int numSplats, const vec<uint>& canvasCol
         }
 
         // Set y of block depending on state.
-        if (state != _previousState) {
-            _block->setWalking(true);
-            Animation::to(_block, DURATION, {
-                {"y",       state == ACTIVE ? _yForActive : _yForStandBy},
-                {"opacity", state == ACTIVE ? 1 : .75f},
-                {"scaleX",  state == ACTIVE ? 1 : MINI_SCALE},
-                {"scaleY",  state == ACTIVE ? 1 : MINI_SCALE},
-                {"x", state == ACTIVE ? _normalX : Animation::relative(0)}
-            }, EASING, [=]() {
-                _block->setWalking(false);
-            });
-        }
-
-        // Update block.
+        _block->setWalking(true);
+        Animation::to(_block, DURATION, {
+            {"y",       state == ACTIVE ? _yForActive : _yForStandBy},
+            {"opacity", state == ACTIVE ? 1 : .75f},
+            {"scaleX",  state == ACTIVE ? 1 : MINI_SCALE},
+            {"scaleY",  state == ACTIVE ? 1 : MINI_SCALE},
+            {"x", state == ACTIVE ? _normalX : Animation::relative(0)}
+        }, EASING, [=]() {
+            _block->setWalking(false);
+        });
         _block->setIsActive(state == ACTIVE);
-        _block->update(canvasColors, _timer, numSplats, currentColor);
 
         // If the block is going from shown to hidden.
-    } else if (_block->getParent() != nullptr && state != _previousState) {
+    } else if (_block->getParent() != nullptr) {
         _block->setWalking(true);
         Animation::to(_block, DURATION, {
             {"y",       _yAfterLeaving},
-        }, EASING);
+        }, EASING, [=]() {
+            _left = true;
+        });
     }
     _previousState = state;
 }
+
+void Canvas::setColors(const vec<uint> &canvasColors) {
+    _block->setColors(canvasColors);
+}
+
+void Canvas::paint(Color4 color, const ptr<SplashEffect> &splash) {
+    _block->splat(color, splash);
+}
+
+void Canvas::update() {
+    if (_previousState == ACTIVE || _previousState == STANDBY)
+        _block->update(_timer);
+}
@@ -29,10 +29,13 @@ private:
     /** The timer instance. */
     ptr<Timer> _timer;
 
+    /** Whether the block has finished walking off the screen. */
+    bool _left;
+
     /**
      * Set up.
      * @param assets The asset manager.
-     * @param colors The array of colors for the level. Note that this is NOT
+     * @param context The level, for its colors. Note that this is NOT
      * the colors of this canvas. That is passed in when update() is called.
      * @param timer The timer for this canvas.
      * @param queueInd This is the index of this canvas in the row. For
@@ -42,14 +45,17 @@ private:
      * @param numCanvasColors. This is the number of colors this canvas initially has. Needed for animation
      */
     void _setup(const asset_t &assets,
-                const vec<Color4> &colors,
+                const ptr<LevelContext> &context,
                 const ptr<Timer> &timer,
                 uint queueInd,
                 uint numOfQueues, 
                 const int numCanvasColors,
-                const GameStateController &state, 
                 bool isObstacle, bool isHealthPotion, uint rowNum);
 
+    /** Move the block to its lane and to the row it starts in. */
+    void _place(const ptr<Timer> &timer, uint queueInd, uint numOfQueues,
+                uint rowNum);
+
 public:
     /** Allocate canvas with a particular bound. See _setup() for arguments. */
     
@@ -62,17 +68,38 @@ public:
                              bool isObstacle, bool isHealthPotion, uint rowNum);
 
 
+    /**
+     * Reuse this canvas for another canvas of the same level, so queues do
+     * not need a scene node per canvas. See _setup() for arguments.
+     */
+    void reset(uint queueInd, uint canvasInd, uint numOfQueues,
+               const GameStateController &state,
+               bool isObstacle, bool isHealthPotion, uint rowNum);
+
+    /** Whether this canvas is over and its block has left the screen. */
+    bool hasLeft() const { return _left; }
+
     ptr<SceneNode> getInteractionNode() const;
 
     /**
-     * Update. This will give you the newest canvas state, index of colors on
-     * this canvas. You should keep using the timer given in _setup().
+     * Move the canvas to show a new state. Does nothing if the state is the
+     * same as before.
      */
-    void update(CanvasState state, int numSplats, const vec<uint>& canvasColors, Color4 currentColor);
+    void setState(CanvasState state);
 
-    Vec2 getFeedbackStartPointInGlobalCoordinates();
+    /** Show the remaining colors of the canvas. */
+    void setColors(const vec<uint> &canvasColors);
+
+    /** Splat a color that was painted on the canvas. */
+    void paint(Color4 color, const ptr<SplashEffect> &splash);
+
+    /**
+     * Update the animation of the character, which depends on the timer
+     * given in _setup(). Only canvases in view need this.
+     */
+    void update();
 
-    CanvasState getPreviousState() { return _previousState; }
+    Vec2 getFeedbackStartPointInGlobalCoordinates();
 };
 
 #endif //PANICPAINTER_PPCANVAS_H
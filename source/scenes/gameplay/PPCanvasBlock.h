@@ -6,13 +6,19 @@
 #include "controllers/PPInputController.h"
 #include "PPColorStrip.h"
 #include "utils/PPAnimation.h"
-#include "controllers/PPGameStateController.h"
+#include "utils/PPFilmstrip.h"
+#include "models/PPLevelContext.h"
 #include "utils/PPRandom.h"
+#include "PPSplashEffect.h"
 
 #include <string>
 
 #define NUM_CHARACTERS 10
 #define SWITCH_FILMSTRIP 9
+/** Frames per second of each filmstrip. */
+#define BLINK_FPS 5
+#define EMOTION_FPS 10
+#define WALK_FPS 15
 
 /**
  * Canvas block is the little square that represents a canvas. It also includes
@@ -35,13 +41,8 @@ private:
     /** The timer text. */
     ptr<Label> _timerText;
 
-    ptr<PolygonNode>_splat1;
-    ptr<PolygonNode>_splat2;
-    ptr<PolygonNode>_splat3;
-    ptr<PolygonNode>_splat4;
-
-    /*When to update the animation*/
-    int _updateFrame;
+    /** Which filmstrip the background is playing. */
+    enum Strip { NO_STRIP, IDLE_STRIP, WALK_STRIP, EMOTION_STRIP } _strip;
     /*How angry is the character*/
     int _angerLevel;
     /*Is the block active? If yes, do the animation, otherwise, stay at frame 0 of image 0*/
@@ -56,22 +57,39 @@ private:
     /*Texture splats*/
     int _numSplats;
     int _startingSplat;
-    /** Game state. */
-    GameStateController _state;
+    /** Colors already splatted on this canvas. */
+    vec<Color4> _splatColors;
+    /** Asset manager, for the textures of the next canvas. */
+    asset_t _assets;
     ptr<Texture> _texture;
     void _bg_setTexture(ptr<Texture> t) {
         _texture = t;
     }
+    /** Play a whole filmstrip on the background. */
+    void _play(const ptr<Texture> &texture, float fps, bool once);
+
+    /** Pick the filmstrip for the state of this canvas. */
+    void _animate(const ptr<Timer> &timer);
+
+    /** Get angrier if it is time to, and play the emotion once. */
+    void _emote(const ptr<Timer> &timer);
+
     /** Set up this block. */
-    void _setup(const asset_t &assets, const vec<Color4> &colors, const int numCanvasColors, const GameStateController &state, bool isObstacle, bool isHealthPotion);
+    void _setup(const asset_t &assets, const ptr<LevelContext> &context, const int numCanvasColors, bool isObstacle, bool isHealthPotion);
     
 
 public:
     /** Allocate canvas block with a particular length on the side. */
     static ptr<CanvasBlock> alloc(const asset_t &assets,
                                   float size,
-                                  const vec<Color4> &colors, const int numCanvasColors,
-                                  const GameStateController &state, bool isObstacle, bool isHealthPotion);
+                                  const ptr<LevelContext> &context, const int numCanvasColors,
+                                  bool isObstacle, bool isHealthPotion);
+
+    /**
+     * Reuse this block for another canvas. The character is picked again and
+     * all splats are removed.
+     */
+    void reset(const int numCanvasColors, bool isObstacle, bool isHealthPotion);
 
     void setIsActive(bool isActive);
 
@@ -79,12 +97,18 @@ public:
 
     void setWalking(bool value);
 
+    /** Show the remaining colors on the color strip. */
+    void setColors(const vec<uint> &canvasColors);
+
     /**
-     * Update the canvas block.
-     * @param canvasColors The vector of color indexes.
+     * Splat a color painted on this canvas. Each color only splats once,
+     * up to four splats.
+     * @param splash Where splats on this canvas are painted.
      */
-    void update(const vec<uint>& canvasColors,
-        const ptr<Timer>& timer,int numSplats, Color4 currentColor);
+    void splat(Color4 color, const ptr<SplashEffect> &splash);
+
+    /** Update the animation of the character. */
+    void update(const ptr<Timer>& timer);
 };
 
 #endif //PANICPAINTER_PPCANVASBLOCK_H
@@ -15,29 +15,27 @@
 #define PRESSED_SCALE 1.2f
 
 ptr<ColorPalette> ColorPalette::alloc(const Rect &bounds,
-                                      const vec<Color4> &colors,
                                       const asset_t &assets,
-                                      const GameStateController &state) {
-    auto result = make_shared<ColorPalette>(colors);
+                                      const ptr<LevelContext> &context) {
+    auto result = make_shared<ColorPalette>();
     // change to init with texture after changing the header file
     if (result->initWithBounds(bounds))
-        result->_setup(bounds, colors, assets, state);
+        result->_setup(bounds, assets, context);
     else
         return nullptr;
     return result;
 }
 
 void ColorPalette::_setup(const Rect &bounds,
-                          const vec<Color4> &colors,
                           const asset_t &assets,
-                          const GameStateController &state) {
+                          const ptr<LevelContext> &context) {
 #ifdef VIEW_DEBUG
     auto n = PolygonNode::alloc(Rect(Vec2::ZERO, getContentSize()));
     n->setColor(Color4f(0, 0, 1, .3));
     addChild(n);
 #endif
 
-    _paletteView = ColorPaletteView::alloc(colors, assets, state);
+    _paletteView = ColorPaletteView::alloc(assets, context);
     float scale = getWidth() / _paletteView->getWidth();
     _paletteView->setScale(1.15*scale);
     _paletteView->setPositionY(getHeight() / 2);
@@ -12,30 +12,23 @@
 #include "utils/PPHeader.h"
 #include "utils/PPAnimation.h"
 #include "controllers/PPInputController.h"
-#include "controllers/PPGameStateController.h"
+#include "models/PPLevelContext.h"
 #include "PPColorPaletteView.h"
 
 // change to texturedNode
 class ColorPalette : public SceneNode {
 
     ptr<ColorPaletteView> _paletteView;
-    
-    GameStateController _state;
 
     void _setup(const Rect &bounds,
-                const vec<Color4> &colors,
                 const asset_t &assets,
-                const GameStateController &state);
+                const ptr<LevelContext> &context);
 
 public:
 
-    /** @deprecated Constructor. */
-    explicit ColorPalette(const vec<Color4> &colors) {};
-
     static ptr<ColorPalette> alloc(const Rect &bounds,
-                                   const vec<Color4> &colors,
                                    const asset_t &assets,
-                                   const GameStateController &state);
+                                   const ptr<LevelContext> &context);
     
     /** Set the currently selected color to the appropriate index. */
     void setColor(uint colorIndex) {
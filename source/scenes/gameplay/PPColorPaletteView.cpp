@@ -19,13 +19,12 @@
 #define CURVATURE 2.2 /** Curvature constant for the palette. */
 
 ptr<ColorPaletteView> ColorPaletteView::alloc(
-    const vec<Color4> &colors,
     const asset_t &assets,
-    const GameStateController &state) {
+    const ptr<LevelContext> &context) {
     auto result =
-        make_shared<ColorPaletteView>(colors, assets);
+        make_shared<ColorPaletteView>(context->getColors(), assets);
     if (result->init())
-        result->_setup(state);
+        result->_setup(context);
     else
         return nullptr;
     return result;
@@ -49,7 +48,7 @@ float ColorPaletteView::_computeXPositioning(uint ind) {
     return result;
 }
 
-void ColorPaletteView::_setup(const GameStateController &state) {
+void ColorPaletteView::_setup(const ptr<LevelContext> &context) {
     setAnchor(Vec2::ANCHOR_MIDDLE_LEFT);
     setPosition(Vec2::ZERO);
     int numColors = (int)_colors.size();
@@ -104,8 +103,8 @@ void ColorPaletteView::_setup(const GameStateController &state) {
                                               _colors[i],
                                       pscale * PALETTE_COLOR_SIZE);
         if (SaveController::getInstance()->getColorblind()) {
-            btn = ColorCircle::alloc(_assets->get<Texture>(state.getShapeForColorIndex(i)),
-                                                  _assets->get<Texture>(state.getShapeForColorIndex(i) + "-border"),
+            btn = ColorCircle::alloc(_assets->get<Texture>(context->getShapeForColorIndex(i)),
+                                                  _assets->get<Texture>(context->getShapeForColorIndex(i) + "-border"),
                                                   _colors[i],
                                      pscale * PALETTE_COLOR_SIZE
                                      );
@@ -11,7 +11,7 @@
 
 #include "utils/PPHeader.h"
 #include "utils/PPAnimation.h"
-#include "controllers/PPGameStateController.h"
+#include "models/PPLevelContext.h"
 #include "controllers/PPInputController.h"
 #include "controllers/PPSaveController.h"
 #include "PPColorCircle.h"
@@ -36,7 +36,7 @@ class ColorPaletteView : public SceneNode {
     /** Button hover states. */
     vec<ColorButtonState> _buttonStates;
 
-    void _setup(const GameStateController &state);
+    void _setup(const ptr<LevelContext> &context);
 
     void _animateButtonState(uint ind, ColorButtonState s);
 
@@ -53,9 +53,8 @@ public:
         SceneNode(), _colors(colors), _selectedColor(0), _assets(assets) {};
     
     static ptr<ColorPaletteView> alloc(
-        const vec<Color4> &colors,
         const asset_t &assets,
-        const GameStateController &state);
+        const ptr<LevelContext> &context);
 
     /** Set the currently selected color to the appropriate index. */
     void setColor(uint colorIndex) {
@@ -3,19 +3,22 @@
 ptr<ColorStrip> ColorStrip::alloc(
         uint size,
         const asset_t& assets,
-        const vec<Color4> &colors,
-        const GameStateController &state) {
-    auto result = make_shared<ColorStrip>(size,  assets, colors);
+        const ptr<LevelContext> &context) {
+    auto result = allocate_shared<ColorStrip>(SlabAllocator<ColorStrip>(), size,  assets);
     if (result->init())
-        result->_setup(state);
+        result->_setup(context);
     else
         return nullptr;
     return result;
 }
 
-void ColorStrip::_setup(
-    const GameStateController& state) {
-    _state = state; 
+void ColorStrip::_setup(const ptr<LevelContext> &context) {
+    _context = context;
+}
+
+void ColorStrip::reset() {
+    _lastNumberOfColors = 0;
+    removeAllChildren();
 }
 
 void ColorStrip::update(const vec<uint> &canvasColors) {
@@ -30,10 +33,10 @@ void ColorStrip::update(const vec<uint> &canvasColors) {
         auto colorTexture = _assets->get<Texture>("color-circle");
         auto overlayTexture = _assets->get<Texture>("color-circle-border");
         if(SaveController::getInstance()->getColorblind()) {
-            colorTexture = _assets->get<Texture>(_state.getShapeForColorIndex(canvasColors[i]));
-            overlayTexture = _assets->get<Texture>(_state.getShapeForColorIndex(canvasColors[i]) + "-border");
+            colorTexture = _assets->get<Texture>(_context->getShapeForColorIndex(canvasColors[i]));
+            overlayTexture = _assets->get<Texture>(_context->getShapeForColorIndex(canvasColors[i]) + "-border");
         }
-        auto bg = ColorCircle::alloc(colorTexture, overlayTexture, _colors[canvasColors[i]], _size, 3);
+        auto bg = ColorCircle::alloc(colorTexture, overlayTexture, _context->getColors()[canvasColors[i]], _size, 3);
         bg->setAnchor(Vec2::ANCHOR_BOTTOM_LEFT);
         bg->setContentSize(_size, _size);
 
@@ -44,7 +47,7 @@ void ColorStrip::update(const vec<uint> &canvasColors) {
         bg->setPosition(
             leftMostX + ((_size * 0.3f) + _size) * (float) i,
             -(float) _size / 2);
-        //bg->setColor(_colors[canvasColors[i]]);
+        //bg->setColor(_context->getColors()[canvasColors[i]]);
 
         addChild(bg);
     }
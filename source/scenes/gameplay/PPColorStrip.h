@@ -2,7 +2,7 @@
 #define PANICPAINTER_PPCOLORSTRIP_H
 
 #include "utils/PPHeader.h"
-#include "controllers/PPGameStateController.h"
+#include "models/PPLevelContext.h"
 #include "controllers/PPSaveController.h"
 #include "PPColorCircle.h"
 /**
@@ -20,19 +20,18 @@ protected:
 
     uint _size;
 
-    /** Color list. */
-    const vec<Color4> _colors;
-
     const asset_t &_assets;
-    
-    GameStateController _state;
-    void _setup(const GameStateController& state);
+
+    /** The level, for its colors and shapes. */
+    ptr<LevelContext> _context;
+
+    void _setup(const ptr<LevelContext> &context);
 
 public:
     /** @deprecated Constructor. */
-    explicit ColorStrip(uint size, const asset_t &assets, const vec<Color4> &colors) :
+    explicit ColorStrip(uint size, const asset_t &assets) :
             SceneNode(), _lastNumberOfColors(0),
-            _colors(colors), _assets(assets), _size(size) {};
+            _assets(assets), _size(size) {};
 
 
 
@@ -40,8 +39,7 @@ public:
     static ptr<ColorStrip> alloc(
             uint size,
             const asset_t &assets,
-            const vec<Color4> &colors,
-            const GameStateController &state);
+            const ptr<LevelContext> &context);
 
    
 
@@ -50,6 +48,9 @@ public:
      * @param canvasColors The vector of color indexes.
      */
     void update(const vec<uint> &canvasColors);
+
+    /** Remove all color dots so the next update redraws them. */
+    void reset();
 };
 
 #endif //PANICPAINTER_PPCOLORSTRIP_H
@@ -22,6 +22,12 @@ void Feedback::_setup(const Rect &screen, const asset_t &assets) {
     _goodjobs.push_back("Cool!");
     _goodjobs.push_back("Incredible!");
     _goodjobs.push_back("Marvelous!");
+    for (uint i = 1; i <= 3; i++) {
+        _textures[FAILURE][i - 1] =
+            assets->get<Texture>("feedback-wrong" + to_string(i));
+        _textures[SUCCESS][i - 1] =
+            assets->get<Texture>("feedback-correct" + to_string(i));
+    }
 }
 
 void Feedback::add(Vec2 at, Vec2 dangerBarPoint, FeedbackType type) {
@@ -38,25 +44,10 @@ void Feedback::update(float timestep) {
         FeedbackType type = element.type;
         Vec2 at = element.at;
         Vec2 dangerBarPoint = element.dangerBarPoint;
-        string txtt;
-        ptr<Texture> txtu[3];
-        switch (type) {
-            case SUCCESS: {
-                txtt = "correct";
-                break;
-            }
-            case FAILURE: {
-                txtt = "wrong";
-                break;
-            }
-            default: {
-                CUAssertLog(false, "Unknown feedback type.");
-            }
-        }
-        for (uint i = 1; i <= 3; i++) {
-            txtu[i - 1] =
-                _assets->get<Texture>("feedback-" + txtt + to_string(i));
-        }
+        CUAssertLog(type == SUCCESS || type == FAILURE,
+                    "Unknown feedback type.");
+        // No strings to build or look up each time.
+        const ptr<Texture> *txtu = _textures[type];
         if (type == SUCCESS) {
             for (uint i = 0; i < 25; i++) {
                 auto n = PolygonNode::allocWithTexture
@@ -106,6 +97,6 @@ void Feedback::update(float timestep) {
                 });
             }
         }
-        _items.clear();
     }
+    _items.clear();
 }
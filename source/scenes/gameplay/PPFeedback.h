@@ -20,6 +20,8 @@ class Feedback : public SceneNode {
     Rect _screen;
     vec<string> _goodjobs;
     vec<FeedbackItem> _items;
+    /** The three textures of each feedback type, looked up once. */
+    ptr<Texture> _textures[2][3];
 
     void _setup(const Rect &screen, const asset_t &assets);
 
@@ -4,6 +4,7 @@
 #define TIMER_HEIGHT .1f
 
 void GameScene::dispose() {
+    unload();
     Scene2::dispose();
 }
 
@@ -14,9 +15,38 @@ bool GameScene::init(const asset_t &assets) {
     return true;
 }
 
-void GameScene::loadLevel(const string &levelName) {
+void GameScene::prepareLevel(const string &levelName,
+                             const function<void()> &ready) {
+    if (isPreparing(levelName)) return;
     CULog("Loading level %s...", levelName.c_str());
+    uint preparation = ++_preparation;
 
+    // The world of a level is the part of its name before the dash. Get
+    // its assets before letting go of the old ones, in case they are the
+    // same.
+    string group = levelName.substr(0, levelName.find('-'));
+    AssetGroupController::getInstance().acquire(group, [=]() {
+        if (ready && _preparation == preparation) ready();
+    });
+    unload();
+    _group = group;
+    _levelName = levelName;
+    _played = false;
+    _paletteLeft = SaveController::getInstance()->getPaletteLeft();
+    _vfx = SaveController::getInstance()->getVfx();
+
+    // The number of queues is not known until the state is loaded.
+    _loadStep = 0;
+    _numLoadSteps = 1;
+}
+
+bool GameScene::isPreparing(const string &levelName) const {
+    return _levelName == levelName && !_played &&
+           _paletteLeft == SaveController::getInstance()->getPaletteLeft() &&
+           _vfx == SaveController::getInstance()->getVfx();
+}
+
+void GameScene::unload() {
     // Remove all children to reset.
     removeAllChildren();
 
@@ -24,64 +54,85 @@ void GameScene::loadLevel(const string &levelName) {
     _tos.reset();
     _palette.reset();
     _action.reset();
+    _queues.clear();
+    _canvasPool = nullptr;
     _complete = nullptr;
-    
-    // Find Level file.
-    const json_t levelJson = _assets->get<JsonValue>(levelName);
-    _levelName = levelName;
+    _levelName.clear();
+    _loadStep = _numLoadSteps = 0;
+    if (!_group.empty()) {
+        AssetGroupController::getInstance().release(_group);
+        _group.clear();
+    }
+}
 
-    auto i = levelName.find('-');
+bool GameScene::isWaiting() const {
+    // Only the state can be loaded without the assets of the world.
+    return _loadStep > 0 && !isLoaded() &&
+           !AssetGroupController::getInstance().isLoaded(_group);
+}
+
+bool GameScene::loadStep() {
+    if (isLoaded()) return true;
+    if (isWaiting()) return false;
+    if (_loadStep == 0) {
+        _loadState();
+        // State, background, each queue, and the rest.
+        _numLoadSteps = _state.numQueues() + 3;
+    } else if (_loadStep == 1) {
+        _loadBackground();
+    } else if (_loadStep < _numLoadSteps - 1) {
+        _loadQueue(_loadStep - 2);
+    } else {
+        _loadHud();
+    }
+    _loadStep++;
+    return isLoaded();
+}
+
+void GameScene::_loadState() {
+    auto i = _levelName.find('-');
     if (i != string::npos) {
-        _musicName = levelName.substr(0, i);
+        _musicName = _levelName.substr(0, i);
     } else {
         _musicName = "";
     }
 
     // Ask state to load it.
-    _state.loadJson(levelJson);
+    _state.loadLevel(_assets->get<Level>(_levelName));
     
     _tutorialTracker = 0;
     
     CULog("Max Score: %f", _state.getMaxScore());
-    Size screenSize = Application::get()->getDisplaySize();
+}
+
+void GameScene::_loadBackground() {
     Rect safeArea = Application::get()->getSafeBounds();
 
-    string backgroundName = levelJson->has("background") ?
-        levelJson->getString("background") :
-        "background";
+    string backgroundName =
+        _assets->get<Level>(_levelName)->getBackground("background");
     auto background =
         PolygonNode::allocWithTexture(_assets->get<Texture>(backgroundName));
     background->setContentSize(Application::get()->getDisplaySize());
     addChild(background);
     // Clear canvases.
-    _canvases.clear();
-    for (uint i = 0, j = _state.numQueues(); i < j; i++) {
-        vec<ptr<Canvas>> queue;
-        for (int i2 = (int) (_state.numCanvases(i)) - 1; i2 >= 0; i2--) {
-            auto bound = safeArea;
-            bool isObstacle = _state.getIsObstacle(i, i2);
-            bool isHealthPotion = _state.getIsHealthPotion(i, i2);
-            if (SaveController::getInstance()->getPaletteLeft()) {
-                bound.origin.x += PALETTE_WIDTH * bound.size.width;
-            }
-            bound.size.width *= (1 - PALETTE_WIDTH);
-            bound.size.height *= (1 - TIMER_HEIGHT);
-            auto c = Canvas::alloc(
-                _assets,
-                i,
-                i2,
-                j,
-                bound,
-                _state, 
-                isObstacle,
-                isHealthPotion,
-                i2
-            );
-            addChild(c);
-            queue.insert(queue.begin(), 1, c);
-        }
-        _canvases.push_back(queue);
+    auto bound = safeArea;
+    if (_paletteLeft) {
+        bound.origin.x += PALETTE_WIDTH * bound.size.width;
     }
+    bound.size.width *= (1 - PALETTE_WIDTH);
+    bound.size.height *= (1 - TIMER_HEIGHT);
+    _canvasPool = CanvasPool::alloc(_assets, bound);
+}
+
+void GameScene::_loadQueue(uint queue) {
+    auto view = QueueView::alloc(queue, _state.numQueues(), _canvasPool,
+                                 _state);
+    addChild(view);
+    _queues.push_back(view);
+}
+
+void GameScene::_loadHud() {
+    Rect safeArea = Application::get()->getSafeBounds();
 
     _backBtn = PolygonNode::allocWithTexture
         (_assets->get<Texture>("backbutton"));
@@ -89,7 +140,7 @@ void GameScene::loadLevel(const string &levelName) {
                        (safeArea.size.height * TIMER_HEIGHT) /
                        _backBtn->getContentWidth());
     _backBtn->setAnchor(Vec2::ANCHOR_TOP_RIGHT);
-    if (SaveController::getInstance()->getPaletteLeft()) {
+    if (_paletteLeft) {
         _backBtn->setPosition(safeArea.size.width, safeArea.size.height);
     } else {
         _backBtn->setPosition(safeArea.origin.x + _backBtn->getWidth(), safeArea.size.height);
@@ -119,8 +170,8 @@ void GameScene::loadLevel(const string &levelName) {
                 safeArea.size.width * PALETTE_WIDTH,
                 safeArea.size.height * (1 - TIMER_HEIGHT)
             )
-        ), _state.getColors(), _assets, _state);
-    if (!SaveController::getInstance()->getPaletteLeft()) {
+        ), _assets, _state.getContext());
+    if (!_paletteLeft) {
         float transform[] = {
             -1, 0, 0, 0,
             0, 1, 0, 0,
@@ -136,7 +187,7 @@ void GameScene::loadLevel(const string &levelName) {
     auto gtBound = safeArea;
     gtBound.origin.y += (1 - TIMER_HEIGHT) * gtBound.size.height;
     gtBound.size.height *= TIMER_HEIGHT;
-    if (SaveController::getInstance()->getPaletteLeft()) {
+    if (_paletteLeft) {
         gtBound.origin.x = _palette->getBoundingBox().getMaxX() + 10;
         gtBound.size.width = _backBtn->getBoundingBox().getMinX() - 10 -
             gtBound.origin.x;
@@ -152,9 +203,9 @@ void GameScene::loadLevel(const string &levelName) {
 
     _feedback = Feedback::alloc(Application::get()->getDisplayBounds(),
                                 _assets);
-    if (SaveController::getInstance()->getVfx()) {
-        addChild(_splash);
-    }
+    _subscribe();
+    // Splats on canvases are painted here even without the drag effect.
+    addChild(_splash);
     addChild(_tos);
     addChild(_palette);
     addChild(_feedback);
@@ -168,14 +219,54 @@ void GameScene::loadLevel(const string &levelName) {
     }
 
 
-    _action = make_shared<ActionController>(_state, _canvases);
+    _action = make_shared<ActionController>(_state, _queues);
 
     addChild(_backBtn);
 
 }
 
+void GameScene::_subscribe() {
+    // Canvases.
+    _state.subscribe([this](const GameEvent &e) {
+        auto &queue = _queues[e.queue];
+        switch (e.type) {
+            case GameEvent::COLOR_CLEARED:
+                queue->get(e.canvas)->setColors(
+                    _state.getColorsOfCanvas(e.queue, e.canvas));
+                queue->get(e.canvas)->paint(_state.getColors()[e.color],
+                                            _splash);
+                break;
+            case GameEvent::WRONG_COLOR:
+                queue->get(e.canvas)->paint(_state.getColors()[e.color],
+                                            _splash);
+                break;
+            default:
+                queue->refresh(_state);
+        }
+    });
+
+    // Feedback flying from finished canvases to the danger bar.
+    _state.subscribe([this](const GameEvent &e) {
+        if (e.type != GameEvent::CANVAS_DONE &&
+            e.type != GameEvent::POTION_USED &&
+            e.type != GameEvent::CANVAS_LOST &&
+            e.type != GameEvent::BOMB_EXPLODED) return;
+        FeedbackType t = e.type == GameEvent::CANVAS_DONE ||
+                         e.type == GameEvent::POTION_USED ?
+                         FeedbackType::SUCCESS : FeedbackType::FAILURE;
+        _feedback->add(_queues[e.queue]->get(e.canvas)
+                           ->getFeedbackStartPointInGlobalCoordinates(),
+                       _tos->getDangerBarPoint(), t);
+    });
+
+    _state.subscribe([](const GameEvent &e) {
+        SoundController::getInstance()->onGameEvent(e);
+    });
+}
+
 void GameScene::update(float timestep) {
     auto &input = InputController::getInstance();
+    _played = true;
     
     int prevTutorialTracker = _tutorialTracker;
     int numTutorialOverlays = (int) _state.getTutorialTextures().size();
@@ -208,9 +299,7 @@ void GameScene::update(float timestep) {
 
     if (input.justReleased() && input.isJustTap() &&
         InputController::inScene(input.currentPoint(), _backBtnArea)) {
-        if ((SaveController::getInstance()->getVfx())) {
-            _splash->clear();
-        }
+        _splash->clear();
         _pauseRequest = true;
     }
 
@@ -219,8 +308,8 @@ void GameScene::update(float timestep) {
     else if (mul > 30) mul = 30;
 
     float health = 1 - (float)(_state.getScoreMetric("wrongAction") +
-        _state.getScoreMetric("timedOut") - (_state.getHealthBack()* _state.getState().nCanvasInLevel / 50)) /
-            (_state.getState().nCanvasInLevel / 5);
+        _state.getScoreMetric("timedOut") - (_state.getHealthBack()* _state.numCanvasesInLevel() / 50)) /
+            (_state.numCanvasesInLevel() / 5);
     if (health < 0) health = 0;
     if (health > 1) health = 1;
 
@@ -238,35 +327,17 @@ void GameScene::update(float timestep) {
     }
     _tos->update(health, mul, stars);
 
-    set<pair<uint, uint>> activeCanvases;
+    // The views only hear about what changed since the last frame.
+    _state.dispatchEvents();
 
+    frame_set<pair<uint, uint>> activeCanvases;
     for (uint i = 0, j = _state.numQueues(); i < j; i++) {
-        for (uint i2 = 0, j2 = _state.numCanvases(i); i2 < j2; i2++) {
-            // Get the derived canvas state and pass it to the canvases.
-            auto state = _state.getCanvasState(i, i2);
-            auto ps = _canvases[i][i2]->getPreviousState();
-            _canvases[i][i2]->update(state, _state.getNumSplats(i, i2),
-                _state.getColorsOfCanvas(i, i2), _state.getColors()[_palette->getSelectedColor()]);
-            if (_state.getNumSplats(i, i2) >= 4){
-                _state.removeSplats(i, i2);
-               }
-            if (state == ACTIVE)
-                activeCanvases.insert(pair<uint, uint>(i, i2));
-
-            if ((state == LOST_DUE_TO_TIME ||
-            state == LOST_DUE_TO_WRONG_ACTION ||
-            state == DONE) && ps == ACTIVE) {
-                FeedbackType t = (state == DONE) ?
-                                           FeedbackType::SUCCESS :
-                                           FeedbackType::FAILURE;
-                _feedback->add(
-                    _canvases[i][i2]->getFeedbackStartPointInGlobalCoordinates(),
-                    _tos->getDangerBarPoint(),
-                    t);
-                if (state == LOST_DUE_TO_TIME)
-                    _state.setLevelMultiplier(1);
-            }
-        }
+        // Only canvases in view are updated; the others have no node.
+        _queues[i]->advance(_state);
+        _queues[i]->update();
+        int active = _state.getActiveCanvas(i);
+        if (active >= 0)
+            activeCanvases.insert(pair<uint, uint>(i, active));
     }
     
     _feedback->update(timestep);
@@ -279,20 +350,16 @@ void GameScene::update(float timestep) {
     }
     bool pressing = input.isPressing() &&
                     !InputController::inScene(input.currentPoint(), _palette->getBoundingBox());
-    if (SaveController::getInstance()->getVfx()) {
-        _splash->update(timestep,
-            activeCanvases.empty() ? Color4::CLEAR :
-            _state.getColors()[_palette->getSelectedColor()],
-            pressing ? input.currentPoint() : Vec2::ZERO);
-    }
+    _splash->update(timestep,
+        activeCanvases.empty() || !_vfx ? Color4::CLEAR :
+        _state.getColors()[_palette->getSelectedColor()],
+        pressing ? input.currentPoint() : Vec2::ZERO);
     _action->update(activeCanvases, _palette->getSelectedColor());
     
     // Check if the level is complete
     if ((activeCanvases.empty() || health < 0.01f) &&
     !_congratulations) {
-        if (SaveController::getInstance()->getVfx()) {
-            _splash->clear();
-        }
+        _splash->clear();
         //Gradually clear out the splatters
         _complete = make_shared<Timer>(5);
         auto ds = Application::get()->getDisplaySize();
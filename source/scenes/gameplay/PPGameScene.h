@@ -4,8 +4,10 @@
 #include "utils/PPHeader.h"
 #include "controllers/PPInputController.h"
 #include "controllers/PPGameStateController.h"
+#include "controllers/PPAssetGroupController.h"
 #include "utils/PPAnimation.h"
 #include "PPCanvas.h"
+#include "PPQueueView.h"
 #include "PPColorPalette.h"
 #include "PPTopOfScreen.h"
 #include "controllers/PPActionController.h"
@@ -24,12 +26,11 @@ private:
     asset_t _assets;
     /** Game state. */
     GameStateController _state;
-    /**
-     * Scene nodes of canvases.
-     *
-     * Outer vector is holding queues, inner is queue holding canvases.
-     */
-    vec<vec<ptr<Canvas>>> _canvases;
+    /** Views of the queues. Each one only has nodes for visible canvases. */
+    vec<ptr<QueueView>> _queues;
+
+    /** Canvases not in any view, shared by all queues. */
+    ptr<CanvasPool> _canvasPool;
 
     ptr<TopOfScreen> _tos;
 
@@ -54,13 +55,49 @@ private:
     string _levelName;
 
     string _musicName;
+
+    /** The asset group of the world of the level. */
+    string _group;
     
     int _tutorialTracker;
     
     ptr<PolygonNode> _tutorialOverlay;
 
+    /** The next loading step to run. */
+    uint _loadStep;
+
+    /** The number of loading steps. Only known once the state is loaded. */
+    uint _numLoadSteps;
+
+    /** How many levels were prepared, so steps of an older one can tell. */
+    uint _preparation;
+
+    /** Whether the scene has been updated since it was loaded. */
+    bool _played;
+
+    /** The settings the scene was laid out with. */
+    bool _paletteLeft, _vfx;
+
+    /** Load the level into the game state. */
+    void _loadState();
+
+    /** Add the background and make the canvas pool. */
+    void _loadBackground();
+
+    /** Add the view of one queue, with the canvases already in view. */
+    void _loadQueue(uint queue);
+
+    /** Add the palette, the top of the screen and the other overlays. */
+    void _loadHud();
+
+    /** Let the canvases, the feedback and the sounds hear game events. */
+    void _subscribe();
+
 public:
-    GameScene() : Scene2(), _pauseRequest(false), _complete(nullptr) {}
+    GameScene() : Scene2(), _pauseRequest(false), _complete(nullptr),
+                  _loadStep(0), _numLoadSteps(0), _preparation(0),
+                  _played(false),
+                  _paletteLeft(false), _vfx(false) {}
 
     ~GameScene() { dispose(); }
 
@@ -71,10 +108,44 @@ public:
     void update(float timestep) override;
 
     /**
-     * Load a level and reset the game scene.
+     * Start loading a level and reset the game scene. The level is built
+     * one step at a time with loadStep(), so it can be spread over several
+     * frames, and the scene shows nothing sensible until it is loaded. Does
+     * nothing if the level is already being prepared.
      * @param levelName The name of the level, must be defined in assets JSON.
+     * @param ready Called once the assets of the level's world are loaded,
+     * after which loadStep() can make progress. Not called if another
+     * level is prepared by then.
+     */
+    void prepareLevel(const string &levelName,
+                      const function<void()> &ready = nullptr);
+
+    /**
+     * Run the next loading step: the state, the background, each queue, or
+     * the HUD. Does nothing if the level is loaded, or if the assets of
+     * the level's world are not loaded yet.
+     * @return Whether the level is now loaded.
+     */
+    bool loadStep();
+
+    /** Remove the level and let go of the assets of its world. */
+    void unload();
+
+    /** Whether the level started last is completely loaded. */
+    bool isLoaded() const { return _loadStep >= _numLoadSteps; }
+
+    /** Whether loadStep() cannot make progress until the world is loaded. */
+    bool isWaiting() const;
+
+    /** The number of levels prepared so far. */
+    uint getPreparation() const { return _preparation; }
+
+    /**
+     * Whether this scene is loading or has loaded the level, has not been
+     * played, and was laid out with the current settings. If so, it can be
+     * finished and shown instead of loading the level again.
      */
-    void loadLevel(const string &levelName);
+    bool isPreparing(const string &levelName) const;
 
     bool getPauseRequest() {
         bool r = _pauseRequest;
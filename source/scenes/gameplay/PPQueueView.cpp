@@ -0,0 +1,87 @@
+#include "PPQueueView.h"
+
+ptr<Canvas> CanvasPool::obtain(uint queueInd, uint canvasInd,
+                               uint numOfQueues,
+                               const GameStateController &state,
+                               uint rowNum) {
+    bool isObstacle = state.getIsObstacle(queueInd, canvasInd);
+    bool isHealthPotion = state.getIsHealthPotion(queueInd, canvasInd);
+    if (_free.empty()) {
+        return Canvas::alloc(_assets, queueInd, canvasInd, numOfQueues,
+                             _bound, state, isObstacle, isHealthPotion,
+                             rowNum);
+    }
+    auto result = _free.back();
+    _free.pop_back();
+    result->reset(queueInd, canvasInd, numOfQueues, state, isObstacle,
+                  isHealthPotion, rowNum);
+    return result;
+}
+
+void CanvasPool::release(const ptr<Canvas> &canvas) {
+    _free.push_back(canvas);
+}
+
+ptr<QueueView> QueueView::alloc(uint queue, uint numQueues,
+                                const ptr<CanvasPool> &pool,
+                                const GameStateController &state) {
+    auto result = make_shared<QueueView>();
+    if (result->init())
+        result->_setup(queue, numQueues, pool, state);
+    else
+        return nullptr;
+    return result;
+}
+
+void QueueView::_setup(uint queue, uint numQueues,
+                       const ptr<CanvasPool> &pool,
+                       const GameStateController &state) {
+    _queue = queue;
+    _numQueues = numQueues;
+    _pool = pool;
+    _front = 0;
+    for (uint i = 0, j = state.numCanvases(queue); i < j; i++) {
+        auto s = state.getCanvasState(queue, i);
+        if (s == HIDDEN) break;
+        _take(state, s == ACTIVE ? 0 : s == STANDBY ? 1 : 2);
+    }
+}
+
+void QueueView::_take(const GameStateController &state, uint rowNum) {
+    uint canvasInd = end();
+    auto canvas = _pool->obtain(_queue, canvasInd, _numQueues, state, rowNum);
+    // Canvases in front are drawn on top of the ones behind them.
+    addChild(canvas, -(int) canvasInd);
+    sortZOrder();
+    _window.push_back(canvas);
+}
+
+void QueueView::advance(const GameStateController &state) {
+    // Canvases only leave from the front of the queue.
+    while (!_window.empty() && _window.front()->hasLeft()) {
+        removeChild(_window.front());
+        _pool->release(_window.front());
+        _window.pop_front();
+        _front++;
+    }
+
+    // Everything behind the first hidden canvas is hidden as well.
+    for (uint i = end(), j = state.numCanvases(_queue); i < j; i++) {
+        if (state.getCanvasState(_queue, i) == HIDDEN) break;
+        _take(state, 2);
+    }
+}
+
+void QueueView::refresh(const GameStateController &state) {
+    advance(state);
+    // Canvases the state has dropped were told they finished when they did,
+    // and are only walking off the screen now.
+    uint first = max(_front, state.firstCanvas(_queue));
+    for (uint i = first; i < end(); i++) {
+        _window[i - _front]->setState(state.getCanvasState(_queue, i));
+    }
+}
+
+void QueueView::update() {
+    for (auto &canvas : _window) canvas->update();
+}
@@ -0,0 +1,118 @@
+#ifndef PANICPAINTER_PPQUEUEVIEW_H
+#define PANICPAINTER_PPQUEUEVIEW_H
+
+#include <deque>
+#include "utils/PPHeader.h"
+#include "controllers/PPGameStateController.h"
+#include "PPCanvas.h"
+
+/**
+ * Canvas pool keeps the canvases that are not showing anything. It is shared
+ * by every queue of a level, so a canvas that leaves one lane can come back
+ * in another.
+ * @author Dragonglass Studios
+ */
+class CanvasPool {
+private:
+    /** Asset manager. */
+    asset_t _assets;
+
+    /** The bound of every canvas. */
+    Rect _bound;
+
+    /** Canvases ready to be reused. */
+    vec<ptr<Canvas>> _free;
+
+public:
+    /** Constructor. */
+    CanvasPool(const asset_t &assets, const Rect &bound) :
+        _assets(assets), _bound(bound) {}
+
+    /** Allocate a pool for canvases with a particular bound. */
+    static ptr<CanvasPool> alloc(const asset_t &assets, const Rect &bound) {
+        return make_shared<CanvasPool>(assets, bound);
+    }
+
+    /**
+     * Get a canvas for the given canvas of the level, reusing a free one if
+     * possible. See Canvas::alloc() for arguments.
+     */
+    ptr<Canvas> obtain(uint queueInd, uint canvasInd, uint numOfQueues,
+                       const GameStateController &state, uint rowNum);
+
+    /** Give back a canvas that is no longer showing anything. */
+    void release(const ptr<Canvas> &canvas);
+
+    /** Get the number of canvases ready to be reused. */
+    size_t numFree() const { return _free.size(); }
+};
+
+/**
+ * Queue view shows one queue of canvases. Only the canvases that can be seen
+ * have a scene node: the active and standby ones, plus any that are still
+ * walking off the screen. The queue is only ever read by index from the
+ * front of this window onwards, so the number of nodes does not depend on
+ * how long the queue is.
+ * @author Dragonglass Studios
+ */
+class QueueView : public SceneNode {
+private:
+    /** Index of this queue. */
+    uint _queue;
+
+    /** Total number of queues. */
+    uint _numQueues;
+
+    /** Where canvases come from and go back to. */
+    ptr<CanvasPool> _pool;
+
+    /** Index of the first canvas in the window. */
+    uint _front;
+
+    /** Canvases in the window. The first one is canvas _front. */
+    deque<ptr<Canvas>> _window;
+
+    /** Take a canvas from the pool and add it to the back of the window. */
+    void _take(const GameStateController &state, uint rowNum);
+
+    /** Set up. Canvases already in view are placed without animation. */
+    void _setup(uint queue, uint numQueues, const ptr<CanvasPool> &pool,
+                const GameStateController &state);
+
+public:
+    /** Allocate a queue view. See _setup() for arguments. */
+    static ptr<QueueView> alloc(uint queue, uint numQueues,
+                                const ptr<CanvasPool> &pool,
+                                const GameStateController &state);
+
+    /**
+     * Release canvases that have left the screen and take canvases for the
+     * ones that came into view. Call this once per frame, before updating
+     * the canvases.
+     */
+    void advance(const GameStateController &state);
+
+    /**
+     * Show the current state of every canvas in the window. Call this when
+     * the state of a canvas of this queue changes.
+     */
+    void refresh(const GameStateController &state);
+
+    /** Update the animation of every canvas in the window. */
+    void update();
+
+    /** Get the index of the first canvas in the window. */
+    uint front() const { return _front; }
+
+    /** Get the index after the last canvas in the window. */
+    uint end() const { return _front + (uint) _window.size(); }
+
+    /** Get a canvas in the window. */
+    const ptr<Canvas> &get(uint canvasInd) const {
+        CUAssertLog(canvasInd >= _front && canvasInd < end(),
+                    "Canvas %d is not in view.", canvasInd);
+        return _window[canvasInd - _front];
+    }
+};
+
+#endif //PANICPAINTER_PPQUEUEVIEW_H
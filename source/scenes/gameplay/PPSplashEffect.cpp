@@ -1,67 +1,126 @@
 #include "PPSplashEffect.h"
 
+/** Width of a drag brush, relative to the height of the node. */
+#define BRUSH_SIZE 0.12f
+/** Distance between stamps of a stroke, relative to the brush width. */
+#define BRUSH_SPACING 0.25f
+
 ptr<SplashEffect>
 SplashEffect::alloc(const asset_t &assets, const Rect &bounds, float scale) {
-    auto n = make_shared<SplashEffect>(assets, scale);
+    auto n = allocate_shared<SplashEffect>(SlabAllocator<SplashEffect>(), assets, scale);
     if (!n->initWithBounds(bounds)) return nullptr;
+
+    Size size = n->getContentSize();
+    n->_target = RenderTarget::alloc((int) (size.width * scale),
+                                     (int) (size.height * scale));
+    if (n->_target == nullptr) return nullptr;
+    n->_target->setClearColor(Color4::CLEAR);
+    n->_batch = SpriteBatch::alloc();
+    n->_matrix = OrthographicCamera::alloc(size)->getCombined();
+    n->_matrix.scale(1, -1, 1);
+    for (uint i = 0; i < NUM_BRUSHES; i++) {
+        n->_brushes[i] = assets->get<Texture>(
+            "canvas-splat-" + to_string(i + 1));
+    }
+    n->clear();
     return n;
 }
 
 void SplashEffect::update(float timestep, Color4 currentColor, Vec2 point) {
-    // Decrease opacity of all points by a bit.
-    for (auto &i : _queue) {
-        i.color.w -= (timestep / FADE_DURATION);
-        if (i.color.w < 0) i.color.w = 0;
-    }
-
-    if (currentColor == Color4::CLEAR) {
-        for (auto& i : _queue) {
-            i.point = Vec2::ZERO;
-            i.color = Vec4(currentColor);
-        }
+    if (currentColor == Color4::CLEAR || point.equals(Vec2::ZERO)) {
+        _last = Vec2::ZERO;
         SoundController::getInstance()->stopSfx("drag");
-    }
-    // Reset ticker if no input.
-    else if (point.equals(Vec2::ZERO)) {
-        _ticker = 0;
-        SoundController::getInstance()->stopSfx("drag");
-    }
-    else {
+    } else {
         SoundController::getInstance()->playSfx("drag", true);
-        _ticker++;
-        if (_ticker >= SAMPLE_RATE) {
-            _ticker = 0;
-            // Time to sample!
-            // First push everything in the point array back. The last one is
-            // discarded.
-            for (uint i = QUEUE_MAX_SIZE - 1; i >= 1; i--)
-                _queue[i] = _queue[i - 1];
-            // Update the point and color.
-            _queue[0].point = point;
-            _queue[0].color = Vec4(currentColor);
+        point = worldToNodeCoords(point);
+        if (_last.equals(Vec2::ZERO)) {
+            // Start of a stroke, or a tap.
+            _last = point;
+            _stroke(point, point, currentColor);
+        } else {
+            _stroke(_last, point, currentColor);
         }
     }
+
+    if (!_stamps.empty()) {
+        _life = FADE_DURATION;
+    } else if (_life <= 0) {
+        // Nothing left to fade.
+        return;
+    } else if ((_life -= timestep) <= 0) {
+        // Wipe what rounding left behind.
+        clear();
+        return;
+    }
+    _paint(timestep);
+}
+
+void SplashEffect::splat(Vec2 center, float size, uint brush, Color4 color) {
+    _stamps.push_back({_brushes[brush % NUM_BRUSHES],
+                       worldToNodeCoords(center), size,
+                       Random::getInstance()->getFloat(2 * M_PI), color});
 }
 
 void SplashEffect::clear() {
-    _ticker = 0;
-    for (auto &i : _queue) {
-        i.point = Vec2::ZERO;
-        i.color = Color4(0, 0, 0, 0);
+    _stamps.clear();
+    _last = Vec2::ZERO;
+    _fade = 0;
+    _life = 0;
+    // Beginning a render target clears it.
+    _target->begin();
+    _target->end();
+    markDirty();
+}
+
+void SplashEffect::_stroke(Vec2 from, Vec2 to, Color4 color) {
+    float size = getContentHeight() * BRUSH_SIZE;
+    float step = size * BRUSH_SPACING;
+    float dist = from.distance(to);
+    // Only whole steps are stamped; the rest waits for the next frame.
+    uint n = dist == 0 ? 1 : (uint) (dist / step);
+    for (uint i = 1; i <= n; i++) {
+        Vec2 p = dist == 0 ? to : from + (to - from) * (i * step / dist);
+        _stamps.push_back({_brushes[Random::getInstance()->getInt(
+                               NUM_BRUSHES - 1)], p, size,
+                           Random::getInstance()->getFloat(2 * M_PI), color});
+        _last = p;
+    }
+}
+
+void SplashEffect::_paint(float timestep) {
+    // The target holds 8 bits of alpha, so fade by whole steps of that.
+    _fade += timestep / FADE_DURATION;
+    float fade = floorf(_fade * 255) / 255;
+    _fade -= fade;
+
+    _target->resume();
+    _batch->begin(_matrix);
+    if (fade > 0) {
+        // Take the same alpha off every pixel, leaving the color as is.
+        _batch->setBlendEquation(GL_FUNC_REVERSE_SUBTRACT);
+        _batch->setBlendFunc(GL_ONE, GL_ONE);
+        _batch->setTexture(nullptr);
+        _batch->setColor(Color4f(0, 0, 0, fade));
+        _batch->fill(Rect(Vec2::ZERO, getContentSize()));
+        _batch->setBlendEquation(GL_FUNC_ADD);
+        _batch->setBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
     }
+    for (auto &stamp : _stamps) {
+        float scale = stamp.size / stamp.brush->getWidth();
+        _batch->draw(stamp.brush, stamp.color,
+                     Vec2(stamp.brush->getSize()) / 2, Vec2(scale, scale),
+                     stamp.angle, stamp.center);
+    }
+    _batch->end();
+    _target->end();
+    _stamps.clear();
+    // The scene graph cannot see the target change.
+    markDirty();
 }
 
 void SplashEffect::draw(const std::shared_ptr<SpriteBatch> &batch,
                         const Mat4 &transform, Color4 tint) {
-    batch->setViewport(Vec2(Application::get()->getDisplaySize()));
-    batch->setSplats(
-        _queue[0].point,
-        _queue[1].point,
-        _queue[2].point,
-        _queue[3].point,
-        _queue[0].color,
-        _queue[1].color,
-        _queue[2].color,
-        _queue[3].color
-    );
-}
\ No newline at end of file
+    if (_life <= 0) return;
+    batch->draw(_target->getTexture(), tint,
+                Rect(Vec2::ZERO, getContentSize()), Vec2::ZERO, transform);
+}
@@ -5,46 +5,95 @@
 #include "utils/PPHeader.h"
 #include "controllers/PPInputController.h"
 #include "controllers/PPSoundController.h"
-#include "controllers/PPGameStateController.h"
-#include "PPCanvas.h"
 
-#define QUEUE_MAX_SIZE 4
-#define SAMPLE_RATE 4
+/** Number of brush textures, canvas-splat-1 and so on. */
+#define NUM_BRUSHES 4
+/** Seconds for paint at full opacity to fade out. */
 #define FADE_DURATION 1
 
+/**
+ * Splash effect is the paint left behind by dragging and by splats on the
+ * canvases. Paint is stamped into a render target that keeps it from frame
+ * to frame, and the whole target fades a bit every frame. Each frame only
+ * stamps what is new, so strokes can be as long as they want without
+ * drawing more.
+ * @author Dragonglass Studios
+ */
 class SplashEffect : public SceneNode {
 protected:
-    //Likely not useful now, but may be necessary when getting actual paint textures later on
-    /*Additionally, we likely do not need InputController and can do this instead using
-    GameState/actionController. Including it just in case we don't want to route through GameState*/
+    /** A brush stamp waiting to be painted into the target. */
+    struct Stamp {
+        ptr<Texture> brush;
+        Vec2 center;
+        float size;
+        float angle;
+        Color4 color;
+    };
+
     const asset_t &_assets;
 
-    struct {
-        Vec2 point;
-        Vec4 color;
-    } _queue[QUEUE_MAX_SIZE];
+    /** The paint so far, in the coordinates of this node. */
+    ptr<RenderTarget> _target;
+
+    /** Batch for painting into the target, as the scene batch is in use. */
+    ptr<SpriteBatch> _batch;
+
+    /** Maps this node onto the target, flipped for the texture write. */
+    Mat4 _matrix;
+
+    /** Brush textures. */
+    ptr<Texture> _brushes[NUM_BRUSHES];
+
+    /** Stamps since the last paint. */
+    vec<Stamp> _stamps;
+
+    /** Where the stroke was last frame, or zero if not dragging. */
+    Vec2 _last;
 
-    uint _ticker;
+    /** Fade not applied yet, as it only goes by steps of 1/255. */
+    float _fade;
 
+    /** Seconds until all paint in the target has faded. */
+    float _life;
+
+    /** Resolution of the target relative to the node. */
     float _scale;
 
+    /** Stamp a line of brushes from one point to another. */
+    void _stroke(Vec2 from, Vec2 to, Color4 color);
+
+    /** Fade the target and paint the stamps into it. */
+    void _paint(float timestep);
+
 public:
     explicit SplashEffect(const asset_t &assets, float scale) :
-        _assets(assets), _scale(scale) {
-        for (auto &i : _queue) {
-            i.point = Vec2::ZERO;
-            i.color = Color4(0, 0, 0, 0);
-        }
-    }
-
-    /** Allocate canvas block with a particular length on the side. This can also be a Rect bounds if easier */
+        _assets(assets), _fade(0), _life(0), _scale(scale) {}
+
+    /**
+     * Allocate splash effect covering the given bounds.
+     * @param scale The resolution of the paint relative to the bounds.
+     */
     static ptr<SplashEffect> alloc(
         const asset_t &assets,
         const Rect &bounds,
         float scale);
 
+    /**
+     * Update the stroke and the paint.
+     * @param currentColor The selected color, or clear to stop painting.
+     * @param point The point being dragged, or zero if not dragging.
+     */
     void update(float timestep, Color4 currentColor, Vec2 point);
 
+    /**
+     * Add a splat, painted with the next update().
+     * @param center The center in world coordinates.
+     * @param size The width of the splat in world coordinates.
+     * @param brush Which brush to use, from 0 to NUM_BRUSHES - 1.
+     */
+    void splat(Vec2 center, float size, uint brush, Color4 color);
+
+    /** Remove all paint. */
     void clear();
 
     void draw(const std::shared_ptr<SpriteBatch> &batch, const Mat4 &transform,
@@ -52,4 +101,4 @@ public:
 
 };
 
-#endif /* PP_SPLASH_EFFECT_H */
\ No newline at end of file
+#endif /* PP_SPLASH_EFFECT_H */
@@ -13,6 +13,8 @@ bool LevelSelectScene::init(const asset_t &assets) {
         return false;
     }
     _assets = assets;
+    // Load the layout once. Every world reuses it and only restyles it.
+    _assets->loadDirectory("scenes/levelselect.json");
 
     return true;
 }
@@ -22,8 +24,22 @@ string LevelSelectScene::getLevel() {
     return _worldName + spacer + _levelNum;
 }
 
+string LevelSelectScene::getLikelyLevel() const {
+    string spacer = "-";
+    for (uint i = 1; i <= 5; i++) {
+        string level = _worldName + spacer + to_string(i);
+        if (_assets->get<Level>(level) == nullptr) break;
+        if (!SaveController::getInstance()->isCleared(level)) return level;
+    }
+    return _worldName + spacer + "1";
+}
+
 void LevelSelectScene::dispose() {
     if (_scene != nullptr) deactivateUI(_scene);
+    if (!_group.empty()) {
+        AssetGroupController::getInstance().release(_group);
+        _group.clear();
+    }
     Scene2::dispose();
 }
 
@@ -121,7 +137,7 @@ void LevelSelectScene::activateUI(
             }
 
             // deactivate button if no level associated
-            if (_assets->get<JsonValue>(_worldName + spacer + button->getName().c_str()) == NULL) {
+            if (_assets->get<Level>(_worldName + spacer + button->getName().c_str()) == NULL) {
                 // Hides & deactivates buttons that don't have levels associated
                 button->setVisible(false);
                 button->deactivate();
@@ -154,6 +170,16 @@ void LevelSelectScene::deactivateUI(
     }
 }
 
+bool LevelSelectScene::prefetchWorld(const string &worldName) {
+    auto &groups = AssetGroupController::getInstance();
+    if (_group != worldName) {
+        groups.acquire(worldName);
+        if (!_group.empty()) groups.release(_group);
+        _group = worldName;
+    }
+    return groups.isLoaded(worldName);
+}
+
 void LevelSelectScene::loadWorld(const char* worldName) {
     _worldName = worldName;
 
@@ -165,7 +191,6 @@ void LevelSelectScene::loadWorld(const char* worldName) {
 
     // Get scene
     string suffix = "selectscene";
-    _assets->loadDirectory("scenes/levelselect.json");
     _scene = _assets->get<scene2::SceneNode>("levelselectscene");
     _scene->setContentSize(_sceneSize);
     _scene->setPosition(_safe.origin);
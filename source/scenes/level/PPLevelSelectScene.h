@@ -5,6 +5,8 @@
 #include "utils/PPHeader.h"
 #include "controllers/PPInputController.h"
 #include "controllers/PPSoundController.h"
+#include "controllers/PPAssetGroupController.h"
+#include "models/PPLevel.h"
 
 enum LevelRequest {
     LEVEL,    // standard case, stay on level select
@@ -26,6 +28,9 @@ private:
 
     string _worldName;
 
+    /** The asset group held for the world, which may be ahead of it. */
+    string _group;
+
     string _levelNum;
 
     /** Safe Space */
@@ -60,6 +65,19 @@ public:
 
     string getLevel();
 
+    /**
+     * Get the level the player is most likely to pick next in the loaded
+     * world: the first one not yet cleared, or the first level if all are.
+     */
+    string getLikelyLevel() const;
+
+    /**
+     * Start loading the assets of a world, and let go of the ones held for
+     * the world before. Call this until it returns true before loadWorld().
+     * @return Whether the assets of the world are loaded.
+     */
+    bool prefetchWorld(const string &worldName);
+
     void loadWorld(const char* levelName);
 
     void resetState() {
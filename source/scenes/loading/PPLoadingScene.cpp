@@ -2,8 +2,10 @@
 
 // This is the ideal size of the logo.
 #define SCENE_SIZE 1024
+// The share of the progress bar for loading assets. The rest is for jobs.
+#define ASSET_SHARE .8f
 
-bool LoadingScene::init(const asset_t &assets) {
+bool LoadingScene::init(const asset_t &assets, const ptr<JobQueue> &jobs) {
     Size screenSize = Application::get()->getDisplaySize();
 
     // Lock the scene to a reasonable resolution
@@ -18,6 +20,7 @@ bool LoadingScene::init(const asset_t &assets) {
     }
 
     _assets = assets;
+    _jobs = jobs;
     _assets->loadDirectory("scenes/loading.json");
     _assets->loadDirectory("config/assets_loading.json");
 
@@ -57,14 +60,18 @@ bool LoadingScene::init(const asset_t &assets) {
 void LoadingScene::dispose() {
     _bar = nullptr;
     _assets = nullptr;
+    _jobs = nullptr;
     _progress = 0.0f;
     Scene2::dispose();
 }
 
 void LoadingScene::update(float progress) {
     if (_progress < 1) {
-        _progress = _assets->progress();
-        if (_progress >= 1) {
+        // Jobs are only added once every asset is loaded.
+        float assets = _assets->progress();
+        _progress = assets < 1 ? assets * ASSET_SHARE :
+                    ASSET_SHARE + _jobs->progress() * (1 - ASSET_SHARE);
+        if (assets >= 1 && _jobs->isDone()) {
             _progress = 1.0f;
             _bar->setVisible(false);
             this->_active = false;
@@ -4,6 +4,7 @@
 #include "utils/PPHeader.h"
 #include "controllers/PPSoundController.h"
 #include "utils/PPAnimation.h"
+#include "utils/PPJobQueue.h"
 
 /**
  * Loading scene.
@@ -13,6 +14,9 @@ private:
     /** Asset manager. */
     asset_t _assets;
 
+    /** Jobs that build the other scenes once the assets are loaded. */
+    ptr<JobQueue> _jobs;
+
     /** Progress bar. */
     ptr<ProgressBar> _bar;
 
@@ -26,7 +30,11 @@ public:
 
     void dispose() override;
 
-    bool init(const asset_t &assets);
+    /**
+     * Initialize the scene. It stays active until every asset is loaded
+     * and every job is done, and the progress bar covers both.
+     */
+    bool init(const asset_t &assets, const ptr<JobQueue> &jobs);
 
     void update(float timestep) override;
 
@@ -111,6 +111,25 @@ MenuScene::deactivateUI(const std::shared_ptr<cugl::scene2::SceneNode> &scene) {
     }
 }
 
+void MenuScene::tintUI(const std::shared_ptr<cugl::scene2::SceneNode> &scene) {
+    std::shared_ptr<scene2::Button> button = std::dynamic_pointer_cast<scene2::Button>(
+        scene);
+    if (button != nullptr) {
+        button->setColor(_waiting ? Color4f(1, 1, 1, .5) : Color4f::WHITE);
+    } else {
+        // Go deeper
+        for (Uint32 ii = 0; ii < scene->getChildCount(); ii++) {
+            tintUI(scene->getChild(ii));
+        }
+    }
+}
+
+void MenuScene::setWaiting(bool waiting) {
+    if (_waiting == waiting) return;
+    _waiting = waiting;
+    tintUI(_scene);
+}
+
 void MenuScene::resetState() {
     _state = HOME;
 }
@@ -29,6 +29,12 @@ private:
     ptr<Timer> _hackTimer;
     bool _hacking = false;
 
+    /** Whether the scenes behind the buttons are still being built. */
+    bool _waiting = false;
+
+    /** Tint the buttons to show whether they are waiting. */
+    void tintUI(const std::shared_ptr<cugl::scene2::SceneNode> &scene);
+
     void activateUI(const std::shared_ptr<cugl::scene2::SceneNode> &scene);
 
     void deactivateUI(const std::shared_ptr<cugl::scene2::SceneNode> &scene);
@@ -53,6 +59,13 @@ public:
     void deactivate() { deactivateUI(_scene); }
 
     MenuRequest getState() const;
+
+    /**
+     * Show the buttons as not ready while the scenes they lead to are
+     * still being built. They still take presses, and getState() reports
+     * them, so the app can go on once it is ready.
+     */
+    void setWaiting(bool waiting);
 };
 
 #endif //PANICPAINTER_PPPAUSESCENE_H
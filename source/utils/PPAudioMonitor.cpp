@@ -0,0 +1,81 @@
+#include "PPAudioMonitor.h"
+
+/** The graph is scaled so that the deadline sits at this fraction of height. */
+#define DEADLINE_HEIGHT 0.5f
+
+ptr<AudioMonitor> AudioMonitor::alloc(const asset_t &assets,
+                                      const Rect &bounds) {
+    auto result = make_shared<AudioMonitor>();
+    if (result->initWithBounds(bounds))
+        result->_setup(assets);
+    else
+        return nullptr;
+    return result;
+}
+
+void AudioMonitor::_setup(const asset_t &assets) {
+    auto bg = PolygonNode::alloc(Rect(Vec2::ZERO, getContentSize()));
+    bg->setAnchor(Vec2::ANCHOR_BOTTOM_LEFT);
+    bg->setPosition(Vec2::ZERO);
+    bg->setColor(Color4(0, 0, 0, 160));
+    addChild(bg);
+
+    float barWidth = getWidth() / AUDIO_MONITOR_SAMPLES;
+    for (uint i = 0; i < AUDIO_MONITOR_SAMPLES; i++) {
+        // Bars are unit height and scaled vertically on update.
+        _bars[i] = PolygonNode::alloc(Rect(0, 0, barWidth, 1));
+        _bars[i]->setAnchor(Vec2::ANCHOR_BOTTOM_LEFT);
+        _bars[i]->setPosition(i * barWidth, 0);
+        _bars[i]->setScale(1, 0);
+        addChild(_bars[i]);
+    }
+
+    _deadlineLine = PolygonNode::alloc(Rect(0, 0, getWidth(), 2));
+    _deadlineLine->setAnchor(Vec2::ANCHOR_BOTTOM_LEFT);
+    _deadlineLine->setPosition(0, getHeight() * DEADLINE_HEIGHT);
+    _deadlineLine->setColor(Color4::RED);
+    addChild(_deadlineLine);
+
+    _summary = Label::alloc(Size(getWidth(), getHeight() * .25f),
+                            assets->get<Font>("roboto"));
+    _summary->setAnchor(Vec2::ANCHOR_TOP_LEFT);
+    _summary->setPosition(0, getHeight());
+    _summary->setScale(.5f);
+    _summary->setForeground(Color4::WHITE);
+    addChild(_summary);
+}
+
+void AudioMonitor::update() {
+    auto *engine = AudioEngine::get();
+    if (engine == nullptr) return;
+    auto stats = engine->getStatistics();
+    if (stats.deadline == 0) return;
+
+    // Shift the ring by writing the newest sample into the next slot, then
+    // reposition so the newest bar is always at the right edge.
+    float ratio = (float) stats.last / stats.deadline;
+    float height = min(ratio * DEADLINE_HEIGHT, 1.0f) * getHeight();
+    bool missed = stats.underruns > _lastUnderruns;
+    _lastUnderruns = stats.underruns;
+
+    auto &bar = _bars[_next];
+    bar->setScale(1, height);
+    bar->setColor(missed ? Color4::RED :
+                  ratio > .5f ? Color4::YELLOW : Color4::GREEN);
+    _next = (_next + 1) % AUDIO_MONITOR_SAMPLES;
+
+    float barWidth = getWidth() / AUDIO_MONITOR_SAMPLES;
+    for (uint i = 0; i < AUDIO_MONITOR_SAMPLES; i++) {
+        uint ind = (_next + i) % AUDIO_MONITOR_SAMPLES;
+        _bars[ind]->setPositionX(i * barWidth);
+    }
+
+    _summary->setText(
+        "deadline " + to_string(stats.deadline) +
+        "us  p50 " + to_string(stats.median) +
+        "  p95 " + to_string(stats.p95) +
+        "  p99 " + to_string(stats.p99) +
+        "  worst " + to_string(stats.worst) +
+        "  underruns " + to_string(stats.underruns) +
+        "  voices " + to_string(stats.voices));
+}
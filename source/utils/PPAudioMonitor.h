@@ -0,0 +1,43 @@
+#ifndef PANICPAINTER_PPAUDIOMONITOR_H
+#define PANICPAINTER_PPAUDIOMONITOR_H
+
+#include "PPHeader.h"
+
+/** The number of audio buffers shown in the graph. */
+#define AUDIO_MONITOR_SAMPLES 60
+
+/**
+ * AudioMonitor is a debug overlay that graphs how long the audio thread takes
+ * to fill each buffer relative to its deadline. It is only shown when
+ * AUDIO_DEBUG is defined in PPHeader.h.
+ * @author Dragonglass Studios
+ */
+class AudioMonitor : public SceneNode {
+private:
+    /** One bar per sampled frame. Oldest is at the front. */
+    ptr<PolygonNode> _bars[AUDIO_MONITOR_SAMPLES];
+
+    /** The line that marks the buffer deadline. */
+    ptr<PolygonNode> _deadlineLine;
+
+    /** Summary text (percentiles, underruns, voices). */
+    ptr<Label> _summary;
+
+    /** Index of the next bar to write in the ring. */
+    uint _next;
+
+    /** Last underrun count, so new underruns can be highlighted. */
+    Uint64 _lastUnderruns;
+
+    void _setup(const asset_t &assets);
+
+public:
+    AudioMonitor() : _next(0), _lastUnderruns(0) {}
+
+    static ptr<AudioMonitor> alloc(const asset_t &assets, const Rect &bounds);
+
+    /** Sample the audio engine statistics and refresh the graph. */
+    void update();
+};
+
+#endif //PANICPAINTER_PPAUDIOMONITOR_H
@@ -0,0 +1,212 @@
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include "PPBenchmark.h"
+#include "models/PPLevel.h"
+#include "controllers/PPGameStateController.h"
+#include "scenes/gameplay/PPCanvasBlock.h"
+#include "utils/PPFrameArena.h"
+
+/** Frames between reports of the allocations per frame. */
+#define ALLOC_REPORT_FRAMES 60
+
+/** Bytes allocated with operator new so far. */
+static std::atomic<size_t> allocated(0);
+/** Calls to operator new so far. */
+static std::atomic<size_t> allocCount(0);
+
+#if defined(BENCHMARK) || defined(ALLOC_DEBUG)
+// Count every allocation, so a benchmark can read how much a piece of code
+// allocates. Arrays and the nothrow forms all go through this one.
+void *operator new(size_t size) {
+    allocated += size;
+    allocCount++;
+    void *p = malloc(size == 0 ? 1 : size);
+    if (p == nullptr) throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void *p) noexcept {
+    free(p);
+}
+#endif
+
+size_t Benchmark::allocatedBytes() {
+    return allocated;
+}
+
+size_t Benchmark::allocations() {
+    return allocCount;
+}
+
+void Benchmark::countFrame() {
+    static size_t lastCount = allocCount, lastBytes = allocated;
+    static size_t frames = 0, count = 0, bytes = 0, most = 0;
+    size_t now = allocCount, nowBytes = allocated;
+    count += now - lastCount;
+    bytes += nowBytes - lastBytes;
+    most = max(most, now - lastCount);
+    lastCount = now;
+    lastBytes = nowBytes;
+    if (++frames < ALLOC_REPORT_FRAMES) return;
+
+    CULog("Allocations per frame: %.1f on average, %zu at most, "
+          "%zu bytes on average. Frame arena: %zu bytes.",
+          (float) count / frames, most, bytes / frames,
+          FrameArena::capacity());
+    frames = count = bytes = most = 0;
+}
+
+/** Read the level files from the "levels" category of an asset directory. */
+static vec<string> levelFiles(const string &directory) {
+    vec<string> files;
+    auto reader = JsonReader::allocWithAsset(directory);
+    json_t levels = reader == nullptr ? nullptr : reader->readJson();
+    levels = levels == nullptr ? nullptr : levels->get("levels");
+    if (levels == nullptr) {
+        CULogError("No levels in %s.", directory.c_str());
+        return files;
+    }
+    for (size_t i = 0; i < levels->size(); i++) {
+        files.push_back(levels->get((int) i)->asString());
+    }
+    return files;
+}
+
+void Benchmark::parseLevels(const string &directory, uint iterations) {
+    vec<string> files = levelFiles(directory);
+    if (files.empty()) return;
+
+    Uint64 treeTotal = 0, streamTotal = 0;
+    size_t bytes = 0;
+    for (const string &level : files) {
+        // Shipped levels are compiled, so parse their JSON sources.
+        string file = level.substr(0, level.find_last_of('.')) + ".json";
+        auto text = TextReader::allocWithAsset(file)->readAll();
+        bytes += text.size();
+
+        // The old path: build the tree, then walk it the way the level
+        // loader did, copying every canvas out with asIntArray.
+        Timestamp start;
+        for (uint k = 0; k < iterations; k++) {
+            json_t json = JsonValue::allocWithJson(text);
+            size_t count = 0;
+            for (const auto &queue : json->get("queues")->asArray())
+                for (const auto &canvas : queue->asArray())
+                    count += canvas->asIntArray().size();
+            CUAssertLog(count > 0, "Empty level %s.", file.c_str());
+        }
+        Timestamp middle;
+        for (uint k = 0; k < iterations; k++) {
+            Level level;
+            bool ok = level.parse(text);
+            CUAssertLog(ok, "Invalid level %s.", file.c_str());
+        }
+        Timestamp end;
+
+        Uint64 tree = Timestamp::ellapsedMicros(start, middle);
+        Uint64 stream = Timestamp::ellapsedMicros(middle, end);
+        treeTotal += tree;
+        streamTotal += stream;
+        CULog("%-32s tree %6.1fus  stream %6.1fus", file.c_str(),
+              tree / (double) iterations, stream / (double) iterations);
+    }
+    CULog("%zu levels, %zu bytes: tree %.1fus  stream %.1fus  (%.1fx)",
+          files.size(), bytes, treeTotal / (double) iterations,
+          streamTotal / (double) iterations,
+          streamTotal ? treeTotal / (double) streamTotal : 0.0);
+}
+
+void Benchmark::loadLevels(const string &directory, const asset_t &assets) {
+    vec<string> files = levelFiles(directory);
+    size_t stateTotal = 0, copyTotal = 0, viewTotal = 0, oldTotal = 0;
+    for (const string &file : files) {
+        auto level = Level::alloc(file);
+        if (level == nullptr) continue;
+
+        GameStateController state;
+        size_t start = allocatedBytes();
+        state.loadLevel(level);
+        size_t loaded = allocatedBytes();
+        {
+            // What CanvasBlock and ColorStrip each used to hold.
+            GameStateController copy = state;
+        }
+        size_t copied = allocatedBytes();
+        {
+            auto block = CanvasBlock::alloc(assets, 100, state.getContext(),
+                                            3, false, false);
+        }
+        size_t viewed = allocatedBytes();
+
+        size_t canvases = state.numCanvasesInLevel();
+        size_t stateBytes = loaded - start;
+        size_t copyBytes = copied - loaded;
+        size_t viewBytes = viewed - copied;
+        // Every canvas used to have a block and a strip, each with a copy.
+        size_t oldBytes = canvases * (viewBytes + 2 * copyBytes);
+        stateTotal += stateBytes;
+        copyTotal += copyBytes;
+        viewTotal += viewBytes;
+        oldTotal += oldBytes;
+        CULog("%-32s %4zu canvases  state %7zuB  copy %7zuB  view %6zuB"
+              "  old views %9zuB", file.c_str(), canvases, stateBytes,
+              copyBytes, viewBytes, oldBytes);
+    }
+    CULog("%zu levels: state %zuB  copy %zuB  view %zuB  old views %zuB",
+          files.size(), stateTotal, copyTotal, viewTotal, oldTotal);
+}
+
+/** Items below which a range of the thread pool workload is not split. */
+#define POOL_GRAIN 16
+
+/** A small piece of work that the compiler cannot skip. */
+static float poolWork(uint i) {
+    float x = (float) i;
+    for (uint k = 0; k < 2000; k++) x = sinf(x) + 1.0f;
+    return x;
+}
+
+/**
+ * Run the workload on items [first, last), splitting it in half into a new
+ * task until it is small. Each task waits for the half it added.
+ */
+static void poolRange(ThreadPool &pool, uint first, uint last,
+                      std::atomic<float> &sum) {
+    if (last - first <= POOL_GRAIN) {
+        float total = 0;
+        for (uint i = first; i < last; i++) total += poolWork(i);
+        float old = sum.load();
+        while (!sum.compare_exchange_weak(old, old + total));
+        return;
+    }
+    uint middle = first + (last - first) / 2;
+    ThreadPool::Counter half;
+    pool.addTask([&pool, middle, last, &sum]() {
+        poolRange(pool, middle, last, sum);
+    }, half);
+    poolRange(pool, first, middle, sum);
+    pool.wait(half);
+}
+
+void Benchmark::threadPool(uint tasks) {
+    int cores = SDL_GetCPUCount();
+    Uint64 single = 0;
+    for (int threads = 1; threads <= cores; threads++) {
+        auto pool = ThreadPool::alloc(threads);
+        std::atomic<float> sum(0);
+        Timestamp start;
+        ThreadPool::Counter all;
+        pool->addTask([&]() { poolRange(*pool, 0, tasks * POOL_GRAIN, sum); },
+                      all);
+        // Do not help, so only the pool threads count.
+        while (!all.isDone()) SDL_Delay(0);
+        Timestamp end;
+        pool->dispose();
+
+        Uint64 micros = Timestamp::ellapsedMicros(start, end);
+        if (threads == 1) single = micros;
+        CULog("%2d threads %8.2fms  speed up %5.2fx  (sum %.0f)", threads,
+              micros / 1000.0f, (float) single / micros, sum.load());
+    }
+}
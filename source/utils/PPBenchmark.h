@@ -0,0 +1,58 @@
+#ifndef PANICPAINTER_PPBENCHMARK_H
+#define PANICPAINTER_PPBENCHMARK_H
+
+#include "PPHeader.h"
+
+/**
+ * Benchmark holds the performance measurements we run by hand. They are only
+ * run when BENCHMARK is defined in PPHeader.h, and report with CULog.
+ * @author Dragonglass Studios
+ */
+class Benchmark {
+public:
+    /**
+     * Parse every level in the "levels" category of the asset directory
+     * with both the JsonValue tree and the streaming Level parser, and log
+     * the average time of each.
+     * @param directory The asset directory file.
+     * @param iterations How many times each level is parsed.
+     */
+    static void parseLevels(const string &directory, uint iterations);
+
+    /**
+     * Load every level in the "levels" category of the asset directory into
+     * a GameStateController and log the memory it takes. For comparison, it
+     * also logs what a copy of the controller costs, which is what every
+     * canvas view used to hold, and what one canvas view costs now.
+     * @param directory The asset directory file.
+     * @param assets The loaded assets, for the canvas view textures.
+     */
+    static void loadLevels(const string &directory, const asset_t &assets);
+
+    /**
+     * Run a fork-join workload on thread pools of 1 up to as many threads as
+     * there are cores, and log the time and the speed up of each.
+     * @param tasks How many small tasks the workload is split into.
+     */
+    static void threadPool(uint tasks);
+
+    /**
+     * Get the number of bytes allocated with operator new so far. This is
+     * only counted when BENCHMARK or ALLOC_DEBUG is defined, and is 0
+     * otherwise.
+     */
+    static size_t allocatedBytes();
+
+    /** Get the number of calls to operator new so far, counted the same. */
+    static size_t allocations();
+
+    /**
+     * Count the allocations since the last call as one frame. Once a second
+     * worth of frames, log the average and the most allocations per frame,
+     * so the frame loop can be driven to none. Only called when ALLOC_DEBUG
+     * is defined.
+     */
+    static void countFrame();
+};
+
+#endif //PANICPAINTER_PPBENCHMARK_H
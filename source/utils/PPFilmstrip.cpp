@@ -0,0 +1,68 @@
+#include "PPFilmstrip.h"
+
+vec<Filmstrip::Playing> Filmstrip::_playing;
+
+Filmstrip::Playing *Filmstrip::_find(const AnimationNode *node) {
+    for (auto &playing : _playing) {
+        if (playing.key == node) return &playing;
+    }
+    return nullptr;
+}
+
+void Filmstrip::play(const ptr<AnimationNode> &node, const Clip &clip) {
+    CUAssertLog(clip.first <= clip.last && clip.last < node->getSize(),
+                "Invalid filmstrip clip %d to %d", clip.first, clip.last);
+    Playing *playing = _find(node.get());
+    if (playing == nullptr) {
+        _playing.push_back({});
+        playing = &_playing.back();
+    }
+    *playing = {node, node.get(), clip, 0, clip.first, false};
+    if (node->getTexture() != clip.texture) node->setTexture(clip.texture);
+    node->setFrame(clip.first);
+}
+
+void Filmstrip::stop(const ptr<AnimationNode> &node) {
+    Playing *playing = _find(node.get());
+    if (playing == nullptr) return;
+    *playing = _playing.back();
+    _playing.pop_back();
+}
+
+bool Filmstrip::isPlaying(const ptr<AnimationNode> &node) {
+    Playing *playing = _find(node.get());
+    return playing != nullptr && !playing->done;
+}
+
+void Filmstrip::updateGlobal(float timestep) {
+    for (size_t i = 0; i < _playing.size();) {
+        Playing &playing = _playing[i];
+        if (playing.node.expired()) {
+            // Nobody else has the node, so it is gone from the scene.
+            playing = _playing.back();
+            _playing.pop_back();
+            continue;
+        }
+        i++;
+        if (playing.done) continue;
+
+        const Clip &clip = playing.clip;
+        int span = clip.last - clip.first + 1;
+        playing.time += timestep;
+        int n = (int) (playing.time * clip.fps);
+        if (n >= span) {
+            if (clip.mode == LOOP) {
+                // Wrap the time too, so it does not lose precision.
+                playing.time = fmodf(playing.time, span / clip.fps);
+                n %= span;
+            } else {
+                playing.done = true;
+                n = span - 1;
+            }
+        }
+        if (clip.first + n != playing.frame) {
+            playing.frame = clip.first + n;
+            playing.node.lock()->setFrame(playing.frame);
+        }
+    }
+}
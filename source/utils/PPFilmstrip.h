@@ -0,0 +1,86 @@
+#ifndef PANICPAINTER_PPFILMSTRIP_H
+#define PANICPAINTER_PPFILMSTRIP_H
+
+#include "PPHeader.h"
+
+namespace utils {
+    /**
+     * Filmstrip plays sprite animations on animation nodes.
+     *
+     * A clip is a range of frames of a filmstrip texture played at some
+     * frames per second. All playing clips are advanced by real time in
+     * updateGlobal(), and a node is only touched when its frame changes, so
+     * animation speed does not depend on the frame rate.
+     *
+     * @author Dragonglass Studios
+     */
+    class Filmstrip {
+    public:
+        /** What a clip does once it reaches its last frame. */
+        enum Mode {
+            /** Start over from the first frame. */
+            LOOP,
+            /** Stay on the last frame and stop playing. */
+            ONCE
+        };
+
+        /** A clip of a filmstrip. */
+        struct Clip {
+            /** The filmstrip texture. */
+            ptr<Texture> texture;
+            /** The first frame. */
+            int first;
+            /** The last frame, inclusive. */
+            int last;
+            /** Frames per second. */
+            float fps;
+            Mode mode;
+        };
+
+    private:
+        /** A clip playing on a node. */
+        struct Playing {
+            /**
+             * The node. This is a weak pointer so the engine does not keep
+             * nodes that are out of scope.
+             */
+            weak_ptr<AnimationNode> node;
+            /** The node, only used to look it up. */
+            const AnimationNode *key;
+            Clip clip;
+            /** Time since the clip started. */
+            float time;
+            /** The frame the node is showing. */
+            int frame;
+            /** Whether a clip played once has reached its end. */
+            bool done;
+        };
+
+        /** Every clip playing globally. */
+        static vec<Playing> _playing;
+
+        /** Find what a node is playing, or null if nothing. */
+        static Playing *_find(const AnimationNode *node);
+
+    public:
+        /**
+         * Play a clip on a node from its first frame, replacing anything the
+         * node was playing. The texture is only set if it is different.
+         */
+        static void play(const ptr<AnimationNode> &node, const Clip &clip);
+
+        /** Stop playing on a node. The node keeps its current frame. */
+        static void stop(const ptr<AnimationNode> &node);
+
+        /**
+         * Whether a node is playing. A clip played once stops playing after
+         * its last frame has been shown for a frame's worth of time.
+         */
+        static bool isPlaying(const ptr<AnimationNode> &node);
+
+        /** Advance all clips globally. */
+        static void updateGlobal(float timestep);
+    };
+}
+
+#endif //PANICPAINTER_PPFILMSTRIP_H
@@ -0,0 +1,41 @@
+#include "PPFrameArena.h"
+
+/** Size of the first block, which is plenty for most frames. */
+#define FRAME_ARENA_BLOCK 16384
+
+vec<unique_ptr<char[]>> FrameArena::_blocks;
+size_t FrameArena::_size = 0;
+size_t FrameArena::_used = 0;
+size_t FrameArena::_capacity = 0;
+
+void FrameArena::_grow(size_t bytes) {
+    size_t size = max((size_t) FRAME_ARENA_BLOCK, max(_size * 2, bytes));
+    _blocks.emplace_back(new char[size]);
+    _size = size;
+    _used = 0;
+    _capacity += size;
+}
+
+void *FrameArena::allocate(size_t bytes, size_t align) {
+    if (_blocks.empty()) _grow(bytes);
+    uintptr_t base = (uintptr_t) _blocks.back().get();
+    uintptr_t p = (base + _used + align - 1) & ~(uintptr_t) (align - 1);
+    if (p + bytes > base + _size) {
+        // Room for the worst alignment, as the new block starts anywhere.
+        _grow(bytes + align);
+        base = (uintptr_t) _blocks.back().get();
+        p = (base + align - 1) & ~(uintptr_t) (align - 1);
+    }
+    _used = p + bytes - base;
+    return (void *) p;
+}
+
+void FrameArena::reset() {
+    if (_blocks.size() > 1) {
+        size_t capacity = _capacity;
+        _blocks.clear();
+        _size = _capacity = 0;
+        _grow(capacity);
+    }
+    _used = 0;
+}
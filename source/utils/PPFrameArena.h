@@ -0,0 +1,79 @@
+#ifndef PANICPAINTER_PPFRAMEARENA_H
+#define PANICPAINTER_PPFRAMEARENA_H
+
+#include <set>
+#include "PPHeader.h"
+
+namespace utils {
+    /**
+     * Frame arena hands out memory for temporaries that only live for one
+     * frame. Allocating bumps a pointer, freeing does nothing, and all of it
+     * is taken back at once by reset() at the start of the next frame. Once
+     * the arena has grown to what a frame needs, it never allocates again.
+     *
+     * It is for the main thread only, and nothing in it may outlive the
+     * frame. The draw thread must not use it.
+     *
+     * @author Dragonglass Studios
+     */
+    class FrameArena {
+        /** The blocks of memory, the last one being bumped. */
+        static vec<unique_ptr<char[]>> _blocks;
+
+        /** Size of the last block. */
+        static size_t _size;
+
+        /** Bytes of the last block handed out this frame. */
+        static size_t _used;
+
+        /** Bytes of all blocks. */
+        static size_t _capacity;
+
+        /** Add a block that fits at least the given bytes. */
+        static void _grow(size_t bytes);
+
+    public:
+        /** Get memory for this frame, aligned to a power of two. */
+        static void *allocate(size_t bytes, size_t align);
+
+        /**
+         * Take back everything handed out. If the frame needed more than one
+         * block, they are merged into one, so the next frame bumps through a
+         * single block.
+         */
+        static void reset();
+
+        /** Bytes the arena holds, whether handed out or not. */
+        static size_t capacity() { return _capacity; }
+    };
+
+    /** Allocator for containers of temporaries in the frame arena. */
+    template<typename T>
+    class FrameAllocator {
+    public:
+        typedef T value_type;
+
+        FrameAllocator() = default;
+
+        template<typename U>
+        FrameAllocator(const FrameAllocator<U> &) {}
+
+        T *allocate(size_t n) {
+            return (T *) FrameArena::allocate(n * sizeof(T), alignof(T));
+        }
+
+        /** Nothing to do, as the arena takes it all back at once. */
+        void deallocate(T *, size_t) {}
+
+        template<typename U>
+        bool operator==(const FrameAllocator<U> &) const { return true; }
+
+        template<typename U>
+        bool operator!=(const FrameAllocator<U> &) const { return false; }
+    };
+
+    template<typename T> using frame_vec = vector<T, FrameAllocator<T>>;
+    template<typename T> using frame_set = set<T, less<T>, FrameAllocator<T>>;
+}
+
+#endif //PANICPAINTER_PPFRAMEARENA_H
@@ -6,6 +6,10 @@
 #include "PPRandom.h"
 
 //#define VIEW_DEBUG
+//#define AUDIO_DEBUG
+//#define BENCHMARK
+//#define ALLOC_DEBUG
+//#define PIPELINED_DRAW
 
 namespace utils {};
 
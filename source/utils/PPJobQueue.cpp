@@ -0,0 +1,56 @@
+#include "PPJobQueue.h"
+
+void JobQueue::add(const function<bool()> &step, float weight) {
+    _jobs.push_back({step, weight});
+    _total += weight;
+    if (!_scheduled) {
+        _scheduled = true;
+        _callback = Application::get()->schedule([this]() { return _run(); });
+    }
+}
+
+void JobQueue::clear() {
+    if (_scheduled) Application::get()->unschedule(_callback);
+    _scheduled = false;
+    _jobs.clear();
+    _total = _done = 0;
+}
+
+bool JobQueue::_run() {
+    Timestamp start;
+    Uint32 callback = _callback;
+    size_t waiting = 0;
+    while (!_jobs.empty()) {
+        // A step may add jobs or clear the queue, so take it out first.
+        Job job = std::move(_jobs.front());
+        _jobs.pop_front();
+        _waiting = false;
+        bool done = job.step();
+        if (!_scheduled || _callback != callback) {
+            // The step cleared the queue, which dropped this job too.
+            break;
+        } else if (done) {
+            _done += job.weight;
+            waiting = 0;
+        } else if (_waiting) {
+            // Let the jobs behind it run, until every job is waiting.
+            _jobs.push_back(std::move(job));
+            if (++waiting >= _jobs.size()) break;
+        } else {
+            _jobs.push_front(std::move(job));
+            waiting = 0;
+        }
+        if (Timestamp::ellapsedMicros(start, Timestamp()) >= _budget * 1000)
+            break;
+    }
+    if (_callback != callback) {
+        // The queue was cleared and refilled under a new callback.
+        return false;
+    }
+    if (_jobs.empty()) {
+        // Returning false unschedules the callback.
+        _scheduled = false;
+        _total = _done = 0;
+    }
+    return _scheduled;
+}
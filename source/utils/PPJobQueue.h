@@ -0,0 +1,110 @@
+#ifndef PANICPAINTER_PPJOBQUEUE_H
+#define PANICPAINTER_PPJOBQUEUE_H
+
+#include <deque>
+#include "PPHeader.h"
+
+namespace utils {
+    /**
+     * Job queue spreads work on the main thread over several frames, so no
+     * frame takes too long.
+     *
+     * A job is a function that does one small step of work and returns
+     * whether it is finished. It is called again until it is. Jobs run in
+     * the order they are added, and each frame the queue stops once its
+     * budget is spent. A job that calls wait() goes to the back of the
+     * queue, and the queue stops early if every job is waiting. The queue
+     * is driven by Application::schedule(), so it runs before the update
+     * of every frame that has work to do.
+     *
+     * @author Dragonglass Studios
+     */
+    class JobQueue {
+    private:
+        /** A job and how much it counts towards progress. */
+        struct Job {
+            function<bool()> step;
+            float weight;
+        };
+
+        /** Jobs not finished yet. */
+        deque<Job> _jobs;
+
+        /** The time the queue may take each frame, in milliseconds. */
+        float _budget;
+
+        /** Total weight of the jobs added since the queue was last empty. */
+        float _total;
+
+        /** Weight of those jobs that are finished. */
+        float _done;
+
+        /** The scheduled callback, if the queue has work to do. */
+        Uint32 _callback;
+
+        /** Whether the callback is scheduled. */
+        bool _scheduled;
+
+        /** Whether the job running now has to wait for the next frame. */
+        bool _waiting;
+
+        /** Run jobs until the budget is spent. Returns whether any remain. */
+        bool _run();
+
+    public:
+        /** @deprecated Constructor. Use alloc() instead. */
+        explicit JobQueue(float budget) :
+            _budget(budget), _total(0), _done(0), _callback(0),
+            _scheduled(false), _waiting(false) {}
+
+        /** Destructor. Stops running the remaining jobs. */
+        ~JobQueue() { clear(); }
+
+        /**
+         * Get a new job queue.
+         * @param budget The time the queue may take each frame, in
+         * milliseconds. At least one step is run every frame regardless.
+         */
+        static ptr<JobQueue> alloc(float budget) {
+            return make_shared<JobQueue>(budget);
+        }
+
+        /**
+         * Add a job that is run until it returns true.
+         * @param step One step of the job. Returns whether the job is done.
+         * @param weight How much the job counts towards progress().
+         */
+        void add(const function<bool()> &step, float weight = 1);
+
+        /** Add a job that is done in a single step. */
+        void addOnce(const function<void()> &step, float weight = 1) {
+            add([=]() {
+                step();
+                return true;
+            }, weight);
+        }
+
+        /**
+         * Let the other jobs run first. A job calls this when it can make no
+         * progress yet, and returns false to be run again later.
+         */
+        void wait() { _waiting = true; }
+
+        /** Drop every remaining job. */
+        void clear();
+
+        /** Set the time the queue may take each frame, in milliseconds. */
+        void setBudget(float budget) { _budget = budget; }
+
+        /** Whether every job is finished. */
+        bool isDone() const { return _jobs.empty(); }
+
+        /**
+         * Get the progress of the jobs added since the queue was last empty,
+         * from 0 to 1. This is 1 if there is nothing to do.
+         */
+        float progress() const { return _total > 0 ? _done / _total : 1; }
+    };
+}
+
+#endif //PANICPAINTER_PPJOBQUEUE_H
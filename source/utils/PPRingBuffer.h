@@ -0,0 +1,67 @@
+#ifndef PANICPAINTER_PPRINGBUFFER_H
+#define PANICPAINTER_PPRINGBUFFER_H
+
+#include <array>
+#include "PPHeader.h"
+
+namespace utils {
+    /**
+     * Ring buffer is a first in, first out queue with a fixed capacity. All
+     * of its storage is part of the buffer itself, so pushing and popping
+     * never allocate.
+     * @author Dragonglass Studios
+     */
+    template<typename T, size_t N>
+    class RingBuffer {
+    private:
+        array<T, N> _items;
+
+        /** Index of the oldest item. */
+        size_t _head;
+
+        /** Number of items. */
+        size_t _size;
+
+    public:
+        RingBuffer() : _head(0), _size(0) {}
+
+        /**
+         * Add an item to the back. If the buffer is full, the oldest item is
+         * dropped to make room.
+         * @return Whether there was room without dropping anything.
+         */
+        bool push(const T &item) {
+            bool room = _size < N;
+            if (!room) {
+                _head = (_head + 1) % N;
+                _size--;
+            }
+            _items[(_head + _size) % N] = item;
+            _size++;
+            return room;
+        }
+
+        /**
+         * Take the oldest item out.
+         * @return Whether there was an item to take.
+         */
+        bool pop(T &item) {
+            if (_size == 0) return false;
+            item = _items[_head];
+            _head = (_head + 1) % N;
+            _size--;
+            return true;
+        }
+
+        /** Remove all items. */
+        void clear() { _head = _size = 0; }
+
+        size_t size() const { return _size; }
+
+        bool empty() const { return _size == 0; }
+
+        static constexpr size_t capacity() { return N; }
+    };
+}
+
+#endif //PANICPAINTER_PPRINGBUFFER_H
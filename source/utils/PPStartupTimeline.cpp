@@ -0,0 +1,46 @@
+#include "PPStartupTimeline.h"
+
+#define STARTUP_LOG_PATH \
+    (Application::get()->getSaveDirectory() + "startup.log")
+
+Timestamp StartupTimeline::_start;
+vec<pair<string, Uint64>> StartupTimeline::_stages;
+
+void StartupTimeline::start() {
+    _start.mark();
+    _stages.clear();
+}
+
+void StartupTimeline::mark(const string &stage) {
+    Uint64 ms = Timestamp::ellapsedMillis(_start, Timestamp());
+    _stages.emplace_back(stage, ms);
+    CULog("Startup: %s at %llu ms.", stage.c_str(), (unsigned long long) ms);
+}
+
+string StartupTimeline::deviceClass() {
+    int cores = SDL_GetCPUCount();
+    int ram = SDL_GetSystemRAM();
+    Size display = Application::get()->getDisplaySize();
+    // Rough buckets, so launches on similar devices can be grouped.
+    string tier = ram < 2048 || cores <= 2 ? "low" :
+                  ram < 4096 || cores <= 4 ? "mid" : "high";
+    return tier + " " + SDL_GetPlatform() + " " + to_string(cores) +
+           " cores " + to_string(ram) + " MB " +
+           to_string((int) display.width) + "x" +
+           to_string((int) display.height);
+}
+
+void StartupTimeline::report() {
+    string device = deviceClass();
+    string line = "{\"device\": \"" + device + "\"";
+    for (auto &stage : _stages) {
+        line += ", \"" + stage.first + "\": " + to_string(stage.second);
+    }
+    line += "}\n";
+    CULog("Startup timeline: %s", line.c_str());
+
+    SDL_RWops *out = SDL_RWFromFile(STARTUP_LOG_PATH.c_str(), "a");
+    if (out == nullptr) return;
+    SDL_RWwrite(out, line.data(), 1, line.size());
+    SDL_RWclose(out);
+}
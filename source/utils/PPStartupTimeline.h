@@ -0,0 +1,40 @@
+#ifndef PANICPAINTER_PPSTARTUPTIMELINE_H
+#define PANICPAINTER_PPSTARTUPTIMELINE_H
+
+#include "PPHeader.h"
+
+namespace utils {
+    /**
+     * Startup timeline records when each stage of startup is reached, so
+     * the time to interactive can be compared across devices. report() logs
+     * the stages along with the class of the device, and appends them to
+     * startup.log in the save directory as one line of JSON per launch.
+     * @author Dragonglass Studios
+     */
+    class StartupTimeline {
+    private:
+        /** When the timeline started. */
+        static Timestamp _start;
+
+        /** Each stage and the milliseconds from the start to it. */
+        static vec<pair<string, Uint64>> _stages;
+
+    public:
+        /** Start the timeline. Call this first thing on startup. */
+        static void start();
+
+        /** Record that a stage has been reached. */
+        static void mark(const string &stage);
+
+        /**
+         * Get the class of this device: low, mid or high, followed by the
+         * platform, the number of cores, the memory and the display size.
+         */
+        static string deviceClass();
+
+        /** Log the timeline and append it to the startup log. */
+        static void report();
+    };
+}
+
+#endif //PANICPAINTER_PPSTARTUPTIMELINE_H
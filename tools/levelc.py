@@ -0,0 +1,88 @@
+#!/usr/bin/env python3
+"""
+Compiles v1 JSON levels into v2 binary levels (see models/PPLevel.h).
+
+Each level is written next to its source with the extension .ppl. The
+output is the same as Level::compile, so levels can be rebuilt on any
+machine with Python.
+
+    python3 tools/levelc.py assets/levels/*.json
+
+@author Dragonglass Studios
+"""
+import json
+import os
+import struct
+import sys
+
+MAGIC = b"PPLV"
+VERSION = 2
+OBSTACLE_MARKER = 10
+HEALTH_POTION_MARKER = 12
+MAX_CANVAS_COLORS = 8
+NORMAL, OBSTACLE, HEALTH_POTION = 0, 1, 2
+
+
+def compile_canvas(raw, num_colors):
+    """Pack one canvas the way Level::_parseQueues does."""
+    kind = NORMAL
+    if raw and raw[-1] == OBSTACLE_MARKER:
+        kind, raw = OBSTACLE, raw[:-1]
+    elif raw and raw[-1] == HEALTH_POTION_MARKER:
+        kind, raw = HEALTH_POTION, raw[:-1]
+    if len(raw) > MAX_CANVAS_COLORS:
+        raise ValueError("too many colors in canvas %s" % raw)
+    colors = 0
+    for i, index in enumerate(raw):
+        if not 0 <= index < num_colors:
+            raise ValueError("color index %d out of range" % index)
+        colors |= index << (4 * i)
+    return struct.pack("<IBBH", colors, len(raw), kind, 0)
+
+
+def compile_level(source):
+    with open(source) as file:
+        level = json.load(file)
+    if level.get("version") != 1:
+        raise ValueError("not a v1 level")
+
+    colors = level["colors"]
+    queues = level["queues"]
+    timer = level.get("timer", {})
+    tutorials = level.get("tutorialTextures", [])
+    strings = b"".join(s.encode() + b"\0"
+                       for s in [level.get("background", "")] + tutorials)
+
+    starts = [0]
+    canvases = b""
+    for queue in queues:
+        for canvas in queue:
+            canvases += compile_canvas(canvas, len(colors))
+        starts.append(starts[-1] + len(queue))
+
+    out = MAGIC + struct.pack(
+        "<IIIIffffII", VERSION, len(colors), len(queues), starts[-1],
+        timer.get("levelTime", -1), timer.get("canvasBaseTime", -1),
+        timer.get("canvasPerColorTime", -1), level.get("scoreThreshold", -1),
+        len(tutorials), len(strings))
+    for rgb in colors:
+        out += struct.pack("<BBBB", int(rgb[0]), int(rgb[1]), int(rgb[2]), 255)
+    out += struct.pack("<%dI" % len(starts), *starts)
+    out += canvases + strings
+    return out
+
+
+def main(sources):
+    for source in sources:
+        try:
+            data = compile_level(source)
+        except (ValueError, KeyError) as error:
+            sys.exit("Invalid level %s: %s" % (source, error))
+        with open(os.path.splitext(source)[0] + ".ppl", "wb") as file:
+            file.write(data)
+
+
+if __name__ == "__main__":
+    if len(sys.argv) < 2:
+        sys.exit("usage: levelc.py <level.json>...")
+    main(sys.argv[1:])
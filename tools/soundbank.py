@@ -0,0 +1,64 @@
+#!/usr/bin/env python3
+"""
+Packs sound effects into a CUGL sound bank (see cugl/audio/CUSoundBank.h).
+
+Each clip is named after its file, without the extension. The output is the
+same as SoundBank::compile, so the bank can be rebuilt on any machine with
+Python. Decoding needs the soundfile package (pip install soundfile).
+
+    python3 tools/soundbank.py assets/sfx/sfx.bank assets/sfx/*.ogg
+
+@author Dragonglass Studios
+"""
+import os
+import struct
+import sys
+
+import soundfile
+
+MAGIC = b"CUSB"
+VERSION = 1
+HEADER = 8
+NAME_SIZE = 32
+ENTRY_SIZE = 48
+PCM16 = 0
+
+
+def pcm16(value):
+    """Convert a float sample to 16 bits, truncating like the C++ packer."""
+    return int(max(-1.0, min(value, 1.0)) * 32767.0)
+
+
+def main(dest, sources):
+    clips = []
+    for source in sorted(sources):
+        name = os.path.splitext(os.path.basename(source))[0]
+        if len(name.encode()) >= NAME_SIZE:
+            sys.exit("Clip name '%s' is too long" % name)
+        frames, rate = soundfile.read(source, dtype="float32", always_2d=True)
+        data = b"".join(struct.pack("<%dh" % len(frame),
+                                    *(pcm16(v) for v in frame))
+                        for frame in frames)
+        data += b"\0" * (-len(data) % 4)
+        clips.append((name, frames.shape[1], rate, frames.shape[0], data))
+
+    if len(clips) > 0xFFFF:
+        sys.exit("Too many clips for a single bank")
+
+    out = bytearray(MAGIC + struct.pack("<HH", VERSION, len(clips)))
+    offset = HEADER + len(clips) * ENTRY_SIZE
+    for name, channels, rate, length, data in clips:
+        out += name.encode().ljust(NAME_SIZE, b"\0")
+        out += struct.pack("<BBHIII", channels, PCM16, 0, rate, length, offset)
+        offset += len(data)
+    for clip in clips:
+        out += clip[4]
+
+    with open(dest, "wb") as file:
+        file.write(out)
+
+
+if __name__ == "__main__":
+    if len(sys.argv) < 3:
+        sys.exit("usage: soundbank.py <bank> <sound>...")
+    main(sys.argv[1], sys.argv[2:])